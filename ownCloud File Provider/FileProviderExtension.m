@@ -28,8 +28,10 @@
 #import "OCBookmark+FPServices.h"
 #import "OCCore+BundleImport.h"
 #import "OCFileProviderSettings.h"
+#import "OCFileProviderProvisioningPolicy.h"
 #import "VFSManager.h"
 #import "AppLockSettings.h"
+#import "AppLockState.h"
 // END: shared with ownCloudApp.framework
 
 #import "FileProviderExtension.h"
@@ -38,6 +40,7 @@
 #import "NSError+MessageResolution.h"
 #import "FileProviderServiceSource.h"
 #import "FileProviderContentEnumerator.h"
+#import "FileProviderWorkingSetEnumerator.h"
 
 @interface FileProviderExtension ()
 {
@@ -357,7 +360,28 @@
 				return;
 			}
 
-			FPLogCmdBegin(@"StartProviding", @"Downloading %@", item);
+			// Provide current local copies and local copies with modifications directly, download only if needed
+			OCFileProviderProvisioningReason reason;
+			OCFileProviderProvisioningDecision decision = [OCFileProviderProvisioningPolicy.sharedPolicy decisionForItem:ocItem source:self.core reason:&reason];
+
+			if (decision != OCFileProviderProvisioningDecisionDownload)
+			{
+				if (decision == OCFileProviderProvisioningDecisionProvideConflictingModifications)
+				{
+					FPLogCmd(@"Providing locally modified %@ despite newer remote version - conflict to be resolved on upload", item);
+				}
+
+				FPLogCmd(@"Providing local copy of %@ (decision=%ld, reason=%ld)", item, (long)decision, (long)reason);
+
+				[self.core addClaim:[OCClaim claimForLifetimeOfCore:self.core explicitIdentifier:OCClaimExplicitIdentifierFileProvider withLockType:OCClaimLockTypeRead] onItem:ocItem refreshItem:NO completionHandler:^(NSError * _Nullable error, OCItem * _Nullable item) {
+					FPLogCmd(@"Completed with local copy, claim error=%@", error);
+					completionHandler(nil);
+				}];
+
+				return;
+			}
+
+			FPLogCmdBegin(@"StartProviding", @"Downloading %@ (reason=%ld)", item, (long)reason);
 
 			[self.core downloadItem:ocItem options:@{
 
@@ -384,34 +408,6 @@
 	FPLogCmd(@"Completed with featureUnsupportedError");
 
 	completionHandler([NSError errorWithDomain:NSCocoaErrorDomain code:NSFeatureUnsupportedError userInfo:@{}]);
-
-	// ### Apple template comments: ###
-
-	// Should ensure that the actual file is in the position returned by URLForItemWithIdentifier:, then call the completion handler
-
-	/* TODO:
-	 This is one of the main entry points of the file provider. We need to check whether the file already exists on disk,
-	 whether we know of a more recent version of the file, and implement a policy for these cases. Pseudocode:
-
-	 if (!fileOnDisk) {
-	 downloadRemoteFile();
-	 callCompletion(downloadErrorOrNil);
-	 } else if (fileIsCurrent) {
-	 callCompletion(nil);
-	 } else {
-	 if (localFileHasChanges) {
-	 // in this case, a version of the file is on disk, but we know of a more recent version
-	 // we need to implement a strategy to resolve this conflict
-	 moveLocalFileAside();
-	 scheduleUploadOfLocalFile();
-	 downloadRemoteFile();
-	 callCompletion(downloadErrorOrNil);
-	 } else {
-	 downloadRemoteFile();
-	 callCompletion(downloadErrorOrNil);
-	 }
-	 }
-	 */
 }
 
 
@@ -973,33 +969,15 @@
 
 	if (AppLockSettings.sharedAppLockSettings.lockEnabled)
 	{
-		NSData *lockedDateData = [[[OCAppIdentity sharedAppIdentity] keychain] readDataFromKeychainItemForAccount:@"app.passcode" path:@"lockedDate"];
-		NSData *unlockData = [[[OCAppIdentity sharedAppIdentity] keychain] readDataFromKeychainItemForAccount:@"app.passcode" path:@"unlocked"];
-
-		if ((lockedDateData != nil) && (unlockData != nil))
+		// Use in-memory snapshot of the AppLock state (invalidated by AppLockManager when it changes the keychain)
+		if ([AppLockState.sharedAppLockState isLockedWithLockDelay:AppLockSettings.sharedAppLockSettings.lockDelay])
 		{
-			NSInteger lockDelay = AppLockSettings.sharedAppLockSettings.lockDelay;
-			NSDate *lockDate = [NSKeyedUnarchiver unarchivedObjectOfClass:NSDate.class fromData:lockedDateData error:NULL];
-			BOOL unlocked = [[NSKeyedUnarchiver unarchivedObjectOfClass:NSNumber.class fromData:unlockData error:NULL] boolValue];
-
-			if ( !unlocked || (unlocked && [[lockDate dateByAddingTimeInterval:lockDelay] compare:[NSDate date]] == NSOrderedAscending))
-			{
-				if (error != NULL)
-				{
-					*error = [NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorNotAuthenticated userInfo:nil];
-				}
-
-				OCLogDebug(@"##### Enumerator request for %@: unauthenticated return(1): %@", containerItemIdentifier, ((error != NULL) ? *error : nil));
-
-				return (nil);
-			}
-		} else if ((unlockData != nil) && ![[NSKeyedUnarchiver unarchivedObjectOfClass:NSNumber.class fromData:unlockData error:NULL] boolValue]) {
 			if (error != NULL)
 			{
 				*error = [NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorNotAuthenticated userInfo:nil];
 			}
 
-			OCLogDebug(@"##### Enumerator request for %@: unauthenticated return(2): %@", containerItemIdentifier, ((error != NULL) ? *error : nil));
+			OCLogDebug(@"##### Enumerator request for %@: unauthenticated return: %@", containerItemIdentifier, ((error != NULL) ? *error : nil));
 
 			return (nil);
 		}
@@ -1047,6 +1025,26 @@
 
 		enumerator = [[FileProviderContentEnumerator alloc] initWithVFSCore:self.vfsCore containerItemIdentifier:containerItemIdentifier];
 	}
+	else
+	{
+		// Serve the working set (favorites, tagged, available offline, local copies and recently used items) from the database
+		OCCore *core = nil;
+		NSError *coreError = nil;
+
+		if ((core = [self coreWithError:&coreError]) == nil)
+		{
+			if (error != NULL)
+			{
+				*error = coreError;
+			}
+
+			OCLogDebug(@"##### Enumerator request for %@: missing core: %@", containerItemIdentifier, ((error != NULL) ? *error : nil));
+
+			return (nil);
+		}
+
+		enumerator = [[FileProviderWorkingSetEnumerator alloc] initWithCore:core];
+	}
 
 	OCLogDebug(@"##### Enumerator request for %@: returned %@/%@", containerItemIdentifier, enumerator, ((error != NULL) ? *error : nil));
 
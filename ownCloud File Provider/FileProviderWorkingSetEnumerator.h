@@ -0,0 +1,39 @@
+//
+//  FileProviderWorkingSetEnumerator.h
+//  ownCloud File Provider
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <FileProvider/FileProvider.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+// BEGIN: Shared with ownCloudApp.framework
+#import "OCFileProviderWorkingSet.h"
+// END: shared with ownCloudApp.framework
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Enumerator for NSFileProviderWorkingSetContainerItemIdentifier. Serves favorite, tagged, available offline, locally stored and recently used items from the core's database in pages, and changes to them based on the database's sync anchor.
+@interface FileProviderWorkingSetEnumerator : NSObject <NSFileProviderEnumerator, OCLogTagging>
+
+@property(weak,nullable) OCCore *core;
+@property(strong,readonly) OCFileProviderWorkingSet *workingSet;
+
+- (instancetype)initWithCore:(OCCore *)core;
+
+@end
+
+NS_ASSUME_NONNULL_END
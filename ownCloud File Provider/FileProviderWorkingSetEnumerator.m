@@ -0,0 +1,245 @@
+//
+//  FileProviderWorkingSetEnumerator.m
+//  ownCloud File Provider
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "FileProviderWorkingSetEnumerator.h"
+#import "FileProviderContentEnumerator.h"
+#import "OCItem+FileProviderItem.h"
+#import "NSNumber+OCSyncAnchorData.h"
+
+@implementation FileProviderWorkingSetEnumerator
+
+- (instancetype)initWithCore:(OCCore *)core
+{
+	if ((self = [super init]) != nil)
+	{
+		_core = core;
+		_workingSet = [OCFileProviderWorkingSet new];
+	}
+
+	return (self);
+}
+
+#pragma mark - Helpers
+- (void)_performOnQueue:(void(^)(dispatch_block_t completionHandler))block
+{
+	// Use the same queue as the content enumerators, so working set enumeration doesn't compete with folder enumerations
+	[FileProviderContentEnumerator.queue async:block];
+}
+
+- (void)_tagItems:(NSArray<OCItem *> *)items withCore:(OCCore *)core
+{
+	OCBookmarkUUIDString bookmarkUUIDString = core.bookmark.uuidString;
+
+	for (OCItem *item in items)
+	{
+		item.bookmarkUUID = bookmarkUUIDString;
+	}
+}
+
+- (void)_makeSnapshotWithCore:(OCCore *)core completionHandler:(void(^)(NSError * _Nullable error))completionHandler
+{
+	// Only retrieve candidates for the working set from the database - not all items - to stay within the extension's memory limit
+	[self.workingSet makeSnapshotFromDatabase:core.vault.database fallbackSyncAnchor:core.latestSyncAnchor completionHandler:completionHandler];
+}
+
+- (void)_reportUpdatedItems:(NSArray<OCItem *> *)updatedItems deletedItems:(NSArray<OCItem *> *)deletedItems toObserver:(id<NSFileProviderChangeObserver>)observer withCore:(OCCore *)core
+{
+	NSUInteger batchSize = _workingSet.maximumPageSize;
+	NSMutableArray<NSFileProviderItemIdentifier> *deletedItemIdentifiers = [NSMutableArray new];
+
+	[self _tagItems:updatedItems withCore:core];
+	[self _tagItems:deletedItems withCore:core];
+
+	// Report deletions with the same identifiers (vfsItemID) used for all other items
+	for (OCItem *item in deletedItems)
+	{
+		NSFileProviderItemIdentifier itemIdentifier;
+
+		if ((itemIdentifier = item.itemIdentifier) != nil)
+		{
+			[deletedItemIdentifiers addObject:itemIdentifier];
+		}
+	}
+
+	// Report changes in batches
+	for (NSUInteger offset=0; offset < deletedItemIdentifiers.count; offset += batchSize)
+	{
+		[observer didDeleteItemsWithIdentifiers:[deletedItemIdentifiers subarrayWithRange:NSMakeRange(offset, MIN(batchSize, deletedItemIdentifiers.count - offset))]];
+	}
+
+	for (NSUInteger offset=0; offset < updatedItems.count; offset += batchSize)
+	{
+		[observer didUpdateItems:[updatedItems subarrayWithRange:NSMakeRange(offset, MIN(batchSize, updatedItems.count - offset))]];
+	}
+}
+
+#pragma mark - Items
+- (void)enumerateItemsForObserver:(id<NSFileProviderEnumerationObserver>)observer startingAtPage:(NSFileProviderPage)page
+{
+	OCLogDebug(@"##### Enumerate WORKING SET for observer: %@ fromPage: %@", observer, page);
+
+	__weak FileProviderWorkingSetEnumerator *weakSelf = self;
+
+	[self _performOnQueue:^(dispatch_block_t completionHandler) {
+		FileProviderWorkingSetEnumerator *strongSelf = weakSelf;
+		OCCore *core = strongSelf.core;
+
+		if ((strongSelf == nil) || (core == nil))
+		{
+			[observer finishEnumeratingWithError:[NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorServerUnreachable userInfo:nil]];
+			completionHandler();
+			return;
+		}
+
+		dispatch_block_t servePage = ^{
+			NSFileProviderPage nextPage = nil;
+			NSArray<OCItem *> *items = [strongSelf.workingSet itemsForPage:page nextPage:&nextPage];
+
+			if (items == nil)
+			{
+				// Page belongs to an outdated snapshot
+				[observer finishEnumeratingWithError:[NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorPageExpired userInfo:nil]];
+			}
+			else
+			{
+				[strongSelf _tagItems:items withCore:core];
+
+				if (items.count > 0)
+				{
+					[observer didEnumerateItems:items];
+				}
+
+				[observer finishEnumeratingUpToPage:nextPage];
+			}
+
+			completionHandler();
+		};
+
+		// Build a new snapshot for initial pages (or if there is none yet), serve follow-up pages from the existing one
+		BOOL isInitialPage = (page == nil) || [page isEqual:NSFileProviderInitialPageSortedByDate] || [page isEqual:NSFileProviderInitialPageSortedByName];
+
+		if (!isInitialPage && (strongSelf.workingSet.snapshotSyncAnchor != nil))
+		{
+			servePage();
+		}
+		else
+		{
+			[strongSelf _makeSnapshotWithCore:core completionHandler:^(NSError * _Nullable error) {
+				if (error != nil)
+				{
+					[observer finishEnumeratingWithError:error];
+					completionHandler();
+					return;
+				}
+
+				servePage();
+			}];
+		}
+	}];
+}
+
+#pragma mark - Changes
+- (void)enumerateChangesForObserver:(id<NSFileProviderChangeObserver>)observer fromSyncAnchor:(NSFileProviderSyncAnchor)syncAnchor
+{
+	OCLogDebug(@"##### Enumerate WORKING SET CHANGES for observer: %@ fromSyncAnchor: %@", observer, syncAnchor);
+
+	__weak FileProviderWorkingSetEnumerator *weakSelf = self;
+
+	[self _performOnQueue:^(dispatch_block_t completionHandler) {
+		FileProviderWorkingSetEnumerator *strongSelf = weakSelf;
+		OCCore *core = strongSelf.core;
+		NSNumber *fromSyncAnchor = [NSNumber numberFromSyncAnchorData:syncAnchor];
+		OCSyncAnchor latestSyncAnchor = core.latestSyncAnchor;
+
+		if ((strongSelf == nil) || (core == nil))
+		{
+			[observer finishEnumeratingWithError:[NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorServerUnreachable userInfo:nil]];
+			completionHandler();
+			return;
+		}
+
+		if ((fromSyncAnchor == nil) || ((latestSyncAnchor != nil) && ([fromSyncAnchor compare:latestSyncAnchor] == NSOrderedDescending)))
+		{
+			// Unknown anchor or database was reset => system needs to start over
+			[observer finishEnumeratingWithError:[NSError errorWithDomain:NSFileProviderErrorDomain code:NSFileProviderErrorSyncAnchorExpired userInfo:nil]];
+			completionHandler();
+			return;
+		}
+
+		if ([fromSyncAnchor isEqual:latestSyncAnchor])
+		{
+			// No changes in the database - but members may have left the working set without changing (f.ex. no longer recently used)
+			NSArray<OCItem *> *updatedItems = nil, *deletedItems = nil;
+
+			[strongSelf.workingSet classifyChangedItems:@[] updatedItems:&updatedItems deletedItems:&deletedItems];
+			[strongSelf _reportUpdatedItems:updatedItems deletedItems:deletedItems toObserver:observer withCore:core];
+
+			[observer finishEnumeratingChangesUpToSyncAnchor:syncAnchor moreComing:NO];
+			completionHandler();
+			return;
+		}
+
+		[strongSelf.workingSet retrieveChangesFromDatabase:core.vault.database sinceSyncAnchor:fromSyncAnchor completionHandler:^(NSError * _Nullable error, OCSyncAnchor _Nullable newSyncAnchor, NSArray<OCItem *> * _Nullable updatedItems, NSArray<OCItem *> * _Nullable deletedItems) {
+			if (error != nil)
+			{
+				[observer finishEnumeratingWithError:error];
+				completionHandler();
+				return;
+			}
+
+			[strongSelf _reportUpdatedItems:updatedItems deletedItems:deletedItems toObserver:observer withCore:core];
+
+			[observer finishEnumeratingChangesUpToSyncAnchor:[((newSyncAnchor != nil) ? newSyncAnchor : latestSyncAnchor) syncAnchorData] moreComing:NO];
+
+			if (strongSelf.workingSet.snapshotSyncAnchor == nil)
+			{
+				// Establish the membership that later changes are compared against, so items leaving the working set without changing can be reported
+				[strongSelf _makeSnapshotWithCore:core completionHandler:^(NSError * _Nullable error) {
+					completionHandler();
+				}];
+			}
+			else
+			{
+				completionHandler();
+			}
+		}];
+	}];
+}
+
+- (void)currentSyncAnchorWithCompletionHandler:(void (^)(NSFileProviderSyncAnchor _Nullable))completionHandler
+{
+	completionHandler([self.core.latestSyncAnchor syncAnchorData]);
+}
+
+- (void)invalidate
+{
+	OCLogDebug(@"##### INVALIDATE WORKING SET");
+}
+
+#pragma mark - Log tags
++ (NSArray<OCLogTagName> *)logTags
+{
+	return (@[ @"FPEnum", @"WorkingSet" ]);
+}
+
+- (NSArray<OCLogTagName> *)logTags
+{
+	return (@[ @"FPEnum", @"WorkingSet", OCLogTagInstance(self)]);
+}
+
+@end
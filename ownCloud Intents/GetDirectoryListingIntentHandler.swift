@@ -28,15 +28,22 @@ typealias GetDirectoryListingCompletionHandler = (GetDirectoryListingIntentRespo
 public class GetDirectoryListingIntentHandler: NSObject, GetDirectoryListingIntentHandling, OCQueryDelegate, OCCoreDelegate {
 	weak var core : OCCore?
 	var completionHandler : GetDirectoryListingCompletionHandler?
+	var directoryQuery : OCQuery?
+	var listingCacheKey : (bookmark: OCBookmark, path: String, sortType: Int, sortDirection: Int)?
 
 	func complete(with response: GetDirectoryListingIntentResponse) {
 		if let completionHandler = completionHandler {
 			self.completionHandler = nil
 
+			if let query = directoryQuery {
+				directoryQuery = nil
+				core?.stop(query)
+			}
+
 			if let bookmark = core?.bookmark {
 				core = nil
 
-				OCCoreManager.shared.returnCore(for: bookmark, completionHandler: {
+				IntentCoreLease.shared.release(for: bookmark, delegate: self, completionHandler: {
 					completionHandler(response)
 				})
 			} else {
@@ -107,24 +114,39 @@ public class GetDirectoryListingIntentHandler: NSObject, GetDirectoryListingInte
 
 		completionHandler = completion
 
-		OCCoreManager.shared.requestCore(for: bookmark, setup: { (core, error) in
-			core?.delegate = self
-		}, completionHandler: { (core, error) in
+		let sortType = intent.sortType.rawValue
+		let sortDirection = intent.sortDirection.rawValue
+
+		listingCacheKey = (bookmark: bookmark, path: path, sortType: sortType, sortDirection: sortDirection)
+
+		// The core may be shared with other intents, so errors are received via the lease rather than by becoming the core's delegate
+		IntentCoreLease.shared.acquire(for: bookmark, delegate: self, completionHandler: { (core, error) in
+			guard let core = core, error == nil else {
+				self.complete(with: GetDirectoryListingIntentResponse(code: .failure, userActivity: nil))
+				return
+			}
+
 			self.core = core
 
-			if error == nil {
-				let targetDirectoryQuery = OCQuery(for: OCLocation.legacyRootPath(path))
-				targetDirectoryQuery.delegate = self
+			let location = OCLocation.legacyRootPath(path)
 
-				if targetDirectoryQuery.sortComparator == nil {
-					let sort = SortMethod(rawValue: (intent.sortType.rawValue - 1)) ?? SortMethod.alphabetically
+			// Serve recently retrieved listings from the listing cache (see IntentDirectoryListingCache on staleness)
+			if let cachedListing = IntentDirectoryListingCache.shared.listing(for: bookmark, path: path, sortType: sortType, sortDirection: sortDirection, eTag: (try? core.cachedItem(at: location))?.eTag) {
+				self.complete(with: GetDirectoryListingIntentResponse.success(directoryListing: cachedListing))
+				return
+			}
 
-					targetDirectoryQuery.sortComparator = sort.comparator(direction: SortDirection(rawValue: (intent.sortDirection.rawValue - 1)) ?? SortDirection.ascending)
-				}
-				core?.start(targetDirectoryQuery)
-			} else {
-				self.complete(with: GetDirectoryListingIntentResponse(code: .failure, userActivity: nil))
+			let targetDirectoryQuery = OCQuery(for: location)
+			targetDirectoryQuery.delegate = self
+
+			if targetDirectoryQuery.sortComparator == nil {
+				let sort = SortMethod(rawValue: (sortType - 1)) ?? SortMethod.alphabetically
+
+				targetDirectoryQuery.sortComparator = sort.comparator(direction: SortDirection(rawValue: (sortDirection - 1)) ?? SortDirection.ascending)
 			}
+
+			self.directoryQuery = targetDirectoryQuery
+			core.start(targetDirectoryQuery)
 		})
 	}
 
@@ -137,6 +159,10 @@ public class GetDirectoryListingIntentHandler: NSObject, GetDirectoryListingInte
 				directoryListing = results.compactMap { return $0.path }
 			}
 
+			if let cacheKey = listingCacheKey {
+				IntentDirectoryListingCache.shared.store(listing: directoryListing, for: cacheKey.bookmark, path: cacheKey.path, sortType: cacheKey.sortType, sortDirection: cacheKey.sortDirection, eTag: query.rootItem?.eTag)
+			}
+
 			self.complete(with: GetDirectoryListingIntentResponse.success(directoryListing: directoryListing))
 		}
 	}
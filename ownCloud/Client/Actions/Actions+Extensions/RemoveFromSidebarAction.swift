@@ -67,13 +67,15 @@ class RemoveFromSidebarAction: Action {
 			return
 		}
 
-		for item in context.items {
-			if let location = item.location {
-				location.bookmarkUUID = context.core?.bookmark.uuid
-				for sidebarItem in sidebarItems {
-					if sidebarItem.location == location {
-						core.vault.delete(sidebarItem)
-						break
+		core.vault.performSidebarItemBatchUpdates { store in
+			for item in context.items {
+				if let location = item.location {
+					location.bookmarkUUID = context.core?.bookmark.uuid
+					for sidebarItem in sidebarItems {
+						if sidebarItem.location == location {
+							store.removeEntry(sidebarItem)
+							break
+						}
 					}
 				}
 			}
@@ -45,7 +45,21 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 	weak var messageSelector : MessageSelector?
 	var messageGroups : [MessageGroup]?
 
-	var activities : [OCActivity]?
+	lazy var activityList : ActivityListModel<OCActivity> = ActivityListModel(identifier: { (activity) in
+		return activity.identifier
+	}, elements: { [weak self] in
+		return self?.core?.activityManager.activities ?? []
+	})
+
+	var activities : [OCActivity] {
+		return activityList.elements
+	}
+
+	// Activity changes are collected and applied once per display frame
+	lazy var activityUpdateCoalescer : DisplayFrameCoalescer = DisplayFrameCoalescer(handler: { [weak self] in
+		self?.applyActivityChanges()
+	})
+
 	var isOnScreen : Bool = false {
 		didSet {
 			updateDisplaySleep()
@@ -115,6 +129,7 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 
 	private func winddown() {
 		Theme.shared.unregister(client: self)
+		activityUpdateCoalescer.cancel()
 		self.shouldPauseDisplaySleep = false
 		self.connection = nil
 		self.core = nil
@@ -137,27 +152,45 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 				if let updateTypeInt = activityUpdate[OCActivityManagerUpdateTypeKey] as? UInt, let updateType = OCActivityUpdateType(rawValue: updateTypeInt) {
 					switch updateType {
 						case .publish, .unpublish:
-							setNeedsDataReload()
-
-							if core?.activityManager.activities.count == 0 {
-								shouldPauseDisplaySleep = false
-							} else {
-								shouldPauseDisplaySleep = true
-							}
+							activityList.setNeedsElementsUpdate()
 
 						case .property:
-							if isOnScreen,
-							   let activity = activityUpdate[OCActivityManagerUpdateActivityKey] as? OCActivity,
-							   let firstIndex = activities?.firstIndex(of: activity) {
-							   	// Update just the updated activity
-								self.tableView.reloadRows(at: [IndexPath(row: firstIndex, section: ActivitySection.activities.rawValue)], with: .none)
-							} else {
-								// Schedule table reload if not on-screen
-								setNeedsDataReload()
+							if let activity = activityUpdate[OCActivityManagerUpdateActivityKey] as? OCActivity {
+								activityList.elementUpdated(identifier: activity.identifier)
 							}
 					}
 				}
 			}
+
+			if isOnScreen {
+				activityUpdateCoalescer.setNeedsUpdate()
+			} else {
+				// Schedule table reload if not on-screen
+				needsDataReload = true
+			}
+		}
+	}
+
+	func applyActivityChanges() {
+		guard isOnScreen, activityList.hasPendingChanges else { return }
+
+		if needsDataReload {
+			reloadDataIfOnScreen()
+			return
+		}
+
+		tableView.apply(activityList.applyPendingChanges(), in: ActivitySection.activities.rawValue)
+
+		updateStatusDisplay()
+	}
+
+	func updateStatusDisplay() {
+		shouldPauseDisplaySleep = activities.count > 0
+
+		if activities.count == 0, (messageGroups?.count ?? 0) == 0 {
+			self.messageView?.message(show: true, imageName: "status-flash", title: OCLocalizedString("All done", nil), message: OCLocalizedString("No pending messages or ongoing actions.", nil))
+		} else {
+			self.messageView?.message(show: false)
 		}
 	}
 
@@ -184,16 +217,12 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 		if needsDataReload, isOnScreen {
 			needsDataReload = false
 
-			activities = core?.activityManager.activities
+			activityList.reload()
 			messageGroups = messageSelector?.groupedSelection
 
 			self.tableView.reloadData()
 
-			if (activities?.count ?? 0) == 0, (messageGroups?.count ?? 0) == 0 {
-				self.messageView?.message(show: true, imageName: "status-flash", title: OCLocalizedString("All done", nil), message: OCLocalizedString("No pending messages or ongoing actions.", nil))
-			} else {
-				self.messageView?.message(show: false)
-			}
+			updateStatusDisplay()
 		}
 	}
 
@@ -278,7 +307,7 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 				return messageGroups?.count ?? 0
 
 			case .activities:
-				return activities?.count ?? 0
+				return activities.count
 
 			default:
 				return 0
@@ -307,7 +336,7 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 
 				cell.delegate = self
 
-				if let activities = activities, indexPath.row < activities.count {
+				if indexPath.row < activities.count {
 					cell.activity = activities[indexPath.row]
 				}
 
@@ -320,7 +349,7 @@ class ClientActivityViewController: UITableViewController, Themeable, MessageGro
 
 	override func tableView(_ tableView: UITableView, trailingSwipeActionsConfigurationForRowAt indexPath: IndexPath) -> UISwipeActionsConfiguration? {
 		if ActivitySection(rawValue: indexPath.section) == .activities,
-		   let activities = activities,
+		   indexPath.row < activities.count,
 		   let nodeGenerator = activities[indexPath.row] as? DiagnosticNodeGenerator, nodeGenerator.isDiagnosticNodeGenerationAvailable {
 			return UISwipeActionsConfiguration(actions: [
 				UIContextualAction(style: .normal, title: OCLocalizedString("Info", nil), handler: { [weak self] (_, _, completionHandler) in
@@ -45,6 +45,7 @@ class MediaDisplayViewController : DisplayViewController {
 	private var playerItem: AVPlayerItem?
 	private var player: AVPlayer?
 	private var playerViewController: AVPlayerViewController?
+	private var mediaResourceLoader: MediaResourceLoader? // Serves streamed media through the MediaRangeCache - retained while the asset is in use
 
 	// Information for now playing
 	private var mediaItemArtwork: MPMediaItemArtwork?
@@ -176,12 +177,33 @@ class MediaDisplayViewController : DisplayViewController {
 			playerItemStatusObservation = nil
 			player?.pause()
 
-			let asset = AVURLAsset(url: directURL, options: self.httpAuthHeaders != nil ? ["AVURLAssetHTTPHeaderFieldsKey" : self.httpAuthHeaders!] : nil )
+			let asset: AVURLAsset
+
+			if let scheme = directURL.scheme?.lowercased(), (scheme == "http") || (scheme == "https"), let item, let bookmark = core?.bookmark, let rangeCache = MediaRangeCache.cache(for: bookmark) {
+				// Stream through the account's range cache, so that replaying, seeking back and reopening is served from disk
+				let cacheKey = "\(item.fileID ?? item.path ?? directURL.absoluteString)-\(item.eTag ?? "")"
+				let rangeLoader = MediaRangeLoader(remoteURL: directURL, headers: self.httpAuthHeaders, entry: rangeCache.entry(for: cacheKey))
+
+				mediaResourceLoader = MediaResourceLoader(rangeLoader: rangeLoader)
+				asset = mediaResourceLoader!.makeAsset()
+			} else {
+				mediaResourceLoader = nil
+				asset = AVURLAsset(url: directURL, options: self.httpAuthHeaders != nil ? ["AVURLAssetHTTPHeaderFieldsKey" : self.httpAuthHeaders!] : nil )
+			}
+
 			playerItem = AVPlayerItem(asset: asset)
 
 			playerItemStatusObservation = playerItem?.observe(\AVPlayerItem.status, options: [.initial, .new], changeHandler: { [weak self] (item, _) in
 				if item.status == .failed {
-					self?.present(error: item.error)
+					OnMainThread {
+						if let self, self.mediaResourceLoader?.rangeLoader.rangeRequestsUnsupported == true {
+							// The server doesn't support range requests: download the file instead of streaming it
+							self.mediaResourceLoader = nil
+							self.downloadItem()
+						} else {
+							self?.present(error: item.error)
+						}
+					}
 				}
 			})
 
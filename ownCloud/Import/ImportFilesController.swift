@@ -39,15 +39,31 @@ class ImportFilesController: NSObject {
 	// MARK: - Instance variables
 
 	static var shared = ImportFilesController()
-	//var url: URL?
-	var localCopyContainerURL: URL?
-	var localCopyURL: URL?
-	//var fileIsLocalCopy: Bool
 	var importFiles: [ImportFile] = []
+	var stagedFiles: [URL : ImportStager.StagedFile] = [:] // Staged files by ImportFile.url
 	var isVisible: Bool = false
 
 	var fileCoordinator : NSFileCoordinator?
 
+	static var stagingRootURL: URL? {
+		return OCAppIdentity.shared.appGroupContainerURL?.appendingPathComponent("File-Import")
+	}
+
+	lazy var stager: ImportStager? = {
+		if let stagingRootURL = ImportFilesController.stagingRootURL {
+			return ImportStager(rootURL: stagingRootURL)
+		}
+		return nil
+	}()
+
+	// File coordination and staging is performed off the main thread, so that large files don't block the UI
+	lazy var stagingQueue: OperationQueue = {
+		let queue = OperationQueue()
+		queue.name = "com.owncloud.import-staging"
+		queue.qualityOfService = .userInitiated
+		return queue
+	}()
+
 	public func importAllowed(alertUserOtherwise: Bool) -> Bool {
 		let importAllowed = Branding.shared.isImportMethodAllowed(.openWith)
 
@@ -73,6 +89,7 @@ class ImportFilesController: NSObject {
 				guard error == nil else {
 					Log.error("Couldn't import file \(importFile.url.absoluteString) because of error: \(String(describing: error))")
 
+					self.importFiles.remove(object: importFile)
 					return
 				}
 
@@ -139,13 +156,14 @@ class ImportFilesController: NSObject {
 				OnMainThread {
 					for importFile in self.importFiles {
 						let name = importFile.url.lastPathComponent
+						let stagedFile = self.stagedFiles[importFile.url]
 
 						waitGroup.enter()
 						if core?.importItemNamed(name,
 									 at: targetDirectory,
-									 from: importFile.url,
+									 from: stagedFile?.url ?? importFile.url,
 									 isSecurityScoped: false,
-									 options: [OCCoreOption.importByCopying : true,
+									 options: [OCCoreOption.importByCopying : (stagedFile == nil), // Staged files are moved into place rather than copied again
 										   OCCoreOption.automaticConflictResolutionNameStyle : OCCoreDuplicateNameStyle.bracketed.rawValue],
 									 placeholderCompletionHandler: { (error, item) in
 										if error != nil {
@@ -193,66 +211,48 @@ class ImportFilesController: NSObject {
 		let uploadIntent = NSFileAccessIntent.readingIntent(with: file.url, options: .forUploading)
 
 		fileCoordinator = NSFileCoordinator(filePresenter: nil)
-		fileCoordinator?.coordinate(with: [uploadIntent], queue: OperationQueue.main, byAccessor: { (error) in
-			let readURL = uploadIntent.url
+		fileCoordinator?.coordinate(with: [uploadIntent], queue: stagingQueue, byAccessor: { (error) in
+			var stagingError = error
 
-			Log.log("Read from \(readURL)")
+			if error == nil {
+				let readURL = uploadIntent.url
 
-			self.makeLocalCopy(of: readURL, completion: { (error) in
-				if isAccessingSecurityScopedResource {
-					securityScopedURL.stopAccessingSecurityScopedResource()
-				}
-
-				completion(error)
-			})
-		})
-	}
+				Log.log("Read from \(readURL)")
 
-	func makeLocalCopy(of itemURL: URL, completion: (_ error: Error?) -> Void) {
-		if let appGroupURL = OCAppIdentity.shared.appGroupContainerURL {
-			let fileManager = FileManager.default
-
-			var inboxURL = appGroupURL.appendingPathComponent("File-Import")
-			if !fileManager.fileExists(atPath: inboxURL.path) {
+				// Staging needs to complete within the accessor, as access to the file may end when it returns
 				do {
-					try fileManager.createDirectory(at: inboxURL, withIntermediateDirectories: false, attributes: [ .protectionKey : FileProtectionType.completeUntilFirstUserAuthentication])
-				} catch let error as NSError {
-					Log.debug("Error creating directory \(inboxURL) \(error.localizedDescription)")
+					// Hard links share later modifications with the source, so only use them for local copies that are owned by the app
+					let stagedFile = try self.stageLocalCopy(of: readURL, allowHardLink: file.fileIsLocalCopy)
 
-					completion(error)
-					return
+					OnMainThread {
+						self.stagedFiles[file.url] = stagedFile
+					}
+				} catch {
+					stagingError = error
 				}
 			}
 
-			let uuid = UUID().uuidString
-			inboxURL = inboxURL.appendingPathComponent(uuid)
-			if !fileManager.fileExists(atPath: inboxURL.path) {
-				do {
-					try fileManager.createDirectory(at: inboxURL, withIntermediateDirectories: false, attributes: [ .protectionKey : FileProtectionType.completeUntilFirstUserAuthentication])
-				} catch let error as NSError {
-					Log.debug("Error creating directory \(inboxURL) \(error.localizedDescription)")
-
-					completion(error)
-					return
-				}
+			if isAccessingSecurityScopedResource {
+				securityScopedURL.stopAccessingSecurityScopedResource()
 			}
-			self.localCopyContainerURL = inboxURL
-
-			inboxURL = inboxURL.appendingPathComponent(itemURL.lastPathComponent)
-			do {
-				try fileManager.copyItem(at: itemURL, to: inboxURL)
-				//self.url = inboxURL
-				self.localCopyURL = inboxURL
-				//self.fileIsLocalCopy = true
-			} catch let error as NSError {
-				Log.debug("Error copying file \(inboxURL) \(error.localizedDescription)")
-
-				completion(error)
-				return
+
+			OnMainThread {
+				completion(stagingError)
 			}
+		})
+	}
+
+	func stageLocalCopy(of itemURL: URL, allowHardLink: Bool) throws -> ImportStager.StagedFile {
+		guard let stager else {
+			throw NSError(ocError: .internal)
 		}
 
-		completion(nil)
+		do {
+			return try stager.stage(itemURL, allowHardLink: allowHardLink)
+		} catch {
+			Log.debug("Error staging file \(itemURL) \(error.localizedDescription)")
+			throw error
+		}
 	}
 
 	func removeLocalCopy(importFile: ImportFile) {
@@ -265,32 +265,21 @@ class ImportFilesController: NSObject {
 				} catch {
 				}
 			}
+		}
 
-			if let localCopyContainerURL = localCopyContainerURL {
-				if fileManager.fileExists(atPath: importFile.url.path) {
-					do {
-						try fileManager.removeItem(at: localCopyContainerURL)
-					} catch {
-					}
-				}
-			}
+		if let stagedFile = stagedFiles[importFile.url] {
+			stager?.remove(stagedFile)
+			stagedFiles[importFile.url] = nil
 		}
+
 		importFiles.remove(object: importFile)
 	}
 
 	// MARK: - Cleanup on startup
 	class func removeImportDirectory() {
-		if let appGroupURL = OCAppIdentity.shared.appGroupContainerURL {
-			let fileManager = FileManager.default
-			let inboxUrl = URL(fileURLWithPath: appGroupURL.appendingPathComponent("File-Import").path)
-
-			if fileManager.fileExists(atPath: inboxUrl.path) {
-				do {
-					try fileManager.removeItem(at: inboxUrl)
-				} catch {
-
-				}
-			}
+		if let stagingRootURL {
+			// Remove files staged before this launch
+			ImportStager(rootURL: stagingRootURL).removeStagedFiles(createdBefore: Date())
 		}
 	}
 }
@@ -81,9 +81,13 @@ class MediaUploadQueue : OCActivitySource {
 	}
 
 	func addUploads(_ assets:[PHAsset], for bookmark:OCBookmark, at targetLocation: OCLocation) {
+		addUploads(withAssetIdentifiers: assets.map({ $0.localIdentifier }), for: bookmark, at: targetLocation)
+	}
+
+	func addUploads(withAssetIdentifiers assetIdentifiers:[String], for bookmark:OCBookmark, at targetLocation: OCLocation) {
 		bookmark.modifyMediaUploadStorage { (storage) -> MediaUploadStorage in
-			for asset in assets {
-				storage.addJob(with: asset.localIdentifier, targetLocation: targetLocation)
+			for assetIdentifier in assetIdentifiers {
+				storage.addJob(with: assetIdentifier, targetLocation: targetLocation)
 			}
 			return storage
 		}
@@ -210,3 +210,47 @@ extension OCBookmark {
 		return mediaUploadKeyValueStore?.readObject(forKey: OCBookmark.MediaUploadStorageKey) as? MediaUploadStorage
 	}
 }
+
+// MARK: - Photo library change cursors
+extension OCBookmark {
+	static let PhotoLibraryChangeCursorsKey = OCKeyValueStoreKey(rawValue: "com.owncloud.photo-library-change-cursors")
+}
+
+extension OCKeyValueStore : PhotoLibraryChangeCursorStore {
+	private func registerPhotoLibraryChangeCursorClasses() {
+		if registeredClasses(forKey: OCBookmark.PhotoLibraryChangeCursorsKey) == nil {
+			if let classSet = NSSet(array: [
+				NSDictionary.self,
+				NSString.self,
+				NSData.self
+			]) as? Set<AnyHashable> {
+				registerClasses(classSet, forKey: OCBookmark.PhotoLibraryChangeCursorsKey)
+			}
+		}
+	}
+
+	public func changeCursor(for identifier: String) -> PhotoLibraryChangeCursor? {
+		registerPhotoLibraryChangeCursorClasses()
+
+		if let cursors = readObject(forKey: OCBookmark.PhotoLibraryChangeCursorsKey) as? [String : Data], let cursorData = cursors[identifier] {
+			return try? PropertyListDecoder().decode(PhotoLibraryChangeCursor.self, from: cursorData)
+		}
+
+		return nil
+	}
+
+	public func store(changeCursor: PhotoLibraryChangeCursor?, for identifier: String) {
+		registerPhotoLibraryChangeCursorClasses()
+
+		let cursorData = (changeCursor != nil) ? try? PropertyListEncoder().encode(changeCursor) : nil
+
+		updateObject(forKey: OCBookmark.PhotoLibraryChangeCursorsKey, usingModifier: { (value, changesMadePtr) -> Any? in
+			var cursors = (value as? [String : Data]) ?? [:]
+
+			cursors[identifier] = cursorData
+			changesMadePtr.pointee = true
+
+			return cursors
+		})
+	}
+}
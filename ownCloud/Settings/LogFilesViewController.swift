@@ -65,6 +65,9 @@ class LogFilesViewController : UITableViewController, UITableViewDragDelegate, T
 
 	var logRecords = [OCLogFileRecord]()
 
+	// Uncompressed size limit for exported logs - older entries beyond it are left out
+	static let maximumExportSize: Int64 = 256 * 1024 * 1024
+
 	lazy var byteCounterFormatter: ByteCountFormatter = {
 		let fmtr = ByteCountFormatter()
 		fmtr.allowsNonnumericFormatting = true
@@ -100,10 +103,11 @@ class LogFilesViewController : UITableViewController, UITableViewDragDelegate, T
 		super.viewWillAppear(animated)
 		self.populateLogFileList()
 
+		let shareAllButtonItem = UIBarButtonItem(title: OCLocalizedString("Share all", nil), style: .plain, target: self, action: #selector(shareAllLogs(_:)))
 		let removeAllButtonItem = UIBarButtonItem(title: OCLocalizedString("Delete all", nil), style: .done, target: self, action: #selector(removeAllLogs))
 		let flexibleSpaceButtonItem = UIBarButtonItem(barButtonSystemItem: .flexibleSpace, target: nil, action: nil)
 
-		self.toolbarItems = [flexibleSpaceButtonItem, removeAllButtonItem, flexibleSpaceButtonItem]
+		self.toolbarItems = [flexibleSpaceButtonItem, shareAllButtonItem, flexibleSpaceButtonItem, removeAllButtonItem, flexibleSpaceButtonItem]
 		self.navigationController?.setToolbarHidden(false, animated: false)
 	}
 
@@ -177,31 +181,20 @@ class LogFilesViewController : UITableViewController, UITableViewDragDelegate, T
 			return [UIDragItem]()
 		}
 
-		var logURL : URL?
-		var logName : String?
-
-		provideLogURL(at: indexPath, makeNamedCopy: false) { (url, name, completionHandler) in
-			logURL = url
-			logName = name
-
-			// Since we use false for makeNamedCopy, this should be safe
-			completionHandler?()
-		}
-
-		if let logURL = logURL {
-			let itemProvider = NSItemProvider()
-			itemProvider.registerFileRepresentation(forTypeIdentifier: UTType.utf8PlainText.identifier, fileOptions: [], visibility: .all, loadHandler: { (completionHandler) -> Progress? in
-				completionHandler(logURL, true, nil)
-				return nil
-			})
-			itemProvider.suggestedName = logName
+		let logRecord = self.logRecords[indexPath.row]
+		let logURL = logRecord.url
+		let logName = shareableName(for: logRecord) + ".log.txt"
 
-			let dragItem = UIDragItem(itemProvider: itemProvider)
+		let itemProvider = NSItemProvider()
+		itemProvider.registerFileRepresentation(forTypeIdentifier: UTType.utf8PlainText.identifier, fileOptions: [], visibility: .all, loadHandler: { (completionHandler) -> Progress? in
+			completionHandler(logURL, true, nil)
+			return nil
+		})
+		itemProvider.suggestedName = logName
 
-			return [dragItem]
-		}
+		let dragItem = UIDragItem(itemProvider: itemProvider)
 
-		return [UIDragItem]()
+		return [dragItem]
 	}
 
 	// MARK: - Private Helpers
@@ -219,10 +212,8 @@ class LogFilesViewController : UITableViewController, UITableViewDragDelegate, T
 		}
 	}
 
-	private func provideLogURL(at indexPath: IndexPath, makeNamedCopy: Bool, completionHandler: (_ fileURL: URL?, _ name: String?, _ doneBlock: (() -> Void)?) -> Void) {
-		let logRecord = self.logRecords[indexPath.row]
-
-		// Create a file name for sharing with format ownCloud_<date>_<time>.log.txt
+	private func shareableName(for logRecord: OCLogFileRecord) -> String {
+		// Create a file name for sharing with format ownCloud_<date>_<time>
 		var time = ""
 		if let creationDate = logRecord.creationDate {
 			let delimiteresRegex = try? NSRegularExpression(pattern: "[/ ,:]", options: .caseInsensitive)
@@ -230,49 +221,78 @@ class LogFilesViewController : UITableViewController, UITableViewDragDelegate, T
 			time = delimiteresRegex?.stringByReplacingMatches(in: timestamp, options: .withoutAnchoringBounds, range: NSRange(location: 0, length: timestamp.count), withTemplate: "_") ?? ""
 
 		}
-		let shareableFileName = "ownCloud_" + time + ".log.txt"
+		return "ownCloud_" + time
+	}
 
-		if makeNamedCopy {
-			let shareableLogURL = FileManager.default.temporaryDirectory.appendingPathComponent(shareableFileName)
+	private func shareLogRecord(at indexPath:IndexPath, sender: UITableViewCell) {
+		shareLogRecords([ self.logRecords[indexPath.row] ], sender: sender)
+	}
 
-			do {
-				if FileManager.default.fileExists(atPath: shareableLogURL.path) {
-					try FileManager.default.removeItem(at: shareableLogURL)
-				}
+	@objc private func shareAllLogs(_ sender: UIBarButtonItem) {
+		shareLogRecords(self.logRecords, sender: sender)
+	}
 
-				try FileManager.default.copyItem(atPath: logRecord.url.path, toPath: shareableLogURL.path)
-			} catch {
-				Log.error("Error providing copy of log \(logRecord.url.path) at \(shareableLogURL.path): \(error)")
-			}
+	private func shareLogRecords(_ records: [OCLogFileRecord], sender: Any) {
+		guard let newestRecord = records.first else { return }
 
-			completionHandler(shareableLogURL, shareableFileName, {
-				try? FileManager.default.removeItem(at: shareableLogURL)
-			})
-		} else {
-			completionHandler(logRecord.url, shareableFileName, nil)
+		let alert = ThemedAlertController(title: OCLocalizedString("Share logs", nil), message: nil, preferredStyle: .actionSheet)
+
+		alert.addAction(UIAlertAction(title: OCLocalizedString("Share", nil), style: .default, handler: { [weak self] _ in
+			self?.exportAndShareLogRecords(records, name: self?.shareableName(for: newestRecord), redact: false, sender: sender)
+		}))
+		alert.addAction(UIAlertAction(title: OCLocalizedString("Share with private data redacted", nil), style: .default, handler: { [weak self] _ in
+			self?.exportAndShareLogRecords(records, name: self?.shareableName(for: newestRecord), redact: true, sender: sender)
+		}))
+		alert.addAction(UIAlertAction(title: OCLocalizedString("Cancel", nil), style: .cancel))
+
+		if let sourceView = sender as? UIView {
+			alert.popoverPresentationController?.sourceView = sourceView
+			alert.popoverPresentationController?.sourceRect = sourceView.bounds
+		} else if let barButtonItem = sender as? UIBarButtonItem {
+			alert.popoverPresentationController?.barButtonItem = barButtonItem
 		}
+
+		self.present(alert, animated: true, completion: nil)
 	}
 
-	private func shareLogRecord(at indexPath:IndexPath, sender: UITableViewCell) {
-		provideLogURL(at: indexPath, makeNamedCopy: true) { (shareableLogURL, _, completionHandler) in
-			guard let shareableLogURL = shareableLogURL else {
-				completionHandler?()
-				return
-			}
+	private func exportAndShareLogRecords(_ records: [OCLogFileRecord], name: String?, redact: Bool, sender: Any) {
+		// Stream the logs into a single compressed archive, rather than copying them in full
+		let archiveURL = FileManager.default.temporaryDirectory.appendingPathComponent((name ?? "ownCloud") + ".logs.zip")
+		let logFiles = records.map { (record) in
+			LogBundleExporter.LogFile(url: record.url, name: (record.truncatedName() ?? record.name) + ".txt", creationDate: record.creationDate)
+		}
+		let exporter = LogBundleExporter(files: logFiles, maximumSize: LogFilesViewController.maximumExportSize, redactor: redact ? LogBundleExporter.makeDefaultRedactor() : nil)
 
-			let shareViewController = UIActivityViewController(activityItems: [shareableLogURL], applicationActivities:nil)
+		try? FileManager.default.removeItem(at: archiveURL)
 
-			shareViewController.completionWithItemsHandler = { (_, _, _, _) in
-				completionHandler?()
-			}
+		exporter.export(to: archiveURL, completionHandler: { [weak self] (statistics, error) in
+			OnMainThread {
+				guard let self, error == nil else {
+					Log.error("Error exporting logs to \(archiveURL.path): \(String(describing: error))")
+					try? FileManager.default.removeItem(at: archiveURL)
+					return
+				}
 
-			if UIDevice.current.isIpad {
-				shareViewController.popoverPresentationController?.sourceView = sender
-				shareViewController.popoverPresentationController?.sourceRect = sender.frame
-			}
+				if let statistics {
+					Log.debug("Exported \(statistics.includedBytes) bytes of logs (\(statistics.omittedBytes) omitted) to \(statistics.archiveBytes) bytes in \(statistics.duration) sec")
+				}
 
-			self.present(shareViewController, animated: true, completion: nil)
-		}
+				let shareViewController = UIActivityViewController(activityItems: [archiveURL], applicationActivities:nil)
+
+				shareViewController.completionWithItemsHandler = { (_, _, _, _) in
+					try? FileManager.default.removeItem(at: archiveURL)
+				}
+
+				if let sourceView = sender as? UIView {
+					shareViewController.popoverPresentationController?.sourceView = sourceView
+					shareViewController.popoverPresentationController?.sourceRect = sourceView.bounds
+				} else if let barButtonItem = sender as? UIBarButtonItem {
+					shareViewController.popoverPresentationController?.barButtonItem = barButtonItem
+				}
+
+				self.present(shareViewController, animated: true, completion: nil)
+			}
+		})
 	}
 
 	private func removeLogRecord(at indexPath:IndexPath) {
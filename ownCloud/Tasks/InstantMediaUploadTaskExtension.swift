@@ -74,57 +74,65 @@ class InstantMediaUploadTaskExtension : ScheduledTaskAction {
 	private func uploadPhotoAssets(for bookmark:OCBookmark, at targetLocation: OCLocation) -> Int {
 		guard let userDefaults = OCAppIdentity.shared.userDefaults else { return 0 }
 
-		var photoAssets = [PHAsset]()
+		return uploadAssets(with: [.image], trackerIdentifier: "photos", createdAfter: userDefaults.instantUploadPhotosAfter, for: bookmark, at: targetLocation, updateCreatedAfter: { (lastCreationDate) in
+			userDefaults.instantUploadPhotosAfter = lastCreationDate
+			Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Last added photo asset creation date: \(String(describing: userDefaults.instantUploadPhotosAfter))")
+		})
+	}
 
-        Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Fetching images created after \(String(describing: userDefaults.instantUploadPhotosAfter))")
+	private func uploadVideoAssets(for bookmark:OCBookmark, at targetLocation: OCLocation) -> Int {
+		guard let userDefaults = OCAppIdentity.shared.userDefaults else { return 0 }
 
-		// Add photo assets
-		if let uploadPhotosAfter = userDefaults.instantUploadPhotosAfter {
-			let fetchResult = PHAsset.fetchAssetsFromCameraRoll(with: [.image], createdAfter: uploadPhotosAfter)
-			if fetchResult != nil {
-				fetchResult!.enumerateObjects({ (asset, _, _) in
-					photoAssets.append(asset)
-				})
-			}
-		}
+		return uploadAssets(with: [.video], trackerIdentifier: "videos", createdAfter: userDefaults.instantUploadVideosAfter, for: bookmark, at: targetLocation, updateCreatedAfter: { (lastCreationDate) in
+			userDefaults.instantUploadVideosAfter = lastCreationDate
+			Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Last added video asset creation date: \(String(describing: userDefaults.instantUploadVideosAfter))")
+		})
+	}
 
-		Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Importing \(photoAssets.count) photo assets")
+	private func uploadAssets(with mediaTypes: [PHAssetMediaType], trackerIdentifier: String, createdAfter: Date?, for bookmark:OCBookmark, at targetLocation: OCLocation, updateCreatedAfter: (_ lastCreationDate: Date) -> Void) -> Int {
+		// Instant uploads are only active once a start date has been set
+		guard let createdAfter = createdAfter else { return 0 }
 
-		if photoAssets.count > 0 {
-			MediaUploadQueue.shared.addUploads(Array(photoAssets), for: bookmark, at: targetLocation)
-			userDefaults.instantUploadPhotosAfter = photoAssets.last?.creationDate
-            Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Last added photo asset modification date: \(String(describing: userDefaults.instantUploadPhotosAfter))")
-		}
+		Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Fetching \(trackerIdentifier) changed since last run or created after \(createdAfter)")
 
-		return photoAssets.count
-	}
+		var assetIdentifiers = [String]()
+		var lastCreationDate: Date?
 
-	private func uploadVideoAssets(for bookmark:OCBookmark, at targetLocation: OCLocation) -> Int {
-		guard let userDefaults = OCAppIdentity.shared.userDefaults else { return 0 }
+		if #available(iOS 16, *), PHPhotoLibrary.authorizationStatus() == .authorized, let cursorStore = bookmark.mediaUploadKeyValueStore {
+			// Process only inserted and edited assets since the last run, using the change cursor stored in the vault. The cut-off date is
+			// not advanced here, so assets created after activation that show up late (iCloud) or get edited later are still picked up.
+			let tracker = PhotoLibraryChangeTracker(identifier: trackerIdentifier, source: PhotoLibraryPersistentChangeSource(), cursorStore: cursorStore)
+			let delta = tracker.delta(for: mediaTypes, createdAfter: createdAfter)
 
-		var videoAssets = [PHAsset]()
+			assetIdentifiers = delta.assets.map({ $0.localIdentifier })
 
-        Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Fetching videos created after \(String(describing: userDefaults.instantUploadVideosAfter))")
+			Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Importing \(assetIdentifiers.count) \(trackerIdentifier) assets (fullScan: \(delta.isFullScan))")
+
+			if assetIdentifiers.count > 0 {
+				MediaUploadQueue.shared.addUploads(withAssetIdentifiers: assetIdentifiers, for: bookmark, at: targetLocation)
+			}
 
-		// Add video assets
-		if let uploadVideosAfter = userDefaults.instantUploadVideosAfter {
-			let fetchResult = PHAsset.fetchAssetsFromCameraRoll(with: [.video], createdAfter: uploadVideosAfter)
-			if fetchResult != nil {
-				fetchResult!.enumerateObjects({ (asset, _, _) in
-					videoAssets.append(asset)
+			tracker.commit(delta)
+		} else {
+			if let fetchResult = PHAsset.fetchAssetsFromCameraRoll(with: mediaTypes, createdAfter: createdAfter) {
+				fetchResult.enumerateObjects({ (asset, _, _) in
+					assetIdentifiers.append(asset.localIdentifier)
 				})
+				lastCreationDate = fetchResult.lastObject?.creationDate
 			}
-		}
 
-		Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Importing \(videoAssets.count) video assets")
+			Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Importing \(assetIdentifiers.count) \(trackerIdentifier) assets")
+
+			if assetIdentifiers.count > 0 {
+				MediaUploadQueue.shared.addUploads(withAssetIdentifiers: assetIdentifiers, for: bookmark, at: targetLocation)
+			}
+		}
 
-		if videoAssets.count > 0 {
-			MediaUploadQueue.shared.addUploads(videoAssets, for: bookmark, at: targetLocation)
-			userDefaults.instantUploadVideosAfter = videoAssets.last?.creationDate
-            Log.debug(tagged: ["INSTANT_MEDIA_UPLOAD"], "Last added video asset modification date: \(String(describing: userDefaults.instantUploadPhotosAfter))")
+		if let lastCreationDate = lastCreationDate, lastCreationDate > createdAfter {
+			updateCreatedAfter(lastCreationDate)
 		}
 
-		return videoAssets.count
+		return assetIdentifiers.count
 	}
 
 }
@@ -0,0 +1,50 @@
+//
+//  AppLockState.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// In-memory snapshot of the AppLock state stored in the keychain by AppLockManager. The snapshot is invalidated when AppLockManager posts OCIPCNotificationNameAppLockStateChanged after writing the keychain - and after .maximumSnapshotAge as a safety net for notifications missed while a process was suspended.
+@interface AppLockState : NSObject
+
+@property(class,strong,nonatomic,readonly) AppLockState *sharedAppLockState;
+
+@property(assign) NSTimeInterval maximumSnapshotAge; //!< Maximum time a snapshot is used before the keychain is read again (default: 10 seconds)
+@property(assign) BOOL snapshotEnabled; //!< If NO, the keychain is read on every access (default: YES)
+
+@property(strong,nullable,readonly) NSDate *lockedDate; //!< Date the app was last backgrounded / locked
+@property(strong,nullable,readonly) NSNumber *unlocked; //!< Unlocked state (nil if never stored)
+
+- (instancetype)initWithKeychain:(nullable OCKeychain *)keychain;
+
+/// Returns YES if content must not be provided because the app is locked - or the unlock has expired after lockDelay seconds.
+- (BOOL)isLockedWithLockDelay:(NSInteger)lockDelay;
+
+/// Drops the snapshot, so the next access reads the keychain again.
+- (void)invalidate;
+
+/// Invalidates the snapshot in this and all other processes. To be called after changing the AppLock state in the keychain.
++ (void)postStateChangeNotification;
+
+@end
+
+extern OCIPCNotificationName OCIPCNotificationNameAppLockStateChanged; //!< Posted when the AppLock state in the keychain changed (internal use only)
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,165 @@
+//
+//  AppLockState.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "AppLockState.h"
+
+static NSString *AppLockStateKeychainAccount = @"app.passcode";
+static NSString *AppLockStateKeychainPathLockedDate = @"lockedDate";
+static NSString *AppLockStateKeychainPathUnlocked = @"unlocked";
+
+@interface AppLockState ()
+{
+	OCKeychain *_keychain;
+
+	NSDate *_snapshotDate;
+	NSDate *_lockedDate;
+	NSNumber *_unlocked;
+}
+@end
+
+@implementation AppLockState
+
++ (AppLockState *)sharedAppLockState
+{
+	static dispatch_once_t onceToken;
+	static AppLockState *sharedAppLockState;
+
+	dispatch_once(&onceToken, ^{
+		sharedAppLockState = [[AppLockState alloc] initWithKeychain:nil];
+	});
+
+	return (sharedAppLockState);
+}
+
+- (instancetype)initWithKeychain:(OCKeychain *)keychain
+{
+	if ((self = [super init]) != nil)
+	{
+		_keychain = keychain;
+		_maximumSnapshotAge = 10;
+		_snapshotEnabled = YES;
+
+		[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:OCIPCNotificationNameAppLockStateChanged withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, AppLockState *appLockState, OCIPCNotificationName  _Nonnull notificationName) {
+			[appLockState invalidate];
+		}];
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[OCIPNotificationCenter.sharedNotificationCenter removeObserver:self forName:OCIPCNotificationNameAppLockStateChanged];
+}
+
+#pragma mark - Snapshot
+- (void)_updateSnapshotIfNeeded
+{
+	@synchronized(self)
+	{
+		if (_snapshotEnabled && (_snapshotDate != nil) && ((-_snapshotDate.timeIntervalSinceNow) < _maximumSnapshotAge))
+		{
+			return;
+		}
+
+		OCKeychain *keychain = (_keychain != nil) ? _keychain : OCAppIdentity.sharedAppIdentity.keychain;
+		NSData *lockedDateData = [keychain readDataFromKeychainItemForAccount:AppLockStateKeychainAccount path:AppLockStateKeychainPathLockedDate];
+		NSData *unlockedData = [keychain readDataFromKeychainItemForAccount:AppLockStateKeychainAccount path:AppLockStateKeychainPathUnlocked];
+
+		_lockedDate = (lockedDateData != nil) ? [NSKeyedUnarchiver unarchivedObjectOfClass:NSDate.class fromData:lockedDateData error:NULL] : nil;
+		_unlocked = nil;
+
+		if (unlockedData != nil)
+		{
+			// Treat undecodable data as locked
+			NSNumber *unlocked = [NSKeyedUnarchiver unarchivedObjectOfClass:NSNumber.class fromData:unlockedData error:NULL];
+			_unlocked = (unlocked != nil) ? unlocked : @(NO);
+		}
+
+		_snapshotDate = [NSDate new];
+	}
+}
+
+- (void)invalidate
+{
+	@synchronized(self)
+	{
+		_snapshotDate = nil;
+	}
+}
+
++ (void)postStateChangeNotification
+{
+	[AppLockState.sharedAppLockState invalidate];
+	[OCIPNotificationCenter.sharedNotificationCenter postNotificationForName:OCIPCNotificationNameAppLockStateChanged ignoreSelf:YES];
+}
+
+#pragma mark - State
+- (NSDate *)lockedDate
+{
+	@synchronized(self)
+	{
+		[self _updateSnapshotIfNeeded];
+		return (_lockedDate);
+	}
+}
+
+- (NSNumber *)unlocked
+{
+	@synchronized(self)
+	{
+		[self _updateSnapshotIfNeeded];
+		return (_unlocked);
+	}
+}
+
+- (BOOL)isLockedWithLockDelay:(NSInteger)lockDelay
+{
+	NSDate *lockedDate;
+	NSNumber *unlocked;
+
+	@synchronized(self)
+	{
+		[self _updateSnapshotIfNeeded];
+
+		lockedDate = _lockedDate;
+		unlocked = _unlocked;
+	}
+
+	if (unlocked == nil)
+	{
+		return (NO);
+	}
+
+	if (!unlocked.boolValue)
+	{
+		return (YES);
+	}
+
+	if ((lockedDate != nil) && ([[lockedDate dateByAddingTimeInterval:lockDelay] compare:[NSDate date]] == NSOrderedAscending))
+	{
+		// Unlock has expired
+		return (YES);
+	}
+
+	return (NO);
+}
+
+@end
+
+OCIPCNotificationName OCIPCNotificationNameAppLockStateChanged = @"org.owncloud.app-lock-state-changed";
@@ -46,6 +46,11 @@ typedef NSString* BrandingAssetSuffix NS_TYPED_EXTENSIBLE_ENUM;
 
 @property(strong,nullable,nonatomic,readonly) NSBundle *appBundle; //!< Bundle of the main app
 
+@property(assign,nonatomic) BOOL cachesResolvedValues; //!< If YES, computed values, URLs and images are resolved once and cached until -invalidateResolvedValues (default: YES)
+@property(readonly,nonatomic) NSUInteger valueResolutionCount; //!< Number of values resolved through legacy key paths and class settings (statistics)
+
+- (instancetype)initWithAppBundle:(nullable NSBundle *)appBundle brandingPlistURL:(nullable NSURL *)brandingPlistURL; //!< Branding using the provided bundle and Branding.plist. Use .sharedBranding for the app's branding.
+
 - (NSArray<NSString *> *)appURLSchemesForBundleURLName:(nullable NSString *)bundleURLName; //!< URL schemes from the app's Info.plist matching the provided CFBundleURLName.
 
 @property(strong) NSDictionary<OCClassSettingsKey, BrandingLegacyKeyPath> *legacyKeyPathsByClassSettingsKeys;
@@ -69,6 +74,8 @@ typedef NSString* BrandingAssetSuffix NS_TYPED_EXTENSIBLE_ENUM;
 
 - (void)registerUserDefaultsDefaults;
 
+- (void)invalidateResolvedValues; //!< Drops all cached values, URLs and images. Called automatically on NSUserDefaultsDidChangeNotification (managed configuration changes) and when legacy key paths are registered or .allowBranding changes.
+
 @end
 
 extern OCClassSettingsIdentifier OCClassSettingsIdentifierBranding;
@@ -22,6 +22,10 @@
 {
 	NSBundle *_appBundle;
 	NSURL *_brandingPlistURL;
+
+	NSMutableDictionary<OCClassSettingsKey, id> *_resolvedValues;
+	NSMutableDictionary<OCClassSettingsKey, id> *_resolvedURLs;
+	NSCache<NSString *, id> *_brandedImages;
 }
 @end
 
@@ -58,28 +62,45 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 
 - (instancetype)init
 {
-	if ((self = [super init]) != nil)
-	{
-		NSBundle *appBundle;
+	NSBundle *appBundle;
 
-		if ((appBundle = NSBundle.mainBundle) != nil)
+	if ((appBundle = NSBundle.mainBundle) != nil)
+	{
+		if ([appBundle.bundleURL.pathExtension isEqual:@"appex"])
 		{
-			if ([appBundle.bundleURL.pathExtension isEqual:@"appex"])
-			{
-				// Find container app bundle (ownCloud.app/PlugIns/Extension.appex)
-				appBundle = [NSBundle bundleWithURL:appBundle.bundleURL.URLByDeletingLastPathComponent.URLByDeletingLastPathComponent];
-			}
+			// Find container app bundle (ownCloud.app/PlugIns/Extension.appex)
+			appBundle = [NSBundle bundleWithURL:appBundle.bundleURL.URLByDeletingLastPathComponent.URLByDeletingLastPathComponent];
 		}
+	}
+
+	if ((self = [self initWithAppBundle:appBundle brandingPlistURL:[appBundle URLForResource:@"Branding" withExtension:@"plist"]]) != nil)
+	{
+		// Set app.name localization variable to branded name
+		[OCLocaleFilterVariables.shared setVariable:@"app.name" value:self.appDisplayName];
+	}
+
+	return (self);
+}
 
+- (instancetype)initWithAppBundle:(nullable NSBundle *)appBundle brandingPlistURL:(nullable NSURL *)brandingPlistURL
+{
+	if ((self = [super init]) != nil)
+	{
 		_appBundle = appBundle;
-		_brandingPlistURL = [appBundle URLForResource:@"Branding" withExtension:@"plist"];
+		_brandingPlistURL = brandingPlistURL;
 
 		_allowBranding = YES;
 		_allowThemeSelection = YES;
 
+		_cachesResolvedValues = YES;
+		_resolvedValues = [NSMutableDictionary new];
+		_resolvedURLs = [NSMutableDictionary new];
+		_brandedImages = [NSCache new];
+		_brandedImages.name = @"Branded images";
+
 		NSData *brandingPlistData;
 
-		if ((brandingPlistData = [NSData dataWithContentsOfURL:_brandingPlistURL]) != nil)
+		if ((_brandingPlistURL != nil) && ((brandingPlistData = [NSData dataWithContentsOfURL:_brandingPlistURL]) != nil))
 		{
 			NSError *error = nil;
 
@@ -107,13 +128,18 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 			[(id<BrandingInitialization>)self initializeSharedBranding];
 		}
 
-		// Set app.name localization variable to branded name
-		[OCLocaleFilterVariables.shared setVariable:@"app.name" value:self.appDisplayName];
+		// Managed configuration changes arrive through NSUserDefaults
+		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(invalidateResolvedValues) name:NSUserDefaultsDidChangeNotification object:nil];
 	}
 
 	return (self);
 }
 
+- (void)dealloc
+{
+	[NSNotificationCenter.defaultCenter removeObserver:self name:NSUserDefaultsDidChangeNotification object:nil];
+}
+
 - (void)registerUserDefaultsDefaults
 {
 	// Register user defaults
@@ -136,6 +162,27 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 	mutableLegacyKeyPathsByClassSettingsKeys = (NSMutableDictionary<OCClassSettingsKey, BrandingLegacyKeyPath> *)_legacyKeyPathsByClassSettingsKeys;
 
 	mutableLegacyKeyPathsByClassSettingsKeys[classSettingsKey] = keyPath;
+
+	[self invalidateResolvedValues];
+}
+
+- (void)setAllowBranding:(BOOL)allowBranding
+{
+	_allowBranding = allowBranding;
+
+	[self invalidateResolvedValues];
+}
+
+#pragma mark - Resolved value cache
+- (void)invalidateResolvedValues
+{
+	@synchronized(_resolvedValues)
+	{
+		[_resolvedValues removeAllObjects];
+		[_resolvedURLs removeAllObjects];
+	}
+
+	[_brandedImages removeAllObjects];
 }
 
 - (NSString *)appName
@@ -210,12 +257,19 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 
 - (nullable UIImage *)brandedImageNamed:(BrandingImageName)imageName
 {
-	return ([UIImage imageNamed:imageName inBundle:self.appBundle compatibleWithTraitCollection:nil]);
+	return ([self brandedImageNamed:imageName assetSuffix:nil]);
 }
 
 - (nullable UIImage *)brandedImageNamed:(BrandingImageName)imageName assetSuffix:(BrandingAssetSuffix)assetSuffix
 {
+	NSString *cacheKey = (assetSuffix != nil) ? [imageName stringByAppendingFormat:@"-%@", assetSuffix] : imageName;
 	UIImage *image = nil;
+	id cachedImage;
+
+	if (_cachesResolvedValues && ((cachedImage = [_brandedImages objectForKey:cacheKey]) != nil))
+	{
+		return (OCTypedCast(cachedImage, UIImage));
+	}
 
 	if (assetSuffix != nil) {
 		image = [UIImage imageNamed:[imageName stringByAppendingFormat:@"-%@", assetSuffix] inBundle:self.appBundle compatibleWithTraitCollection:nil];
@@ -225,6 +279,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 		image = [UIImage imageNamed:imageName inBundle:self.appBundle compatibleWithTraitCollection:nil];
 	}
 
+	if (_cachesResolvedValues)
+	{
+		[_brandedImages setObject:((image != nil) ? image : NSNull.null) forKey:cacheKey];
+	}
+
 	return (image);
 }
 
@@ -234,6 +293,36 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 
 	if (classSettingsKey == nil) { return(nil); }
 
+	if (_cachesResolvedValues)
+	{
+		@synchronized(_resolvedValues)
+		{
+			if ((value = _resolvedValues[classSettingsKey]) != nil)
+			{
+				return ((value != NSNull.null) ? value : nil);
+			}
+		}
+	}
+
+	value = [self _resolveValueForClassSettingsKey:classSettingsKey];
+
+	if (_cachesResolvedValues)
+	{
+		@synchronized(_resolvedValues)
+		{
+			_resolvedValues[classSettingsKey] = (value != nil) ? value : NSNull.null;
+		}
+	}
+
+	return (value);
+}
+
+- (nullable id)_resolveValueForClassSettingsKey:(OCClassSettingsKey)classSettingsKey
+{
+	id value = nil;
+
+	_valueResolutionCount++;
+
 	if (!self.allowBranding)
 	{
 		// If branding is not allowed, return default value
@@ -260,6 +349,36 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(Branding)
 }
 
 - (nullable NSURL *)urlForClassSettingsKey:(OCClassSettingsKey)settingsKey
+{
+	NSURL *url = nil;
+
+	if (settingsKey == nil) { return(nil); }
+
+	if (_cachesResolvedValues)
+	{
+		@synchronized(_resolvedValues)
+		{
+			if ((url = _resolvedURLs[settingsKey]) != nil)
+			{
+				return (OCTypedCast(url, NSURL));
+			}
+		}
+	}
+
+	url = [self _parseURLForClassSettingsKey:settingsKey];
+
+	if (_cachesResolvedValues)
+	{
+		@synchronized(_resolvedValues)
+		{
+			_resolvedURLs[settingsKey] = (url != nil) ? url : (id)NSNull.null;
+		}
+	}
+
+	return (url);
+}
+
+- (nullable NSURL *)_parseURLForClassSettingsKey:(OCClassSettingsKey)settingsKey
 {
 	NSString *urlString;
 
@@ -18,6 +18,7 @@
 
 #import <Foundation/Foundation.h>
 #import <ownCloudSDK/ownCloudSDK.h>
+#import "ConfidentialSettingsSnapshot.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -27,6 +28,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property(class,strong,nonatomic,readonly) NSArray<OCExtensionIdentifier> *autoDisallowedActions; //!< List of identifiers of action extensions that would be automatically disallowed when enabling confidential protections and not making use of any exemptions.
 
+@property (nonatomic, strong, readonly) ConfidentialSettingsSnapshot *settingsSnapshot; //!< Snapshot of the current settings, rebuilt on first access after a change. Capture it once when reading several settings, f.ex. while drawing.
+
+- (void)invalidateSettingsSnapshot; //!< Drops the snapshot, so the next access resolves the settings again. Called automatically on NSUserDefaultsDidChangeNotification.
+
 @property (nonatomic, readonly) BOOL allowScreenshots;
 @property (nonatomic, readonly) BOOL markConfidentialViews;
 @property (nonatomic, readonly) BOOL allowOverwriteConfidentialMDMSettings;
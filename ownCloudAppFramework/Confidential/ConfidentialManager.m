@@ -19,6 +19,13 @@
 #import "ConfidentialManager.h"
 #import "OCFileProviderSettings.h"
 
+@interface ConfidentialManager ()
+{
+	ConfidentialSettingsSnapshot *_settingsSnapshot;
+	NSUInteger _settingsSnapshotGeneration;
+}
+@end
+
 @implementation ConfidentialManager
 
 + (void)load
@@ -26,6 +33,22 @@
 	[OCClassSettings.sharedSettings addSource:ConfidentialManager.sharedConfidentialManager];
 }
 
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		// MDM (managed app configuration) and user preference changes arrive through NSUserDefaults
+		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(invalidateSettingsSnapshot) name:NSUserDefaultsDidChangeNotification object:nil];
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[NSNotificationCenter.defaultCenter removeObserver:self name:NSUserDefaultsDidChangeNotification object:nil];
+}
+
 + (instancetype)sharedConfidentialManager
 {
 	static dispatch_once_t onceToken;
@@ -45,69 +68,102 @@
 	return (OCClassSettingsIdentifierConfidential);
 }
 
+#pragma mark - Settings snapshot
+- (ConfidentialSettingsSnapshot *)settingsSnapshot
+{
+	ConfidentialSettingsSnapshot *snapshot;
+	NSUInteger generation;
+
+	@synchronized(self)
+	{
+		snapshot = _settingsSnapshot;
+		generation = _settingsSnapshotGeneration;
+	}
+
+	if (snapshot == nil)
+	{
+		// Resolve outside of the lock, as OCClassSettings calls back into -settingsForIdentifier:
+		snapshot = [[ConfidentialSettingsSnapshot alloc] initWithValueProvider:^id _Nullable(OCClassSettingsKey key) {
+			return ([ConfidentialManager classSettingForOCClassSettingsKey:key]);
+		}];
+
+		@synchronized(self)
+		{
+			// Only keep the snapshot if it wasn't invalidated while it was built
+			if ((_settingsSnapshot == nil) && (generation == _settingsSnapshotGeneration))
+			{
+				_settingsSnapshot = snapshot;
+			}
+		}
+	}
+
+	return (snapshot);
+}
+
+- (void)invalidateSettingsSnapshot
+{
+	@synchronized(self)
+	{
+		_settingsSnapshot = nil;
+		_settingsSnapshotGeneration++;
+	}
+}
+
+#pragma mark - Settings
 - (BOOL)allowScreenshots {
-	NSNumber *value = [ConfidentialManager classSettingForOCClassSettingsKey:OCClassSettingsKeyAllowScreenshots];
-	return (value != nil) ? value.boolValue : YES;
+	return (self.settingsSnapshot.allowScreenshots);
 }
 
 - (BOOL)markConfidentialViews {
-	return ([self showUserEmail] || [self showUserID] || [self showTimestamp] || ([[self customText] length] > 0));
+	return (self.settingsSnapshot.markConfidentialViews);
 }
 
 - (BOOL)allowOverwriteConfidentialMDMSettings {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyAllowOverwriteConfidentialMDMSettings];
-	return self.confidentialSettingsEnabled && ((value != nil) ? value.boolValue : NO);
+	return (self.settingsSnapshot.allowOverwriteConfidentialMDMSettings);
 }
 
 - (BOOL)confidentialSettingsEnabled {
-	return (!self.allowScreenshots || self.markConfidentialViews);
+	return (self.settingsSnapshot.confidentialSettingsEnabled);
 }
 
 - (CGFloat)textOpacity {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextOpacity];
-	return (value != nil) ? (value.intValue / 100.0) : 0.6;
+	return (self.settingsSnapshot.textOpacity);
 }
 
 - (NSString *)textColor {
-	return ([self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextColor]);
+	return (self.settingsSnapshot.textColor);
 }
 
 - (CGFloat)columnSpacing {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextColumnSpacing];
-	return (value != nil) ? value.floatValue : 40.0;
+	return (self.settingsSnapshot.columnSpacing);
 }
 
 - (CGFloat)lineSpacing {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextLineSpacing];
-	return (value != nil) ? value.floatValue : 40.0;
+	return (self.settingsSnapshot.lineSpacing);
 }
 
 - (BOOL)showUserEmail {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextShowUserEmail];
-	return (value != nil) ? value.boolValue : NO;
+	return (self.settingsSnapshot.showUserEmail);
 }
 
 - (BOOL)showUserID {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextShowUserID];
-	return (value != nil) ? value.boolValue : NO;
+	return (self.settingsSnapshot.showUserID);
 }
 
 - (BOOL)showTimestamp {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextShowTimestamp];
-	return (value != nil) ? value.boolValue : NO;
+	return (self.settingsSnapshot.showTimestamp);
 }
 
 - (NSString *)customText {
-	return ([self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextCustomText]);
+	return (self.settingsSnapshot.customText);
 }
 
 - (NSInteger)visibleRedactedCharacters {
-	NSNumber *value = [self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialVisibleRedactedCharacters];
-	return (value != nil) ? value.integerValue : -1;
+	return (self.settingsSnapshot.visibleRedactedCharacters);
 }
 
 - (NSArray<OCExtensionIdentifier> *)exemptActions {
-	return ([self classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialExemptedActions]);
+	return (self.settingsSnapshot.exemptActions);
 }
 
 + (NSArray<OCExtensionIdentifier> *)autoDisallowedActions {
@@ -128,17 +184,7 @@
 }
 
 - (NSArray<OCExtensionIdentifier> *)disallowedActions {
-	if (self.confidentialSettingsEnabled && !self.allowOverwriteConfidentialMDMSettings) {
-		NSMutableArray<NSString *> *disallowedActions = [ConfidentialManager.autoDisallowedActions mutableCopy];
-		NSArray<NSString *> *exemptActions;
-
-		if (((exemptActions = self.exemptActions) != nil) && (exemptActions.count > 0)) {
-			[disallowedActions removeObjectsInArray:exemptActions];
-		}
-
-		return (disallowedActions);
-	}
-	return (nil);
+	return (self.settingsSnapshot.disallowedActions);
 }
 
 + (NSDictionary<OCClassSettingsKey,id> *)defaultSettingsForIdentifier:(OCClassSettingsIdentifier)identifier
@@ -243,6 +289,11 @@
 
 - (nullable NSDictionary<OCClassSettingsKey, id> *)settingsForIdentifier:(OCClassSettingsIdentifier)identifier
 {
+	if ([identifier isEqual:OCClassSettingsIdentifierConfidential]) {
+		// Resolved while building the settings snapshot - never provides values for its own settings
+		return (nil);
+	}
+
 	if (!self.allowOverwriteConfidentialMDMSettings && self.confidentialSettingsEnabled) {
 		// Action
 		if ([identifier isEqual:@"action"]) { // OCClassSettingsIdentifier.action
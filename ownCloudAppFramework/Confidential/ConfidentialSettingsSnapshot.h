@@ -0,0 +1,50 @@
+//
+//  ConfidentialSettingsSnapshot.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef _Nullable id(^ConfidentialSettingsValueProvider)(OCClassSettingsKey key);
+
+/// Immutable set of the confidential settings, resolved once from class settings, so they can be read as plain properties - f.ex. while drawing
+@interface ConfidentialSettingsSnapshot : NSObject
+
+@property(readonly,nonatomic) BOOL allowScreenshots;
+@property(readonly,nonatomic) BOOL markConfidentialViews;
+@property(readonly,nonatomic) BOOL allowOverwriteConfidentialMDMSettings;
+@property(readonly,nonatomic) BOOL confidentialSettingsEnabled;
+
+@property(readonly,nonatomic) CGFloat textOpacity;
+@property(readonly,nonatomic,nullable) NSString *textColor;
+@property(readonly,nonatomic) CGFloat columnSpacing;
+@property(readonly,nonatomic) CGFloat lineSpacing;
+@property(readonly,nonatomic) BOOL showUserEmail;
+@property(readonly,nonatomic) BOOL showUserID;
+@property(readonly,nonatomic) BOOL showTimestamp;
+@property(readonly,nonatomic,nullable) NSString *customText;
+@property(readonly,nonatomic) NSInteger visibleRedactedCharacters;
+@property(readonly,nonatomic,nullable) NSArray<OCExtensionIdentifier> *exemptActions;
+@property(readonly,nonatomic,nullable) NSArray<OCExtensionIdentifier> *disallowedActions;
+
+- (instancetype)initWithValueProvider:(ConfidentialSettingsValueProvider)valueProvider; //!< Resolves all settings through valueProvider, which returns the class settings value for a key of OCClassSettingsIdentifierConfidential
+
+@end
+
+NS_ASSUME_NONNULL_END
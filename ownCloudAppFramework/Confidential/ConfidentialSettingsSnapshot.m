@@ -0,0 +1,63 @@
+//
+//  ConfidentialSettingsSnapshot.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "ConfidentialSettingsSnapshot.h"
+#import "ConfidentialManager.h"
+
+@implementation ConfidentialSettingsSnapshot
+
+- (instancetype)initWithValueProvider:(ConfidentialSettingsValueProvider)valueProvider
+{
+	if ((self = [super init]) != nil)
+	{
+		NSNumber *value;
+
+		_allowScreenshots = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyAllowScreenshots), NSNumber)) != nil) ? value.boolValue : YES;
+
+		_textOpacity = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextOpacity), NSNumber)) != nil) ? (value.intValue / 100.0) : 0.6;
+		_textColor = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextColor), NSString);
+		_columnSpacing = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextColumnSpacing), NSNumber)) != nil) ? value.floatValue : 40.0;
+		_lineSpacing = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextLineSpacing), NSNumber)) != nil) ? value.floatValue : 40.0;
+		_showUserEmail = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextShowUserEmail), NSNumber)) != nil) ? value.boolValue : NO;
+		_showUserID = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextShowUserID), NSNumber)) != nil) ? value.boolValue : NO;
+		_showTimestamp = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextShowTimestamp), NSNumber)) != nil) ? value.boolValue : NO;
+		_customText = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialTextCustomText), NSString);
+		_visibleRedactedCharacters = ((value = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialVisibleRedactedCharacters), NSNumber)) != nil) ? value.integerValue : -1;
+		_exemptActions = OCTypedCast(valueProvider(OCClassSettingsKeyConfidentialExemptedActions), NSArray);
+
+		_markConfidentialViews = (_showUserEmail || _showUserID || _showTimestamp || (_customText.length > 0));
+		_confidentialSettingsEnabled = (!_allowScreenshots || _markConfidentialViews);
+		_allowOverwriteConfidentialMDMSettings = _confidentialSettingsEnabled && (((value = OCTypedCast(valueProvider(OCClassSettingsKeyAllowOverwriteConfidentialMDMSettings), NSNumber)) != nil) ? value.boolValue : NO);
+
+		if (_confidentialSettingsEnabled && !_allowOverwriteConfidentialMDMSettings)
+		{
+			NSMutableArray<OCExtensionIdentifier> *disallowedActions = [ConfidentialManager.autoDisallowedActions mutableCopy];
+
+			if (_exemptActions.count > 0)
+			{
+				[disallowedActions removeObjectsInArray:_exemptActions];
+			}
+
+			_disallowedActions = disallowedActions;
+		}
+	}
+
+	return (self);
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  OCFileProviderProvisioningPolicy.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, OCFileProviderProvisioningDecision)
+{
+	OCFileProviderProvisioningDecisionDownload,			//!< No (usable) local copy or local copy is outdated: download
+	OCFileProviderProvisioningDecisionProvideLocalCopy,		//!< Local copy is current: provide as-is
+	OCFileProviderProvisioningDecisionProvideLocalModifications,	//!< Local copy has modifications that still need to be uploaded: provide as-is, never overwrite it with a download
+	OCFileProviderProvisioningDecisionProvideConflictingModifications //!< Local copy has modifications that still need to be uploaded, but a newer remote version exists, too: provide as-is and leave conflict resolution to the upload
+};
+
+typedef NS_ENUM(NSInteger, OCFileProviderProvisioningReason)
+{
+	OCFileProviderProvisioningReasonCurrent,
+	OCFileProviderProvisioningReasonNoLocalCopy,
+	OCFileProviderProvisioningReasonLocalFileMissing,
+	OCFileProviderProvisioningReasonLocalFileSizeMismatch,
+	OCFileProviderProvisioningReasonNewerRemoteVersion,
+	OCFileProviderProvisioningReasonLocallyModified
+};
+
+@protocol OCFileProviderProvisioningSource <NSObject>
+- (nullable NSURL *)localURLForItem:(OCItem *)item;
+@end
+
+@interface OCCore (FileProviderProvisioningSource) <OCFileProviderProvisioningSource>
+@end
+
+/// Decides how a file requested via -startProvidingItemAtURL: is provided, based on the local copy's version, size and modification state - so that current local copies don't go through the download path again.
+@interface OCFileProviderProvisioningPolicy : NSObject
+
+@property(class,strong,nonatomic,readonly) OCFileProviderProvisioningPolicy *sharedPolicy;
+
+#pragma mark - Decisions
+- (OCFileProviderProvisioningDecision)decisionForItem:(OCItem *)item source:(id<OCFileProviderProvisioningSource>)source reason:(nullable OCFileProviderProvisioningReason *)outReason;
+
+#pragma mark - Statistics
+@property(readonly) NSUInteger decisionCount;		//!< Number of decisions made
+@property(readonly) NSUInteger downloadCount;		//!< Number of decisions that required a download
+@property(readonly) unsigned long long avoidedBytes;	//!< Sum of the sizes of all files that were provided without download
+@property(readonly) NSTimeInterval totalDecisionTime;	//!< Sum of the time spent on all decisions
+
+- (void)resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,133 @@
+//
+//  OCFileProviderProvisioningPolicy.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCFileProviderProvisioningPolicy.h"
+
+@implementation OCCore (FileProviderProvisioningSource)
+@end
+
+@implementation OCFileProviderProvisioningPolicy
+
++ (OCFileProviderProvisioningPolicy *)sharedPolicy
+{
+	static dispatch_once_t onceToken;
+	static OCFileProviderProvisioningPolicy *sharedPolicy;
+
+	dispatch_once(&onceToken, ^{
+		sharedPolicy = [OCFileProviderProvisioningPolicy new];
+	});
+
+	return (sharedPolicy);
+}
+
+#pragma mark - Decisions
+- (OCFileProviderProvisioningDecision)_decisionForItem:(OCItem *)item source:(id<OCFileProviderProvisioningSource>)source reason:(OCFileProviderProvisioningReason *)outReason
+{
+	NSURL *localURL;
+	NSNumber *localFileSize = nil;
+
+	// No local copy
+	if ((item.localRelativePath == nil) || ((localURL = [source localURLForItem:item]) == nil))
+	{
+		*outReason = OCFileProviderProvisioningReasonNoLocalCopy;
+		return (OCFileProviderProvisioningDecisionDownload);
+	}
+
+	// Local copy missing on disk
+	if (![localURL getResourceValue:&localFileSize forKey:NSURLFileSizeKey error:NULL] || (localFileSize == nil))
+	{
+		*outReason = OCFileProviderProvisioningReasonLocalFileMissing;
+		return (OCFileProviderProvisioningDecisionDownload);
+	}
+
+	// Local modifications (not yet uploaded) - must never be overwritten by a download. The upload itself is conflict-safe
+	// (only replaces the remote file if its eTag still matches) and creates a conflict copy otherwise.
+	if (item.locallyModified || ((item.syncActivity & OCItemSyncActivityUploading) == OCItemSyncActivityUploading))
+	{
+		*outReason = OCFileProviderProvisioningReasonLocallyModified;
+
+		if ((item.remoteItem != nil) && ![item.remoteItem.itemVersionIdentifier isEqual:item.localCopyVersionIdentifier])
+		{
+			return (OCFileProviderProvisioningDecisionProvideConflictingModifications);
+		}
+
+		return (OCFileProviderProvisioningDecisionProvideLocalModifications);
+	}
+
+	// Newer remote version known
+	if ((item.remoteItem != nil) ||
+	    ((item.localCopyVersionIdentifier != nil) && (item.itemVersionIdentifier != nil) && ![item.localCopyVersionIdentifier isEqual:item.itemVersionIdentifier]))
+	{
+		*outReason = OCFileProviderProvisioningReasonNewerRemoteVersion;
+		return (OCFileProviderProvisioningDecisionDownload);
+	}
+
+	// Incomplete or otherwise damaged local copy
+	if (localFileSize.longLongValue != item.size)
+	{
+		*outReason = OCFileProviderProvisioningReasonLocalFileSizeMismatch;
+		return (OCFileProviderProvisioningDecisionDownload);
+	}
+
+	*outReason = OCFileProviderProvisioningReasonCurrent;
+	return (OCFileProviderProvisioningDecisionProvideLocalCopy);
+}
+
+- (OCFileProviderProvisioningDecision)decisionForItem:(OCItem *)item source:(id<OCFileProviderProvisioningSource>)source reason:(OCFileProviderProvisioningReason *)outReason
+{
+	CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+	OCFileProviderProvisioningReason reason = OCFileProviderProvisioningReasonNoLocalCopy;
+	OCFileProviderProvisioningDecision decision = [self _decisionForItem:item source:source reason:&reason];
+	NSTimeInterval decisionTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+	@synchronized(self)
+	{
+		_decisionCount++;
+		_totalDecisionTime += decisionTime;
+
+		if (decision == OCFileProviderProvisioningDecisionDownload)
+		{
+			_downloadCount++;
+		}
+		else if (item.size > 0)
+		{
+			_avoidedBytes += (unsigned long long)item.size;
+		}
+	}
+
+	if (outReason != NULL)
+	{
+		*outReason = reason;
+	}
+
+	return (decision);
+}
+
+#pragma mark - Statistics
+- (void)resetStatistics
+{
+	@synchronized(self)
+	{
+		_decisionCount = 0;
+		_downloadCount = 0;
+		_avoidedBytes = 0;
+		_totalDecisionTime = 0;
+	}
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  OCFileProviderWorkingSet.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_OPTIONS(NSUInteger, OCFileProviderWorkingSetReason)
+{
+	OCFileProviderWorkingSetReasonNone		= 0,
+	OCFileProviderWorkingSetReasonFavorite		= (1 << 0), //!< Item is a server-side favorite or has a local File Provider favorite rank
+	OCFileProviderWorkingSetReasonTagged		= (1 << 1), //!< Item has local File Provider tag data
+	OCFileProviderWorkingSetReasonAvailableOffline	= (1 << 2), //!< Item is available offline
+	OCFileProviderWorkingSetReasonLocalCopy		= (1 << 3), //!< Item has a local copy
+	OCFileProviderWorkingSetReasonRecentlyUsed	= (1 << 4)  //!< Item was used within .recentlyUsedInterval
+};
+
+typedef void(^OCFileProviderWorkingSetCompletionHandler)(NSError * _Nullable error);
+typedef void(^OCFileProviderWorkingSetChangesHandler)(NSError * _Nullable error, OCSyncAnchor _Nullable syncAnchor, NSArray<OCItem *> * _Nullable updatedItems, NSArray<OCItem *> * _Nullable deletedItems);
+
+/// Determines which locally known items make up the File Provider working set and serves them in pages from a snapshot, so that large item databases can be enumerated without keeping the system waiting for a single huge batch.
+///
+/// Snapshots are built from a database query pre-filtered to favorites, items with a local copy and recently used items, limited to .maximumSnapshotItemCount. Items that are only part of the working set because of local File Provider favorite ranks or tags can't be pre-filtered in the database and are only picked up through change enumeration.
+@interface OCFileProviderWorkingSet : NSObject
+
+@property(assign) NSTimeInterval recentlyUsedInterval; //!< Items used within this interval are part of the working set (default: 30 days)
+@property(assign) NSUInteger maximumPageSize; //!< Maximum number of items returned per page (default: 200)
+@property(assign) NSUInteger maximumSnapshotItemCount; //!< Maximum number of items retrieved from the database for a snapshot, most recently used first (default: 10000)
+
+@property(strong,nullable,readonly) OCSyncAnchor snapshotSyncAnchor; //!< Sync anchor of the database at the time the snapshot was made
+@property(readonly) NSUInteger count; //!< Number of items in the snapshot
+
+#pragma mark - Membership
+- (OCFileProviderWorkingSetReason)reasonsForItem:(OCItem *)item;
+- (BOOL)includesItem:(OCItem *)item;
+
+#pragma mark - Snapshot
+/// Builds a new snapshot from the passed items, keeping only those that are part of the working set. The snapshot also becomes the membership that changes are compared against.
+- (void)makeSnapshotFromItems:(NSArray<OCItem *> *)items syncAnchor:(nullable OCSyncAnchor)syncAnchor;
+
+/// Condition used to pre-filter items in the database when building a snapshot.
+- (OCQueryCondition *)snapshotQueryCondition;
+
+/// Builds a new snapshot from the items in the database matching .snapshotQueryCondition. fallbackSyncAnchor is used if the database doesn't return a sync anchor.
+- (void)makeSnapshotFromDatabase:(OCDatabase *)database fallbackSyncAnchor:(nullable OCSyncAnchor)fallbackSyncAnchor completionHandler:(OCFileProviderWorkingSetCompletionHandler)completionHandler;
+
+/// Returns the items for the page - and the next page via outNextPage (nil if this is the last page). Returns nil if the page was made for a different snapshot.
+- (nullable NSArray<OCItem *> *)itemsForPage:(nullable NSData *)page nextPage:(NSData * _Nullable * _Nullable)outNextPage;
+
+#pragma mark - Changes
+/// Splits items updated since a sync anchor into items to report as updated and items to report as deleted, and updates the membership accordingly. Deleted items are changed items that left the working set, plus members that left the working set without being changed (f.ex. items no longer used recently). If no membership is known yet (no snapshot was made), all changed items outside the working set are returned as deleted.
+- (void)classifyChangedItems:(NSArray<OCItem *> *)changedItems updatedItems:(NSArray<OCItem *> * _Nullable * _Nonnull)outUpdatedItems deletedItems:(NSArray<OCItem *> * _Nullable * _Nonnull)outDeletedItems;
+
+/// Retrieves the items changed in the database since the sync anchor and classifies them via -classifyChangedItems:updatedItems:deletedItems:.
+- (void)retrieveChangesFromDatabase:(OCDatabase *)database sinceSyncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCFileProviderWorkingSetChangesHandler)completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
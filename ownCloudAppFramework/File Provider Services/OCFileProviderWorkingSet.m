@@ -0,0 +1,282 @@
+//
+//  OCFileProviderWorkingSet.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCFileProviderWorkingSet.h"
+
+static NSString *OCFileProviderWorkingSetPageKeySyncAnchor = @"syncAnchor";
+static NSString *OCFileProviderWorkingSetPageKeyOffset = @"offset";
+
+@interface OCFileProviderWorkingSet ()
+{
+	NSArray<OCItem *> *_snapshotItems;
+	NSMutableDictionary<OCLocalID, OCItem *> *_membersByLocalID; //!< Items last reported to be part of the working set (nil if unknown)
+}
+@end
+
+@implementation OCFileProviderWorkingSet
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_recentlyUsedInterval = 30 * 24 * 60 * 60;
+		_maximumPageSize = 200;
+		_maximumSnapshotItemCount = 10000;
+	}
+
+	return (self);
+}
+
+#pragma mark - Membership
+- (OCFileProviderWorkingSetReason)_reasonsForItem:(OCItem *)item recentlyUsedCutoff:(NSDate *)recentlyUsedCutoff
+{
+	OCFileProviderWorkingSetReason reasons = OCFileProviderWorkingSetReasonNone;
+
+	if (item.removed || (item.localID == nil))
+	{
+		return (OCFileProviderWorkingSetReasonNone);
+	}
+
+	if (item.isFavorite.boolValue || ([item valueForLocalAttribute:OCLocalAttributeFavoriteRank] != nil))
+	{
+		reasons |= OCFileProviderWorkingSetReasonFavorite;
+	}
+
+	if ([item valueForLocalAttribute:OCLocalAttributeTagData] != nil)
+	{
+		reasons |= OCFileProviderWorkingSetReasonTagged;
+	}
+
+	if ([item.downloadTriggerIdentifier isEqual:OCItemDownloadTriggerIDAvailableOffline])
+	{
+		reasons |= OCFileProviderWorkingSetReasonAvailableOffline;
+	}
+
+	if (item.localRelativePath != nil)
+	{
+		reasons |= OCFileProviderWorkingSetReasonLocalCopy;
+	}
+
+	if ((item.lastUsed != nil) && ([item.lastUsed compare:recentlyUsedCutoff] == NSOrderedDescending))
+	{
+		reasons |= OCFileProviderWorkingSetReasonRecentlyUsed;
+	}
+
+	return (reasons);
+}
+
+- (NSDate *)_recentlyUsedCutoff
+{
+	return ([NSDate dateWithTimeIntervalSinceNow:-_recentlyUsedInterval]);
+}
+
+- (OCFileProviderWorkingSetReason)reasonsForItem:(OCItem *)item
+{
+	return ([self _reasonsForItem:item recentlyUsedCutoff:self._recentlyUsedCutoff]);
+}
+
+- (BOOL)includesItem:(OCItem *)item
+{
+	return ([self reasonsForItem:item] != OCFileProviderWorkingSetReasonNone);
+}
+
+#pragma mark - Snapshot
+- (void)makeSnapshotFromItems:(NSArray<OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor
+{
+	NSDate *recentlyUsedCutoff = self._recentlyUsedCutoff;
+	NSMutableArray<OCItem *> *snapshotItems = [NSMutableArray new];
+	NSMutableDictionary<OCLocalID, OCItem *> *membersByLocalID = [NSMutableDictionary new];
+
+	for (OCItem *item in items)
+	{
+		if ([self _reasonsForItem:item recentlyUsedCutoff:recentlyUsedCutoff] != OCFileProviderWorkingSetReasonNone)
+		{
+			[snapshotItems addObject:item];
+			membersByLocalID[item.localID] = item;
+		}
+	}
+
+	// Stable order, so that pages remain valid for snapshots made at the same sync anchor
+	[snapshotItems sortUsingComparator:^NSComparisonResult(OCItem * _Nonnull item1, OCItem * _Nonnull item2) {
+		return ([item1.localID compare:item2.localID]);
+	}];
+
+	@synchronized(self)
+	{
+		_snapshotItems = snapshotItems;
+		_snapshotSyncAnchor = syncAnchor;
+		_membersByLocalID = membersByLocalID;
+	}
+}
+
+- (OCQueryCondition *)snapshotQueryCondition
+{
+	OCQueryCondition *condition = [OCQueryCondition anyOf:@[
+		[OCQueryCondition where:OCItemPropertyNameIsFavorite isEqualTo:@(YES)],
+		[OCQueryCondition where:OCItemPropertyNameLocalRelativePath startsWith:@""], // matches all items with a local copy (incl. downloaded available offline items), but not NULL
+		[OCQueryCondition where:OCItemPropertyNameLastUsed isGreaterThan:self._recentlyUsedCutoff]
+	]];
+
+	condition.sortBy = OCItemPropertyNameLastUsed;
+	condition.sortAscending = NO;
+	condition.maxResultCount = @(_maximumSnapshotItemCount);
+
+	return (condition);
+}
+
+- (void)makeSnapshotFromDatabase:(OCDatabase *)database fallbackSyncAnchor:(OCSyncAnchor)fallbackSyncAnchor completionHandler:(OCFileProviderWorkingSetCompletionHandler)completionHandler
+{
+	[database retrieveCacheItemsForQueryCondition:self.snapshotQueryCondition cancelAction:nil completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+		if (error == nil)
+		{
+			[self makeSnapshotFromItems:items syncAnchor:((syncAnchor != nil) ? syncAnchor : fallbackSyncAnchor)];
+		}
+
+		completionHandler(error);
+	}];
+}
+
+- (NSUInteger)count
+{
+	@synchronized(self)
+	{
+		return (_snapshotItems.count);
+	}
+}
+
+- (NSData *)_pageForOffset:(NSUInteger)offset syncAnchor:(OCSyncAnchor)syncAnchor
+{
+	NSMutableDictionary *pageDict = [NSMutableDictionary new];
+
+	pageDict[OCFileProviderWorkingSetPageKeyOffset] = @(offset);
+	pageDict[OCFileProviderWorkingSetPageKeySyncAnchor] = syncAnchor;
+
+	return ([NSKeyedArchiver archivedDataWithRootObject:pageDict requiringSecureCoding:YES error:NULL]);
+}
+
+- (NSArray<OCItem *> *)itemsForPage:(NSData *)page nextPage:(NSData * _Nullable __autoreleasing *)outNextPage
+{
+	NSArray<OCItem *> *snapshotItems;
+	OCSyncAnchor snapshotSyncAnchor;
+	NSUInteger offset = 0;
+
+	@synchronized(self)
+	{
+		snapshotItems = _snapshotItems;
+		snapshotSyncAnchor = _snapshotSyncAnchor;
+	}
+
+	if (snapshotItems == nil)
+	{
+		return (nil);
+	}
+
+	// Pages not created by -_pageForOffset:syncAnchor: (like NSFileProviderInitialPageSortedByName) start at the beginning
+	NSDictionary *pageDict = (page != nil) ? [NSKeyedUnarchiver unarchivedObjectOfClasses:[NSSet setWithObjects:NSDictionary.class, NSNumber.class, NSString.class, nil] fromData:page error:NULL] : nil;
+
+	if ([pageDict isKindOfClass:NSDictionary.class])
+	{
+		OCSyncAnchor pageSyncAnchor = pageDict[OCFileProviderWorkingSetPageKeySyncAnchor];
+
+		if ((pageSyncAnchor != snapshotSyncAnchor) && ![pageSyncAnchor isEqual:snapshotSyncAnchor])
+		{
+			// Page belongs to a different snapshot
+			return (nil);
+		}
+
+		offset = [pageDict[OCFileProviderWorkingSetPageKeyOffset] unsignedIntegerValue];
+	}
+
+	if (offset > snapshotItems.count)
+	{
+		return (nil);
+	}
+
+	NSUInteger length = MIN(_maximumPageSize, snapshotItems.count - offset);
+
+	if (outNextPage != NULL)
+	{
+		*outNextPage = ((offset + length) < snapshotItems.count) ? [self _pageForOffset:(offset + length) syncAnchor:snapshotSyncAnchor] : nil;
+	}
+
+	return ([snapshotItems subarrayWithRange:NSMakeRange(offset, length)]);
+}
+
+#pragma mark - Changes
+- (void)classifyChangedItems:(NSArray<OCItem *> *)changedItems updatedItems:(NSArray<OCItem *> * _Nullable __autoreleasing *)outUpdatedItems deletedItems:(NSArray<OCItem *> * _Nullable __autoreleasing *)outDeletedItems
+{
+	NSDate *recentlyUsedCutoff = self._recentlyUsedCutoff;
+	NSMutableArray<OCItem *> *updatedItems = [NSMutableArray new];
+	NSMutableArray<OCItem *> *deletedItems = [NSMutableArray new];
+
+	@synchronized(self)
+	{
+		for (OCItem *item in changedItems)
+		{
+			if ([self _reasonsForItem:item recentlyUsedCutoff:recentlyUsedCutoff] != OCFileProviderWorkingSetReasonNone)
+			{
+				[updatedItems addObject:item];
+				_membersByLocalID[item.localID] = item;
+			}
+			else if (item.localID != nil)
+			{
+				if ((_membersByLocalID == nil) || (_membersByLocalID[item.localID] != nil))
+				{
+					// Left the working set (or membership is unknown - removing identifiers the system doesn't know is harmless)
+					[deletedItems addObject:item];
+					_membersByLocalID[item.localID] = nil;
+				}
+			}
+		}
+
+		// Members that left the working set without being changed (f.ex. no longer recently used)
+		NSMutableArray<OCLocalID> *leftLocalIDs = [NSMutableArray new];
+
+		[_membersByLocalID enumerateKeysAndObjectsUsingBlock:^(OCLocalID localID, OCItem *item, BOOL * _Nonnull stop) {
+			if ([self _reasonsForItem:item recentlyUsedCutoff:recentlyUsedCutoff] == OCFileProviderWorkingSetReasonNone)
+			{
+				[deletedItems addObject:item];
+				[leftLocalIDs addObject:localID];
+			}
+		}];
+
+		[_membersByLocalID removeObjectsForKeys:leftLocalIDs];
+	}
+
+	*outUpdatedItems = updatedItems;
+	*outDeletedItems = deletedItems;
+}
+
+- (void)retrieveChangesFromDatabase:(OCDatabase *)database sinceSyncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCFileProviderWorkingSetChangesHandler)completionHandler
+{
+	[database retrieveCacheItemsUpdatedSinceSyncAnchor:syncAnchor foldersOnly:NO completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor newSyncAnchor, NSArray<OCItem *> *changedItems) {
+		NSArray<OCItem *> *updatedItems = nil, *deletedItems = nil;
+
+		if (error != nil)
+		{
+			completionHandler(error, nil, nil, nil);
+			return;
+		}
+
+		[self classifyChangedItems:changedItems updatedItems:&updatedItems deletedItems:&deletedItems];
+
+		completionHandler(nil, newSyncAnchor, updatedItems, deletedItems);
+	}];
+}
+
+@end
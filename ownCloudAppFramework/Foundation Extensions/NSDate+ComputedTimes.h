@@ -29,6 +29,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (nullable instancetype)dateFromKeywordString:(NSString *)dateString;
 
+// Uncached reference implementations
++ (instancetype)computeStartOfRelativeDay:(NSInteger)dayOffset;
++ (instancetype)computeStartOfRelativeWeek:(NSInteger)weekOffset;
++ (instancetype)computeStartOfRelativeMonth:(NSInteger)monthOffset;
++ (instancetype)computeStartOfRelativeYear:(NSInteger)yearOffset;
+
++ (nullable instancetype)computeDateFromKeywordString:(NSString *)dateString;
+
++ (void)flushComputedTimes; //!< Removes all cached computed times. Called automatically on day, time zone and locale changes.
+
 @end
 
 NS_ASSUME_NONNULL_END
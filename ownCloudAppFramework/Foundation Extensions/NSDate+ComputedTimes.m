@@ -18,8 +18,157 @@
 
 #import "NSDate+ComputedTimes.h"
 
+/*
+	All computed times only depend on the current day (and calendar and time zone), so results are cached until the next day boundary. Keys are
+	NSNumbers small enough to be tagged pointers, so lookups typically don't allocate.
+*/
+typedef NS_ENUM(uint64_t, NSDateComputedTimeKind)
+{
+	NSDateComputedTimeKindDay = 1,
+	NSDateComputedTimeKindWeek,
+	NSDateComputedTimeKindMonth,
+	NSDateComputedTimeKindYear,
+	NSDateComputedTimeKindKeywordDate
+};
+
+static NSMutableDictionary<NSNumber *, NSDate *> *sComputedTimes;
+static NSTimeInterval sComputedTimesValidUntil;
+
 @implementation NSDate (ComputedTimes)
 
+#pragma mark - Cache
++ (void)flushComputedTimes
+{
+	@synchronized(NSDate.class)
+	{
+		[sComputedTimes removeAllObjects];
+		sComputedTimesValidUntil = 0;
+	}
+}
+
++ (NSDate *)_computedTimeOfKind:(NSDateComputedTimeKind)kind value:(NSInteger)value compute:(NSDate *(^)(void))computeBlock
+{
+	static dispatch_once_t onceToken;
+	NSNumber *key = @((kind << 48) | ((uint64_t)(value + INT32_MAX) & 0xFFFFFFFFFFFF));
+	NSTimeInterval now = NSDate.timeIntervalSinceReferenceDate;
+	NSDate *date = nil;
+
+	dispatch_once(&onceToken, ^{
+		sComputedTimes = [NSMutableDictionary new];
+
+		for (NSNotificationName notificationName in @[ NSCalendarDayChangedNotification, NSSystemTimeZoneDidChangeNotification, NSCurrentLocaleDidChangeNotification ])
+		{
+			[NSNotificationCenter.defaultCenter addObserverForName:notificationName object:nil queue:nil usingBlock:^(NSNotification * _Nonnull notification) {
+				[NSDate flushComputedTimes];
+			}];
+		}
+	});
+
+	@synchronized(NSDate.class)
+	{
+		if (now >= sComputedTimesValidUntil)
+		{
+			[sComputedTimes removeAllObjects];
+			sComputedTimesValidUntil = [NSDate computeStartOfRelativeDay:1].timeIntervalSinceReferenceDate;
+		}
+
+		date = sComputedTimes[key];
+	}
+
+	if (date == nil)
+	{
+		if ((date = computeBlock()) != nil)
+		{
+			@synchronized(NSDate.class)
+			{
+				sComputedTimes[key] = date;
+			}
+		}
+	}
+
+	return (date);
+}
+
++ (instancetype)startOfRelativeDay:(NSInteger)dayOffset
+{
+	return ([self _computedTimeOfKind:NSDateComputedTimeKindDay value:dayOffset compute:^{ return ([NSDate computeStartOfRelativeDay:dayOffset]); }]);
+}
+
++ (instancetype)startOfRelativeWeek:(NSInteger)weekOffset
+{
+	return ([self _computedTimeOfKind:NSDateComputedTimeKindWeek value:weekOffset compute:^{ return ([NSDate computeStartOfRelativeWeek:weekOffset]); }]);
+}
+
++ (instancetype)startOfRelativeMonth:(NSInteger)monthOffset
+{
+	return ([self _computedTimeOfKind:NSDateComputedTimeKindMonth value:monthOffset compute:^{ return ([NSDate computeStartOfRelativeMonth:monthOffset]); }]);
+}
+
++ (instancetype)startOfRelativeYear:(NSInteger)yearOffset
+{
+	return ([self _computedTimeOfKind:NSDateComputedTimeKindYear value:yearOffset compute:^{ return ([NSDate computeStartOfRelativeYear:yearOffset]); }]);
+}
+
+#pragma mark - Keyword dates
++ (nullable instancetype)dateFromKeywordString:(NSString *)dateString
+{
+	char bytes[16];
+	NSInteger values[3] = { 0, 0, 0 };
+	NSUInteger valueCount = 0, digitCount = 0;
+
+	// Fast path for well-formed YYYY, YYYY-M(M) and YYYY-M(M)-D(D) keywords, scanning the ASCII bytes directly.
+	// Anything else (including non-ASCII digits) is handled by the component-based implementation.
+	if ((dateString.length <= 10) && [dateString getCString:bytes maxLength:sizeof(bytes) encoding:NSASCIIStringEncoding])
+	{
+		BOOL wellFormed = YES;
+
+		for (const char *byte = bytes; wellFormed; byte++)
+		{
+			if ((*byte >= '0') && (*byte <= '9'))
+			{
+				values[valueCount] = (values[valueCount] * 10) + (*byte - '0');
+				digitCount++;
+
+				// Year has exactly 4 digits, month and day 1 or 2
+				wellFormed = (valueCount == 0) ? (digitCount <= 4) : (digitCount <= 2);
+			}
+			else if ((*byte == '-') || (*byte == 0))
+			{
+				wellFormed = (valueCount == 0) ? (digitCount == 4) : (digitCount > 0);
+				valueCount++;
+				digitCount = 0;
+
+				if ((*byte == 0) || (valueCount > 2))
+				{
+					wellFormed = wellFormed && (*byte == 0);
+					break;
+				}
+			}
+			else
+			{
+				wellFormed = NO;
+			}
+		}
+
+		if (wellFormed)
+		{
+			NSInteger year = values[0], month = (valueCount > 1) ? values[1] : 1, day = (valueCount > 2) ? values[2] : 1;
+
+			return ([self _computedTimeOfKind:NSDateComputedTimeKindKeywordDate value:(year * 10000) + (month * 100) + day compute:^{
+				return ([NSDate.date recomputeWithUnits:NSCalendarUnitDay|NSCalendarUnitMonth|NSCalendarUnitYear modifier:^(NSDateComponents *components) {
+					components.year = year;
+					components.month = month;
+					components.day = day;
+				}]);
+			}]);
+		}
+	}
+
+	return ([self computeDateFromKeywordString:dateString]);
+}
+
+#pragma mark - Computation
+
 - (instancetype)recomputeWithUnits:(NSCalendarUnit)units modifier:(void(^)(NSDateComponents *components))componentModifier
 {
 	NSCalendar *calendar = NSCalendar.autoupdatingCurrentCalendar;
@@ -33,19 +182,25 @@
 	return ([calendar dateFromComponents:components]);
 }
 
-+ (instancetype)startOfRelativeDay:(NSInteger)dayOffset
++ (instancetype)computeStartOfRelativeDay:(NSInteger)dayOffset
 {
-	return ([[NSDate dateWithTimeIntervalSinceNow:(NSTimeInterval)(dayOffset * 24 * 60 * 60)] recomputeWithUnits:NSCalendarUnitDay|NSCalendarUnitMonth|NSCalendarUnitYear modifier:nil]);
+	return ([self _startOfDay:dayOffset relativeToDate:NSDate.date calendar:NSCalendar.autoupdatingCurrentCalendar]);
 }
 
-+ (instancetype)startOfRelativeWeek:(NSInteger)weekOffset
++ (NSDate *)_startOfDay:(NSInteger)dayOffset relativeToDate:(NSDate *)date calendar:(NSCalendar *)calendar
+{
+	// Days around DST transitions don't have 24 hours, so use calendar arithmetic instead of adding multiples of 86400 seconds
+	return ([calendar dateByAddingUnit:NSCalendarUnitDay value:dayOffset toDate:[calendar startOfDayForDate:date] options:0]);
+}
+
++ (instancetype)computeStartOfRelativeWeek:(NSInteger)weekOffset
 {
 	return ([[NSDate dateWithTimeIntervalSinceNow:(NSTimeInterval)(weekOffset * 7 * 24 * 60 * 60)] recomputeWithUnits:NSCalendarUnitWeekday|NSCalendarUnitWeekOfMonth|NSCalendarUnitMonth|NSCalendarUnitYear modifier:^(NSDateComponents *components) {
 		components.weekday = 2; // Monday, 1 = Sunday
 	}]);
 }
 
-+ (instancetype)startOfRelativeMonth:(NSInteger)monthOffset
++ (instancetype)computeStartOfRelativeMonth:(NSInteger)monthOffset
 {
 	return ([NSDate.date recomputeWithUnits:NSCalendarUnitMonth|NSCalendarUnitYear modifier:^(NSDateComponents *components) {
 		if (monthOffset < 0)
@@ -89,7 +244,7 @@
 	}]);
 }
 
-+ (instancetype)startOfRelativeYear:(NSInteger)yearOffset
++ (instancetype)computeStartOfRelativeYear:(NSInteger)yearOffset
 {
 	return ([NSDate.date recomputeWithUnits:NSCalendarUnitDay|NSCalendarUnitMonth|NSCalendarUnitYear modifier:^(NSDateComponents *components) {
 		components.day = 1;
@@ -98,7 +253,7 @@
 	}]);
 }
 
-+ (nullable instancetype)dateFromKeywordString:(NSString *)dateString
++ (nullable instancetype)computeDateFromKeywordString:(NSString *)dateString
 {
 	NSArray<NSString *> *components = [dateString componentsSeparatedByString:@"-"];
 	NSString *yearString  = ((components.firstObject != nil) && (components.firstObject.length == 4)) ? components.firstObject : nil;
@@ -23,6 +23,7 @@ NS_ASSUME_NONNULL_BEGIN
 @interface NSString (ByteCountParser)
 
 - (nullable NSNumber *)byteCountNumber;
+- (nullable NSNumber *)referenceByteCountNumber; //!< String-based implementation of -byteCountNumber, used as fallback and for verification
 
 @end
 
@@ -21,6 +21,63 @@
 @implementation NSString (ByteCountParser)
 
 - (nullable NSNumber *)byteCountNumber
+{
+	char bytes[32];
+	size_t length;
+
+	// Fast path for printable ASCII strings with up to 18 digits, scanning the bytes directly. Everything else (leading whitespace,
+	// values that could overflow, non-ASCII characters) is handled by the string-based implementation.
+	if ((self.length < sizeof(bytes)) && [self getCString:bytes maxLength:sizeof(bytes) encoding:NSASCIIStringEncoding] && ((length = strlen(bytes)) > 0))
+	{
+		NSUInteger multiplier = 1;
+		size_t numberLength = length;
+		const char *byte = bytes;
+		BOOL negative = NO;
+		NSInteger value = 0;
+		NSUInteger digitCount = 0;
+
+		#define LowercaseByte(b) ((((b) >= 'A') && ((b) <= 'Z')) ? ((b) | 0x20) : (b))
+		#define HasSuffix2(c1,c2) ((length >= 2) && (LowercaseByte(bytes[length-2]) == c1) && (LowercaseByte(bytes[length-1]) == c2))
+		#define HasSuffix3(c1,c2,c3) ((length >= 3) && (LowercaseByte(bytes[length-3]) == c1) && HasSuffix2(c2,c3))
+
+		// Same suffix precedence as -referenceByteCountNumber
+		if      (HasSuffix2('t','b'))     { multiplier = 1000000000000; numberLength -= 2; }
+		else if (HasSuffix3('t','i','b')) { multiplier = 1099511627776; numberLength -= 3; }
+		else if (HasSuffix2('g','b'))     { multiplier = 1000000000;    numberLength -= 2; }
+		else if (HasSuffix3('g','i','b')) { multiplier = 1073741824;    numberLength -= 3; }
+		else if (HasSuffix2('m','b'))     { multiplier = 1000000;       numberLength -= 2; }
+		else if (HasSuffix3('m','i','b')) { multiplier = 1048576;       numberLength -= 3; }
+		else if (HasSuffix2('k','b'))     { multiplier = 1000;          numberLength -= 2; }
+		else if (HasSuffix3('k','i','b')) { multiplier = 1024;          numberLength -= 3; }
+		else if (LowercaseByte(bytes[length-1]) == 'b') { multiplier = 1; numberLength -= 1; }
+
+		#undef HasSuffix3
+		#undef HasSuffix2
+		#undef LowercaseByte
+
+		// Equivalent of -integerValue: optional sign, then digits up to the first non-digit
+		if ((numberLength > 0) && ((*byte == '-') || (*byte == '+')))
+		{
+			negative = (*byte == '-');
+			byte++;
+		}
+
+		for (; (byte < (bytes + numberLength)) && (*byte >= '0') && (*byte <= '9'); byte++)
+		{
+			value = (value * 10) + (*byte - '0');
+			digitCount++;
+		}
+
+		if ((numberLength == 0) || ((bytes[0] > ' ') && (bytes[0] <= '~') && (digitCount <= 18)))
+		{
+			return (@(((NSUInteger)(negative ? -value : value)) * multiplier));
+		}
+	}
+
+	return ([self referenceByteCountNumber]);
+}
+
+- (nullable NSNumber *)referenceByteCountNumber
 {
 	NSNumber *byteCountNumber = nil;
 	NSString *lcString = self.lowercaseString, *bcString = nil;
@@ -0,0 +1,39 @@
+//
+//  OCQueryCondition+Continuation.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <ownCloudSDK/ownCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCQueryCondition (Continuation)
+
+@property(readonly,nonatomic) BOOL supportsContinuation; //!< YES if the condition is sorted by a property that allows keyset continuation (name, size, last modified)
+
+/// Returns the condition for the page of results following `pageItems`, the results of `pageCondition` (the receiver or a condition previously returned by this method) - or nil if
+/// there are no further results or the condition doesn't allow keyset continuation. `returnedItems` are all items returned so far, in sort order, ending with `pageItems`.
+///
+/// The returned condition requires the receiver and restricts results to items sorting after the last returned item, so the next page starts where the
+/// previous one ended instead of evaluating all previous pages again. Its size doesn't depend on the number of items returned so far. As items are only sorted
+/// by one property, a run of items sharing the same sort value that doesn't fit into one page is paged through separately, sorted by local ID
+/// (`sortBy == value AND localID > lastLocalID`), before continuing with the items sorting after it (`sortBy > value`). Items tied with the last returned item
+/// may be returned again and need to be skipped by local ID. Page size (maxResultCount) is carried over.
+- (nullable OCQueryCondition *)continuationConditionAfterItems:(NSArray<OCItem *> *)returnedItems page:(NSArray<OCItem *> *)pageItems ofCondition:(OCQueryCondition *)pageCondition;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,117 @@
+//
+//  OCQueryCondition+Continuation.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCQueryCondition+Continuation.h"
+
+@implementation OCQueryCondition (Continuation)
+
+- (BOOL)supportsContinuation
+{
+	OCItemPropertyName sortBy = self.sortBy;
+
+	// Only properties that are set for all items: items with a nil sort value can't be located relative to a boundary value
+	return ([sortBy isEqual:OCItemPropertyNameName] ||
+		[sortBy isEqual:OCItemPropertyNameSize] ||
+		[sortBy isEqual:OCItemPropertyNameLastModified]);
+}
+
+- (BOOL)_isTieRunCondition:(OCQueryCondition *)condition
+{
+	return ((condition != self) && [condition.sortBy isEqual:OCItemPropertyNameLocalID]);
+}
+
+- (OCQueryCondition *)_afterBoundaryCondition:(id)boundaryValue
+{
+	return (self.sortAscending ?
+		[OCQueryCondition where:self.sortBy isGreaterThan:boundaryValue] :
+		[OCQueryCondition where:self.sortBy isLessThan:boundaryValue]);
+}
+
+- (OCQueryCondition *)continuationConditionAfterItems:(NSArray<OCItem *> *)returnedItems page:(NSArray<OCItem *> *)pageItems ofCondition:(OCQueryCondition *)pageCondition
+{
+	OCItemPropertyName sortBy = self.sortBy;
+	OCItem *lastItem = returnedItems.lastObject;
+	id boundaryValue;
+	BOOL isFullPage = (pageItems.count >= self.maxResultCount.unsignedIntegerValue);
+	BOOL continuesTieRun = NO;
+	OCQueryCondition *continuationCondition;
+
+	if (!self.supportsContinuation || (lastItem == nil) || ((boundaryValue = [lastItem valueForKey:sortBy]) == nil))
+	{
+		return (nil);
+	}
+
+	if ([self _isTieRunCondition:pageCondition])
+	{
+		if (isFullPage && (lastItem.localID != nil))
+		{
+			// Next page of the tie run
+			continuationCondition = [OCQueryCondition require:@[
+				self,
+				[OCQueryCondition where:sortBy isEqualTo:boundaryValue],
+				[OCQueryCondition where:OCItemPropertyNameLocalID isGreaterThan:lastItem.localID]
+			]];
+			continuesTieRun = YES;
+		}
+		else
+		{
+			// Tie run complete: continue with the items sorting after it
+			continuationCondition = [OCQueryCondition require:@[
+				self,
+				[self _afterBoundaryCondition:boundaryValue]
+			]];
+		}
+	}
+	else
+	{
+		if (!isFullPage)
+		{
+			return (nil);
+		}
+
+		if ([[pageItems.firstObject valueForKey:sortBy] isEqual:boundaryValue])
+		{
+			// The entire page shares one sort value, so it may hold an arbitrary subset of a longer tie run: page through all of it by local ID
+			continuationCondition = [OCQueryCondition require:@[
+				self,
+				[OCQueryCondition where:sortBy isEqualTo:boundaryValue]
+			]];
+			continuesTieRun = YES;
+		}
+		else
+		{
+			// Include the items tied with the last item, so ties spanning the page boundary aren't skipped. The tied items that have already been
+			// returned show up again and need to be skipped by the caller. If the tie run fills the entire next page, it is paged through by local ID from there.
+			continuationCondition = [OCQueryCondition require:@[
+				self,
+				[OCQueryCondition anyOf:@[
+					[self _afterBoundaryCondition:boundaryValue],
+					[OCQueryCondition where:sortBy isEqualTo:boundaryValue]
+				]]
+			]];
+		}
+	}
+
+	continuationCondition.sortBy = continuesTieRun ? OCItemPropertyNameLocalID : sortBy;
+	continuationCondition.sortAscending = continuesTieRun ? YES : self.sortAscending;
+	continuationCondition.maxResultCount = self.maxResultCount;
+
+	return (continuationCondition);
+}
+
+@end
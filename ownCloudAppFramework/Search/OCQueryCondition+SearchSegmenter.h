@@ -26,12 +26,18 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSArray<OCSearchSegment *> *)segmentedForSearchWithQuotationMarks:(BOOL)withQuotationMarks cursorPosition:(nullable NSNumber *)inCursorPosition;
 - (NSArray<NSString *> *)segmentedForSearchWithQuotationMarks:(BOOL)withQuotationMarks;
 
+@property(readonly,nonatomic) BOOL containsQuotationMark; //!< YES if the string contains any of the quotation marks recognized by the segmenter
+
 @end
 
 @interface OCQueryCondition (SearchSegmenter)
 
 + (nullable instancetype)forSearchSegment:(NSString *)segmentString;
++ (nullable instancetype)cachedForSearchSegment:(NSString *)segmentString; //!< Like +forSearchSegment:, but returns the condition from a shared LRU cache if available. Returned conditions are shared and must not be modified. The cache is flushed when the day changes, so relative dates (f.ex. :today) stay current.
++ (void)flushCachedSearchSegmentConditions;
+
 + (nullable instancetype)fromSearchTerm:(NSString *)searchTerm;
++ (nullable instancetype)cachedFromSearchTerm:(NSString *)searchTerm; //!< Like +fromSearchTerm:, but using +cachedForSearchSegment: for the segments. For search terms consisting of a single segment, the returned condition is shared and must not be modified.
 
 @end
 
@@ -21,11 +21,25 @@
 #import "NSString+ByteCountParser.h"
 #import "OCLicenseManager.h" // needed as localization "anchor"
 
+static NSString *OCSearchSegmenterQuotationMarks = @"“”‘‛‟„‚'\"′″´˝❛❜❝❞";
+
 @implementation NSString (SearchSegmenter)
 
 - (BOOL)isQuotationMark
 {
-	return ([@"“”‘‛‟„‚'\"′″´˝❛❜❝❞" containsString:self]);
+	return ([OCSearchSegmenterQuotationMarks containsString:self]);
+}
+
+- (BOOL)containsQuotationMark
+{
+	static dispatch_once_t onceToken;
+	static NSCharacterSet *quotationMarkCharacterSet;
+
+	dispatch_once(&onceToken, ^{
+		quotationMarkCharacterSet = [NSCharacterSet characterSetWithCharactersInString:OCSearchSegmenterQuotationMarks];
+	});
+
+	return ([self rangeOfCharacterFromSet:quotationMarkCharacterSet].location != NSNotFound);
 }
 
 - (BOOL)hasQuotationMarkSuffix
@@ -580,7 +594,90 @@
 	return (nameCondition);
 }
 
+#pragma mark - Condition cache
+#define OCSearchSegmentConditionCacheCapacity 128
+
+static NSMutableDictionary<NSString *, id> *sConditionsBySegment; // Values are OCQueryCondition or NSNull (for segments without condition)
+static NSMutableArray<NSString *> *sSegmentsByRecentUse; // Least recently used first
+
++ (void)flushCachedSearchSegmentConditions
+{
+	@synchronized(OCQueryCondition.class)
+	{
+		[sConditionsBySegment removeAllObjects];
+		[sSegmentsByRecentUse removeAllObjects];
+	}
+}
+
++ (instancetype)cachedForSearchSegment:(NSString *)segmentString
+{
+	static dispatch_once_t onceToken;
+	id cachedCondition = nil;
+
+	dispatch_once(&onceToken, ^{
+		sConditionsBySegment = [NSMutableDictionary new];
+		sSegmentsByRecentUse = [NSMutableArray new];
+
+		// Conditions for relative dates (f.ex. :today, :7d) are computed relative to the current day
+		[NSNotificationCenter.defaultCenter addObserverForName:NSCalendarDayChangedNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull notification) {
+			[OCQueryCondition flushCachedSearchSegmentConditions];
+		}];
+	});
+
+	if (segmentString == nil)
+	{
+		return (nil);
+	}
+
+	@synchronized(OCQueryCondition.class)
+	{
+		if ((cachedCondition = sConditionsBySegment[segmentString]) != nil)
+		{
+			// Mark as most recently used
+			[sSegmentsByRecentUse removeObject:segmentString];
+			[sSegmentsByRecentUse addObject:segmentString];
+		}
+	}
+
+	if (cachedCondition == nil)
+	{
+		cachedCondition = [self forSearchSegment:segmentString];
+
+		if (cachedCondition == nil)
+		{
+			cachedCondition = NSNull.null;
+		}
+
+		@synchronized(OCQueryCondition.class)
+		{
+			if (sConditionsBySegment[segmentString] == nil)
+			{
+				if (sSegmentsByRecentUse.count >= OCSearchSegmentConditionCacheCapacity)
+				{
+					[sConditionsBySegment removeObjectForKey:sSegmentsByRecentUse.firstObject];
+					[sSegmentsByRecentUse removeObjectAtIndex:0];
+				}
+
+				sConditionsBySegment[segmentString] = cachedCondition;
+				[sSegmentsByRecentUse addObject:segmentString];
+			}
+		}
+	}
+
+	return (OCTypedCast(cachedCondition, OCQueryCondition));
+}
+
 + (instancetype)fromSearchTerm:(NSString *)searchTerm
+{
+	return ([self _fromSearchTerm:searchTerm cached:NO]);
+}
+
++ (instancetype)cachedFromSearchTerm:(NSString *)searchTerm
+{
+	return ([self _fromSearchTerm:searchTerm cached:YES]);
+}
+
++ (instancetype)_fromSearchTerm:(NSString *)searchTerm cached:(BOOL)cached
 {
 	NSArray<NSString *> *segments = [searchTerm segmentedForSearchWithQuotationMarks:YES];
 	NSMutableArray<OCQueryCondition *> *conditions = [NSMutableArray new];
@@ -590,7 +687,7 @@
 	{
 		OCQueryCondition *condition;
 
-		if ((condition = [self forSearchSegment:segment]) != nil)
+		if ((condition = (cached ? [self cachedForSearchSegment:segment] : [self forSearchSegment:segment])) != nil)
 		{
 			[conditions addObject:condition];
 		}
@@ -0,0 +1,42 @@
+//
+//  OCSearchSegmenter.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCSearchSegment.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Incremental variant of -[NSString segmentedForSearchWithQuotationMarks:cursorPosition:] for search fields: remembers the segments of the previous search string
+/// and - after an edit - only re-segments the part of the new string around the edit, reusing the segments before and after it. Returns the same segments as
+/// the full segmentation. Strings containing quotation marks (where an edit can change the segmentation of the entire remainder) are always fully segmented.
+@interface OCSearchSegmenter : NSObject
+
+@property(readonly) BOOL withQuotationMarks;
+
+@property(readonly) NSUInteger fullSegmentationCount; //!< Number of times the entire string was segmented
+@property(readonly) NSUInteger reusedSegmentCount; //!< Number of segments reused from previous segmentations
+
+- (instancetype)initWithQuotationMarks:(BOOL)withQuotationMarks;
+
+- (NSArray<OCSearchSegment *> *)segmentsForString:(nullable NSString *)string cursorPosition:(nullable NSNumber *)cursorPosition;
+
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,196 @@
+//
+//  OCSearchSegmenter.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCSearchSegmenter.h"
+#import "OCQueryCondition+SearchSegmenter.h"
+
+@interface OCSearchSegmenter ()
+{
+	NSString *_string;
+	BOOL _stringContainsQuotationMark;
+	NSArray<OCSearchSegment *> *_segments;
+}
+@end
+
+@implementation OCSearchSegmenter
+
+- (instancetype)initWithQuotationMarks:(BOOL)withQuotationMarks
+{
+	if ((self = [super init]) != nil)
+	{
+		_withQuotationMarks = withQuotationMarks;
+	}
+
+	return (self);
+}
+
+- (void)reset
+{
+	_string = nil;
+	_segments = nil;
+}
+
+#pragma mark - Segmentation
+- (NSArray<OCSearchSegment *> *)segmentsForString:(NSString *)string cursorPosition:(NSNumber *)cursorPosition
+{
+	NSArray<OCSearchSegment *> *segments = nil;
+	BOOL stringContainsQuotationMark;
+
+	if (string.length == 0)
+	{
+		[self reset];
+		return (@[]);
+	}
+
+	stringContainsQuotationMark = string.containsQuotationMark;
+
+	if ((_string != nil) && !_stringContainsQuotationMark && !stringContainsQuotationMark)
+	{
+		// Without quotation marks, every space-separated term is a segment of its own
+		segments = [self _segmentsForEditOf:_string to:string cursorPosition:cursorPosition];
+	}
+
+	if (segments == nil)
+	{
+		segments = [string segmentedForSearchWithQuotationMarks:_withQuotationMarks cursorPosition:cursorPosition];
+		_fullSegmentationCount++;
+	}
+
+	_string = [string copy];
+	_stringContainsQuotationMark = stringContainsQuotationMark;
+	_segments = segments;
+
+	return (segments);
+}
+
+- (NSArray<OCSearchSegment *> *)_segmentsForEditOf:(NSString *)oldString to:(NSString *)newString cursorPosition:(NSNumber *)cursorPosition
+{
+	NSUInteger oldLength = oldString.length, newLength = newString.length;
+	NSUInteger prefixLength = 0, suffixLength = 0, maxSuffixLength;
+	NSUInteger oldEditEnd, newEditEnd, segmentStart, segmentEnd;
+	NSInteger lengthDelta = (NSInteger)newLength - (NSInteger)oldLength;
+	NSMutableArray<OCSearchSegment *> *segments = [NSMutableArray new];
+	NSArray<OCSearchSegment *> *middleSegments = nil;
+	NSUInteger firstSuffixSegmentIndex = _segments.count;
+
+	// Determine edited range
+	while ((prefixLength < oldLength) && (prefixLength < newLength) && ([oldString characterAtIndex:prefixLength] == [newString characterAtIndex:prefixLength]))
+	{
+		prefixLength++;
+	}
+
+	maxSuffixLength = MIN(oldLength, newLength) - prefixLength;
+
+	while ((suffixLength < maxSuffixLength) && ([oldString characterAtIndex:oldLength - suffixLength - 1] == [newString characterAtIndex:newLength - suffixLength - 1]))
+	{
+		suffixLength++;
+	}
+
+	oldEditEnd = oldLength - suffixLength;
+	newEditEnd = newLength - suffixLength;
+
+	// Reuse segments ending before the edit - with at least the separating space in between
+	segmentStart = 0;
+
+	for (OCSearchSegment *segment in _segments)
+	{
+		if (NSMaxRange(segment.range) >= prefixLength)
+		{
+			break;
+		}
+
+		[segments addObject:[self _segment:segment offsetBy:0 cursorPosition:cursorPosition]];
+		segmentStart = NSMaxRange(segment.range) + 1;
+	}
+
+	// Reuse segments starting after the edit
+	while ((firstSuffixSegmentIndex > segments.count) && (_segments[firstSuffixSegmentIndex-1].range.location > oldEditEnd))
+	{
+		firstSuffixSegmentIndex--;
+	}
+
+	segmentEnd = (firstSuffixSegmentIndex < _segments.count) ? (NSUInteger)((NSInteger)_segments[firstSuffixSegmentIndex].range.location + lengthDelta - 1) : newLength;
+
+	// Segment the part in between
+	if (segmentEnd > segmentStart)
+	{
+		NSNumber *middleCursorPosition = nil;
+
+		if ((cursorPosition != nil) && (cursorPosition.unsignedIntegerValue >= segmentStart) && (cursorPosition.unsignedIntegerValue <= segmentEnd))
+		{
+			middleCursorPosition = @(cursorPosition.unsignedIntegerValue - segmentStart);
+		}
+
+		middleSegments = [[newString substringWithRange:NSMakeRange(segmentStart, segmentEnd - segmentStart)] segmentedForSearchWithQuotationMarks:_withQuotationMarks cursorPosition:middleCursorPosition];
+
+		for (OCSearchSegment *segment in middleSegments)
+		{
+			NSRange range = segment.range;
+
+			range.location += segmentStart;
+			segment.range = range;
+
+			[segments addObject:segment];
+		}
+	}
+
+	_reusedSegmentCount += (segments.count - middleSegments.count) + (_segments.count - firstSuffixSegmentIndex);
+
+	for (NSUInteger idx = firstSuffixSegmentIndex; idx < _segments.count; idx++)
+	{
+		[segments addObject:[self _segment:_segments[idx] offsetBy:lengthDelta cursorPosition:cursorPosition]];
+	}
+
+	return (segments);
+}
+
+/// Returns the segment with its range moved by offset and cursor properties updated for the cursor position - or the segment itself if nothing changed
+- (OCSearchSegment *)_segment:(OCSearchSegment *)segment offsetBy:(NSInteger)offset cursorPosition:(NSNumber *)cursorPosition
+{
+	NSRange range = NSMakeRange((NSUInteger)((NSInteger)segment.range.location + offset), segment.range.length);
+	BOOL hasCursor = NO;
+	NSInteger cursorOffset = -1;
+
+	if (cursorPosition != nil)
+	{
+		NSUInteger position = cursorPosition.unsignedIntegerValue;
+
+		if ((position > range.location) && (position <= NSMaxRange(range)))
+		{
+			hasCursor = YES;
+			cursorOffset = position - range.location;
+		}
+	}
+
+	if ((offset == 0) && (hasCursor == segment.hasCursor) && (cursorOffset == segment.cursorOffset))
+	{
+		return (segment);
+	}
+
+	OCSearchSegment *movedSegment = [OCSearchSegment new];
+
+	movedSegment.range = range;
+	movedSegment.hasCursor = hasCursor;
+	movedSegment.cursorOffset = cursorOffset;
+	movedSegment.originalString = segment.originalString;
+	movedSegment.segmentedString = segment.segmentedString;
+
+	return (movedSegment);
+}
+
+@end
@@ -18,17 +18,21 @@
 
 #import <ownCloudSDK/ownCloudSDK.h>
 #import "OCSavedSearch.h"
+#import "OCKeyedCollectionStore.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface OCVault (SavedSearches)
 
 @property(readonly,strong,nullable) NSArray<OCSavedSearch *> *savedSearches;
+@property(readonly,strong) OCKeyedCollectionStore<OCSavedSearch *> *savedSearchesStore; //!< Per-entry storage of the saved searches, providing change sets and batched updates
 
 - (void)addSavedSearch:(OCSavedSearch *)savedSearch;
 - (void)updateSavedSearch:(OCSavedSearch *)savedSearch;
 - (void)deleteSavedSearch:(OCSavedSearch *)savedSearch;
 
+- (void)performSavedSearchBatchUpdates:(void(^)(OCKeyedCollectionStore<OCSavedSearch *> *store))updates; //!< Writes all modifications made through the store inside the block with a single index update
+
 - (void)addSavedSearchesObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void(^)(id owner, NSArray<OCSavedSearch *> * _Nullable savedSearches, BOOL initial))updateHandler;
 
 @end
@@ -18,103 +18,76 @@
 
 #import "OCVault+SavedSearches.h"
 
+#import <objc/runtime.h>
+
+static NSString *sOCVaultSavedSearchesStoreKey = @"sOCVaultSavedSearchesStoreKey";
+
 @implementation OCVault (SavedSearches)
 
 + (void)load
 {
+	// Previous storage of all saved searches as a single array, migrated by the store on first access
 	[OCKeyValueStore registerClasses:[NSSet setWithObjects:NSArray.class, OCSavedSearch.class, nil] forKey:OCKeyValueStoreKeySavedSearches];
 }
 
-- (NSArray<OCSavedSearch *> *)savedSearches
+- (OCKeyedCollectionStore<OCSavedSearch *> *)savedSearchesStore
 {
-	NSMutableArray<OCSavedSearch *> *savedSearches = [self.keyValueStore readObjectForKey:OCKeyValueStoreKeySavedSearches];
+	OCKeyedCollectionStore<OCSavedSearch *> *store;
 
-	return (savedSearches);
-}
-
-- (void)addSavedSearch:(OCSavedSearch *)savedSearch
-{
-	[self willChangeValueForKey:@"savedSearches"];
-
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySavedSearches usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSavedSearch *> *savedSearches = OCTypedCast(existingObject, NSMutableArray);
-		if (savedSearches == nil)
+	@synchronized(sOCVaultSavedSearchesStoreKey)
+	{
+		if ((store = objc_getAssociatedObject(self, (__bridge void *)sOCVaultSavedSearchesStoreKey)) == nil)
 		{
-			savedSearches = [NSMutableArray new];
+			store = [[OCKeyedCollectionStore alloc] initWithKeyValueStore:self.keyValueStore collectionKey:OCKeyValueStoreKeySavedSearches classes:[NSSet setWithObject:OCSavedSearch.class] identifierProvider:^OCKeyedCollectionIdentifier(OCSavedSearch *savedSearch) {
+				return (savedSearch.uuid);
+			}];
+			store.legacyArrayKey = OCKeyValueStoreKeySavedSearches;
+
+			objc_setAssociatedObject(self, (__bridge void *)sOCVaultSavedSearchesStoreKey, store, OBJC_ASSOCIATION_RETAIN);
 		}
+	}
 
-		[savedSearches addObject:savedSearch];
+	return (store);
+}
 
-		*outDidModify = YES;
-		return (savedSearches);
-	}];
+- (NSArray<OCSavedSearch *> *)savedSearches
+{
+	return (self.savedSearchesStore.entries);
+}
 
+- (void)addSavedSearch:(OCSavedSearch *)savedSearch
+{
+	[self willChangeValueForKey:@"savedSearches"];
+	[self.savedSearchesStore addEntry:savedSearch];
 	[self didChangeValueForKey:@"savedSearches"];
 }
 
 - (void)updateSavedSearch:(OCSavedSearch *)savedSearch
 {
 	[self willChangeValueForKey:@"savedSearches"];
-
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySavedSearches usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSavedSearch *> *savedSearches = OCTypedCast(existingObject, NSMutableArray);
-
-		if (savedSearches != nil)
-		{
-			NSUInteger existingOffset = [savedSearches indexOfObjectPassingTest:^BOOL(OCSavedSearch * _Nonnull existingSearch, NSUInteger idx, BOOL * _Nonnull stop) {
-				return ([existingSearch.uuid isEqual:savedSearch.uuid]);
-			}];
-
-			if (existingOffset != NSNotFound)
-			{
-				[savedSearches replaceObjectAtIndex:existingOffset withObject:savedSearch];
-				*outDidModify = YES;
-			}
-		}
-
-		return (savedSearches);
-	}];
-
+	[self.savedSearchesStore updateEntry:savedSearch];
 	[self didChangeValueForKey:@"savedSearches"];
 }
 
 - (void)deleteSavedSearch:(OCSavedSearch *)savedSearch
 {
 	[self willChangeValueForKey:@"savedSearches"];
+	[self.savedSearchesStore removeEntry:savedSearch];
+	[self didChangeValueForKey:@"savedSearches"];
+}
 
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySavedSearches usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSavedSearch *> *savedSearches = OCTypedCast(existingObject, NSMutableArray);
-		NSUInteger countBefore;
-
-		if ((savedSearches != nil) && ((countBefore = savedSearches.count) > 0))
-		{
-			[savedSearches removeObject:savedSearch];
-
-			if (countBefore != savedSearches.count)
-			{
-				*outDidModify = YES;
-			}
-		}
-
-		return (savedSearches);
-	}];
-
+- (void)performSavedSearchBatchUpdates:(void (^)(OCKeyedCollectionStore<OCSavedSearch *> * _Nonnull))updates
+{
+	[self willChangeValueForKey:@"savedSearches"];
+	[self.savedSearchesStore performBatchUpdates:updates];
 	[self didChangeValueForKey:@"savedSearches"];
 }
 
 - (void)addSavedSearchesObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void(^)(id owner, NSArray<OCSavedSearch *> * _Nullable savedSearches, BOOL initial))updateHandler
 {
-	__block BOOL isInitial = initial;
-
-	[self.keyValueStore addObserver:^(OCKeyValueStore * _Nonnull store, id  _Nullable owner, OCKeyValueStoreKey  _Nonnull key, id  _Nullable newValue) {
-		NSMutableArray<OCSavedSearch *> *savedSearches = OCTypedCast(newValue, NSMutableArray);
-		BOOL isInitialCall = isInitial;
-		isInitial = NO;
-
-		dispatch_async(dispatch_get_main_queue(), ^{
-			updateHandler(owner, savedSearches, isInitialCall);
-		});
-	} forKey:OCKeyValueStoreKeySavedSearches withOwner:owner initial:initial];
+	[self.savedSearchesStore addObserver:owner withInitial:initial updateHandler:^(id owner, NSArray<OCSavedSearch *> *savedSearches, OCKeyedCollectionChangeSet * _Nullable changes, BOOL initial) {
+		updateHandler(owner, savedSearches, initial);
+	}];
 }
 
 @end
@@ -18,17 +18,21 @@
 
 #import <ownCloudSDK/ownCloudSDK.h>
 #import "OCSidebarItem.h"
+#import "OCKeyedCollectionStore.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface OCVault (SidebarItems)
 
 @property(readonly,strong,nullable) NSArray<OCSidebarItem *> *sidebarItems;
+@property(readonly,strong) OCKeyedCollectionStore<OCSidebarItem *> *sidebarItemsStore; //!< Per-entry storage of the sidebar items, providing change sets and batched updates
 
 - (void)addSidebarItem:(OCSidebarItem *)sidebarItem;
 - (void)updateSidebarItem:(OCSidebarItem *)sidebarItem;
 - (void)deleteSidebarItem:(OCSidebarItem *)sidebarItem;
 
+- (void)performSidebarItemBatchUpdates:(void(^)(OCKeyedCollectionStore<OCSidebarItem *> *store))updates; //!< Writes all modifications made through the store inside the block with a single index update
+
 - (void)addSidebarItemObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void(^)(id owner, NSArray<OCSidebarItem *> * _Nullable sidebarItems, BOOL initial))updateHandler;
 
 @end
@@ -18,103 +18,76 @@
 
 #import "OCVault+SidebarItems.h"
 
+#import <objc/runtime.h>
+
+static NSString *sOCVaultSidebarItemsStoreKey = @"sOCVaultSidebarItemsStoreKey";
+
 @implementation OCVault (SidebarItems)
 
 + (void)load
 {
+	// Previous storage of all sidebar items as a single array, migrated by the store on first access
 	[OCKeyValueStore registerClasses:[NSSet setWithObjects:NSArray.class, OCSidebarItem.class, nil] forKey:OCKeyValueStoreKeySidebarItems];
 }
 
-- (NSArray<OCSidebarItem *> *)sidebarItems
+- (OCKeyedCollectionStore<OCSidebarItem *> *)sidebarItemsStore
 {
-	NSMutableArray<OCSidebarItem *> *sidebarItems = [self.keyValueStore readObjectForKey:OCKeyValueStoreKeySidebarItems];
+	OCKeyedCollectionStore<OCSidebarItem *> *store;
 
-	return (sidebarItems);
-}
-
-- (void)addSidebarItem:(OCSidebarItem *)sidebarItem
-{
-	[self willChangeValueForKey:@"sidebarItems"];
-
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySidebarItems usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSidebarItem *> *sidebarItems = OCTypedCast(existingObject, NSMutableArray);
-		if (sidebarItems == nil)
+	@synchronized(sOCVaultSidebarItemsStoreKey)
+	{
+		if ((store = objc_getAssociatedObject(self, (__bridge void *)sOCVaultSidebarItemsStoreKey)) == nil)
 		{
-			sidebarItems = [NSMutableArray new];
+			store = [[OCKeyedCollectionStore alloc] initWithKeyValueStore:self.keyValueStore collectionKey:OCKeyValueStoreKeySidebarItems classes:[NSSet setWithObject:OCSidebarItem.class] identifierProvider:^OCKeyedCollectionIdentifier(OCSidebarItem *sidebarItem) {
+				return (sidebarItem.uuid);
+			}];
+			store.legacyArrayKey = OCKeyValueStoreKeySidebarItems;
+
+			objc_setAssociatedObject(self, (__bridge void *)sOCVaultSidebarItemsStoreKey, store, OBJC_ASSOCIATION_RETAIN);
 		}
+	}
 
-		[sidebarItems addObject:sidebarItem];
+	return (store);
+}
 
-		*outDidModify = YES;
-		return (sidebarItems);
-	}];
+- (NSArray<OCSidebarItem *> *)sidebarItems
+{
+	return (self.sidebarItemsStore.entries);
+}
 
+- (void)addSidebarItem:(OCSidebarItem *)sidebarItem
+{
+	[self willChangeValueForKey:@"sidebarItems"];
+	[self.sidebarItemsStore addEntry:sidebarItem];
 	[self didChangeValueForKey:@"sidebarItems"];
 }
 
 - (void)updateSidebarItem:(OCSidebarItem *)sidebarItem
 {
 	[self willChangeValueForKey:@"sidebarItems"];
-
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySidebarItems usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSidebarItem *> *sidebarItems = OCTypedCast(existingObject, NSMutableArray);
-
-		if (sidebarItems != nil)
-		{
-			NSUInteger existingOffset = [sidebarItems indexOfObjectPassingTest:^BOOL(OCSidebarItem * _Nonnull existingSidebarItem, NSUInteger idx, BOOL * _Nonnull stop) {
-				return ([existingSidebarItem.uuid isEqual:sidebarItem.uuid]);
-			}];
-
-			if (existingOffset != NSNotFound)
-			{
-				[sidebarItems replaceObjectAtIndex:existingOffset withObject:sidebarItem];
-				*outDidModify = YES;
-			}
-		}
-
-		return (sidebarItems);
-	}];
-
+	[self.sidebarItemsStore updateEntry:sidebarItem];
 	[self didChangeValueForKey:@"sidebarItems"];
 }
 
 - (void)deleteSidebarItem:(OCSidebarItem *)sidebarItem
 {
 	[self willChangeValueForKey:@"sidebarItems"];
-
-	[self.keyValueStore updateObjectForKey:OCKeyValueStoreKeySidebarItems usingModifier:^id _Nullable(id  _Nullable existingObject, BOOL * _Nonnull outDidModify) {
-		NSMutableArray<OCSidebarItem *> *sidebarItems = OCTypedCast(existingObject, NSMutableArray);
-		NSUInteger countBefore;
-
-		if ((sidebarItems != nil) && ((countBefore = sidebarItems.count) > 0))
-		{
-			[sidebarItems removeObject:sidebarItem];
-
-			if (countBefore != sidebarItems.count)
-			{
-				*outDidModify = YES;
-			}
-		}
-
-		return (sidebarItems);
-	}];
-
+	[self.sidebarItemsStore removeEntry:sidebarItem];
 	[self didChangeValueForKey:@"sidebarItems"];
 }
 
-- (void)addSidebarItemObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void (^)(id _Nonnull, NSArray<OCSidebarItem *> * _Nullable, BOOL))updateHandler
+- (void)performSidebarItemBatchUpdates:(void (^)(OCKeyedCollectionStore<OCSidebarItem *> * _Nonnull))updates
 {
-	__block BOOL isInitial = initial;
-
-	[self.keyValueStore addObserver:^(OCKeyValueStore * _Nonnull store, id  _Nullable owner, OCKeyValueStoreKey  _Nonnull key, id  _Nullable newValue) {
-		NSMutableArray<OCSidebarItem *> *sidebarItems = OCTypedCast(newValue, NSMutableArray);
-		BOOL isInitialCall = isInitial;
-		isInitial = NO;
+	[self willChangeValueForKey:@"sidebarItems"];
+	[self.sidebarItemsStore performBatchUpdates:updates];
+	[self didChangeValueForKey:@"sidebarItems"];
+}
 
-		dispatch_async(dispatch_get_main_queue(), ^{
-			updateHandler(owner, sidebarItems, isInitialCall);
-		});
-	} forKey:OCKeyValueStoreKeySidebarItems withOwner:owner initial:initial];
+- (void)addSidebarItemObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void(^)(id owner, NSArray<OCSidebarItem *> * _Nullable sidebarItems, BOOL initial))updateHandler
+{
+	[self.sidebarItemsStore addObserver:owner withInitial:initial updateHandler:^(id owner, NSArray<OCSidebarItem *> *sidebarItems, OCKeyedCollectionChangeSet * _Nullable changes, BOOL initial) {
+		updateHandler(owner, sidebarItems, initial);
+	}];
 }
 
 @end
@@ -0,0 +1,78 @@
+//
+//  OCKeyedCollectionStore.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <ownCloudSDK/ownCloudSDK.h>
+
+typedef NSString* OCKeyedCollectionIdentifier;
+typedef NSUInteger OCKeyedCollectionRevision;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCKeyedCollectionChangeSet : NSObject <NSSecureCoding>
+
+@property(readonly) OCKeyedCollectionRevision revision; //!< Revision of the collection after the change(s)
+
+@property(strong,readonly) NSSet<OCKeyedCollectionIdentifier> *addedIdentifiers;
+@property(strong,readonly) NSSet<OCKeyedCollectionIdentifier> *updatedIdentifiers;
+@property(strong,readonly) NSSet<OCKeyedCollectionIdentifier> *removedIdentifiers;
+
+@property(readonly,nonatomic) BOOL isEmpty;
+
+@end
+
+/*
+	OCKeyedCollectionStore keeps an ordered collection of objects in an OCKeyValueStore, with one record per entry plus a small index record holding the order of the identifiers, a revision and the most recent change sets.
+
+	- adding, updating or removing an entry only archives and writes that entry and the index, rather than the entire collection
+	- observers only observe the index and receive change sets with the affected identifiers. Changed entries are re-read on demand, all others are served from memory.
+	- changes made inside -performBatchUpdates: are written with a single index update and delivered to observers as a single change set
+*/
+
+@interface OCKeyedCollectionStore<ObjectType> : NSObject
+
+@property(strong,readonly) OCKeyValueStore *keyValueStore;
+@property(strong,readonly) OCKeyValueStoreKey collectionKey;
+
+@property(strong,nullable) OCKeyValueStoreKey legacyArrayKey; //!< Key under which the collection was previously stored as a single array. Its contents are migrated to per-entry records on first access if no index exists yet.
+
+@property(readonly,nonatomic) NSArray<ObjectType> *entries; //!< All entries, in the order they were added
+@property(readonly,nonatomic) OCKeyedCollectionRevision revision;
+
+#pragma mark - Statistics
+@property(readonly) NSUInteger writtenByteCount; //!< Number of bytes of archived entries and index records written by this instance
+@property(readonly) NSUInteger entryReadCount; //!< Number of entry records read and decoded by this instance
+
+- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore collectionKey:(OCKeyValueStoreKey)collectionKey classes:(NSSet<Class> *)classes identifierProvider:(OCKeyedCollectionIdentifier(^)(ObjectType entry))identifierProvider;
+
+#pragma mark - Access
+- (nullable ObjectType)entryForIdentifier:(OCKeyedCollectionIdentifier)identifier;
+
+#pragma mark - Modification
+- (void)addEntry:(ObjectType)entry; //!< Adds the entry to the end of the collection. Replaces the entry if one with the same identifier already exists.
+- (void)updateEntry:(ObjectType)entry; //!< Replaces the entry with the same identifier. Does nothing if no such entry exists.
+- (void)removeEntry:(ObjectType)entry;
+
+- (void)performBatchUpdates:(void(^)(OCKeyedCollectionStore<ObjectType> *store))updates; //!< Collects all modifications made inside the block and writes them with a single index update.
+
+#pragma mark - Observation
+- (void)addObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void(^)(id owner, NSArray<ObjectType> *entries, OCKeyedCollectionChangeSet * _Nullable changes, BOOL initial))updateHandler; //!< The update handler is called on the main thread. changes is nil for initial calls and when the changes could not be determined - in which case any entry may have changed.
+
+@end
+
+NS_ASSUME_NONNULL_END
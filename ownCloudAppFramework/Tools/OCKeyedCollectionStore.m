@@ -0,0 +1,716 @@
+//
+//  OCKeyedCollectionStore.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCKeyedCollectionStore.h"
+
+#define OCKeyedCollectionMaximumRecentChangeSets 16
+
+#pragma mark - Change set
+@interface OCKeyedCollectionChangeSet ()
+
+- (instancetype)initWithRevision:(OCKeyedCollectionRevision)revision added:(NSSet<OCKeyedCollectionIdentifier> *)addedIdentifiers updated:(NSSet<OCKeyedCollectionIdentifier> *)updatedIdentifiers removed:(NSSet<OCKeyedCollectionIdentifier> *)removedIdentifiers;
+
+@property(readonly,nonatomic) NSSet<OCKeyedCollectionIdentifier> *affectedIdentifiers;
+
++ (OCKeyedCollectionChangeSet *)changeSetByMerging:(NSArray<OCKeyedCollectionChangeSet *> *)changeSets;
+
+@end
+
+@implementation OCKeyedCollectionChangeSet
+
+- (instancetype)initWithRevision:(OCKeyedCollectionRevision)revision added:(NSSet<OCKeyedCollectionIdentifier> *)addedIdentifiers updated:(NSSet<OCKeyedCollectionIdentifier> *)updatedIdentifiers removed:(NSSet<OCKeyedCollectionIdentifier> *)removedIdentifiers
+{
+	if ((self = [super init]) != nil)
+	{
+		_revision = revision;
+		_addedIdentifiers = addedIdentifiers;
+		_updatedIdentifiers = updatedIdentifiers;
+		_removedIdentifiers = removedIdentifiers;
+	}
+
+	return (self);
+}
+
+- (BOOL)isEmpty
+{
+	return ((_addedIdentifiers.count == 0) && (_updatedIdentifiers.count == 0) && (_removedIdentifiers.count == 0));
+}
+
+- (NSSet<OCKeyedCollectionIdentifier> *)affectedIdentifiers
+{
+	NSMutableSet<OCKeyedCollectionIdentifier> *affectedIdentifiers = [[NSMutableSet alloc] initWithSet:_addedIdentifiers];
+
+	[affectedIdentifiers unionSet:_updatedIdentifiers];
+	[affectedIdentifiers unionSet:_removedIdentifiers];
+
+	return (affectedIdentifiers);
+}
+
++ (OCKeyedCollectionChangeSet *)changeSetByMerging:(NSArray<OCKeyedCollectionChangeSet *> *)changeSets
+{
+	NSMutableSet<OCKeyedCollectionIdentifier> *added = [NSMutableSet new];
+	NSMutableSet<OCKeyedCollectionIdentifier> *updated = [NSMutableSet new];
+	NSMutableSet<OCKeyedCollectionIdentifier> *removed = [NSMutableSet new];
+
+	for (OCKeyedCollectionChangeSet *changeSet in changeSets)
+	{
+		for (OCKeyedCollectionIdentifier identifier in changeSet.addedIdentifiers)
+		{
+			if ([removed containsObject:identifier])
+			{
+				// Removed, then added again
+				[removed removeObject:identifier];
+				[updated addObject:identifier];
+			}
+			else
+			{
+				[added addObject:identifier];
+			}
+		}
+
+		for (OCKeyedCollectionIdentifier identifier in changeSet.updatedIdentifiers)
+		{
+			if (![added containsObject:identifier])
+			{
+				[updated addObject:identifier];
+			}
+		}
+
+		for (OCKeyedCollectionIdentifier identifier in changeSet.removedIdentifiers)
+		{
+			[updated removeObject:identifier];
+
+			if ([added containsObject:identifier])
+			{
+				// Added, then removed again
+				[added removeObject:identifier];
+			}
+			else
+			{
+				[removed addObject:identifier];
+			}
+		}
+	}
+
+	return ([[OCKeyedCollectionChangeSet alloc] initWithRevision:changeSets.lastObject.revision added:added updated:updated removed:removed]);
+}
+
++ (BOOL)supportsSecureCoding
+{
+	return (YES);
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	[coder encodeInteger:(NSInteger)_revision forKey:@"revision"];
+	[coder encodeObject:_addedIdentifiers forKey:@"added"];
+	[coder encodeObject:_updatedIdentifiers forKey:@"updated"];
+	[coder encodeObject:_removedIdentifiers forKey:@"removed"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+	NSSet<Class> *identifierSetClasses = [NSSet setWithObjects:NSSet.class, NSString.class, nil];
+
+	if ((self = [super init]) != nil)
+	{
+		_revision = (OCKeyedCollectionRevision)[decoder decodeIntegerForKey:@"revision"];
+		_addedIdentifiers = [decoder decodeObjectOfClasses:identifierSetClasses forKey:@"added"] ?: [NSSet new];
+		_updatedIdentifiers = [decoder decodeObjectOfClasses:identifierSetClasses forKey:@"updated"] ?: [NSSet new];
+		_removedIdentifiers = [decoder decodeObjectOfClasses:identifierSetClasses forKey:@"removed"] ?: [NSSet new];
+	}
+
+	return (self);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, revision: %lu, added: %@, updated: %@, removed: %@>", NSStringFromClass(self.class), self, (unsigned long)_revision, _addedIdentifiers.allObjects, _updatedIdentifiers.allObjects, _removedIdentifiers.allObjects]);
+}
+
+@end
+
+#pragma mark - Index
+@interface OCKeyedCollectionIndex : NSObject <NSSecureCoding>
+
+@property(assign) OCKeyedCollectionRevision revision;
+@property(strong) NSArray<OCKeyedCollectionIdentifier> *identifiers;
+@property(strong) NSArray<OCKeyedCollectionChangeSet *> *recentChangeSets; //!< The most recent change sets, oldest first
+
+@end
+
+@implementation OCKeyedCollectionIndex
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_identifiers = @[];
+		_recentChangeSets = @[];
+	}
+
+	return (self);
+}
+
+- (nullable OCKeyedCollectionChangeSet *)changesSinceRevision:(OCKeyedCollectionRevision)revision
+{
+	NSMutableArray<OCKeyedCollectionChangeSet *> *changeSets = [NSMutableArray new];
+
+	if (revision == _revision)
+	{
+		return ([[OCKeyedCollectionChangeSet alloc] initWithRevision:_revision added:[NSSet new] updated:[NSSet new] removed:[NSSet new]]);
+	}
+
+	for (OCKeyedCollectionChangeSet *changeSet in _recentChangeSets)
+	{
+		if (changeSet.revision > revision)
+		{
+			[changeSets addObject:changeSet];
+		}
+	}
+
+	if ((revision > _revision) || (changeSets.count != (_revision - revision)))
+	{
+		// Changes no longer (or never) covered by the recent change sets
+		return (nil);
+	}
+
+	return ([OCKeyedCollectionChangeSet changeSetByMerging:changeSets]);
+}
+
++ (BOOL)supportsSecureCoding
+{
+	return (YES);
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	[coder encodeInteger:(NSInteger)_revision forKey:@"revision"];
+	[coder encodeObject:_identifiers forKey:@"identifiers"];
+	[coder encodeObject:_recentChangeSets forKey:@"recentChangeSets"];
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+	if ((self = [self init]) != nil)
+	{
+		_revision = (OCKeyedCollectionRevision)[decoder decodeIntegerForKey:@"revision"];
+		_identifiers = [decoder decodeObjectOfClasses:[NSSet setWithObjects:NSArray.class, NSString.class, nil] forKey:@"identifiers"] ?: @[];
+		_recentChangeSets = [decoder decodeObjectOfClasses:[NSSet setWithObjects:NSArray.class, OCKeyedCollectionChangeSet.class, nil] forKey:@"recentChangeSets"] ?: @[];
+	}
+
+	return (self);
+}
+
+@end
+
+#pragma mark - Operations
+typedef NS_ENUM(NSUInteger, OCKeyedCollectionOperationType)
+{
+	OCKeyedCollectionOperationTypeAdd,
+	OCKeyedCollectionOperationTypeUpdate,
+	OCKeyedCollectionOperationTypeRemove
+};
+
+@interface OCKeyedCollectionOperation : NSObject
+
+@property(assign) OCKeyedCollectionOperationType type;
+@property(strong) OCKeyedCollectionIdentifier identifier;
+@property(strong,nullable) id entry;
+
+@end
+
+@implementation OCKeyedCollectionOperation
+@end
+
+#pragma mark - Store
+@interface OCKeyedCollectionStore ()
+{
+	NSSet<Class> *_classes;
+	OCKeyedCollectionIdentifier(^_identifierProvider)(id entry);
+
+	OCKeyValueStoreKey _indexKey;
+	NSMutableSet<OCKeyValueStoreKey> *_registeredKeys;
+
+	BOOL _checkedLegacyArray;
+	NSMutableArray<OCKeyedCollectionOperation *> *_batchOperations;
+
+	NSMutableDictionary<OCKeyedCollectionIdentifier, id> *_cachedEntries;
+	OCKeyedCollectionRevision _cachedRevision;
+}
+
+@end
+
+@implementation OCKeyedCollectionStore
+
+- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore collectionKey:(OCKeyValueStoreKey)collectionKey classes:(NSSet<Class> *)classes identifierProvider:(OCKeyedCollectionIdentifier(^)(id entry))identifierProvider
+{
+	if ((self = [super init]) != nil)
+	{
+		_keyValueStore = keyValueStore;
+		_collectionKey = collectionKey;
+		_classes = classes;
+		_identifierProvider = [identifierProvider copy];
+
+		_indexKey = [collectionKey stringByAppendingString:@".index"];
+		_registeredKeys = [NSMutableSet new];
+
+		_cachedEntries = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+#pragma mark - Keys and archiving
+- (OCKeyValueStoreKey)_registeredKey:(OCKeyValueStoreKey)key
+{
+	@synchronized(_registeredKeys)
+	{
+		if (![_registeredKeys containsObject:key])
+		{
+			[OCKeyValueStore registerClasses:[NSSet setWithObject:NSData.class] forKey:key];
+			[_registeredKeys addObject:key];
+		}
+	}
+
+	return (key);
+}
+
+- (OCKeyValueStoreKey)_indexKey
+{
+	return ([self _registeredKey:_indexKey]);
+}
+
+- (OCKeyValueStoreKey)_entryKeyForIdentifier:(OCKeyedCollectionIdentifier)identifier
+{
+	return ([self _registeredKey:[NSString stringWithFormat:@"%@.entry.%@", _collectionKey, identifier]]);
+}
+
+- (nullable NSData *)_archive:(id)object
+{
+	NSError *error = nil;
+	NSData *data;
+
+	if ((data = [NSKeyedArchiver archivedDataWithRootObject:object requiringSecureCoding:YES error:&error]) == nil)
+	{
+		OCLogError(@"Error archiving %@ for %@: %@", object, _collectionKey, error);
+	}
+
+	return (data);
+}
+
+- (nullable OCKeyedCollectionIndex *)_decodeIndex:(nullable NSData *)indexData
+{
+	if (indexData == nil)
+	{
+		return (nil);
+	}
+
+	return (OCTypedCast([NSKeyedUnarchiver unarchivedObjectOfClasses:[NSSet setWithObjects:OCKeyedCollectionIndex.class, OCKeyedCollectionChangeSet.class, NSArray.class, NSSet.class, NSString.class, nil] fromData:indexData error:NULL], OCKeyedCollectionIndex));
+}
+
+#pragma mark - Index
+- (OCKeyedCollectionIndex *)_readIndex
+{
+	NSData *indexData = OCTypedCast([_keyValueStore readObjectForKey:self._indexKey], NSData);
+
+	if ((indexData == nil) && (_legacyArrayKey != nil))
+	{
+		BOOL migrate = NO;
+
+		@synchronized(self)
+		{
+			migrate = !_checkedLegacyArray;
+			_checkedLegacyArray = YES;
+		}
+
+		if (migrate)
+		{
+			[self _migrateLegacyArray];
+			indexData = OCTypedCast([_keyValueStore readObjectForKey:self._indexKey], NSData);
+		}
+	}
+
+	return ([self _decodeIndex:indexData] ?: [OCKeyedCollectionIndex new]);
+}
+
+- (void)_migrateLegacyArray
+{
+	NSArray *legacyEntries;
+
+	if ((legacyEntries = OCTypedCast([_keyValueStore readObjectForKey:_legacyArrayKey], NSArray)) != nil)
+	{
+		[self performBatchUpdates:^(OCKeyedCollectionStore *store) {
+			for (id entry in legacyEntries)
+			{
+				[store addEntry:entry];
+			}
+		}];
+
+		[_keyValueStore storeObject:nil forKey:_legacyArrayKey];
+
+		OCLogDebug(@"Migrated %lu entries from %@ to per-entry records", (unsigned long)legacyEntries.count, _legacyArrayKey);
+	}
+}
+
+- (OCKeyedCollectionRevision)revision
+{
+	return ([self _readIndex].revision);
+}
+
+#pragma mark - Access
+- (NSArray *)entries
+{
+	return ([self _entriesForIndex:[self _readIndex]]);
+}
+
+- (NSArray *)_entriesForIndex:(OCKeyedCollectionIndex *)index
+{
+	NSMutableArray *entries = [[NSMutableArray alloc] initWithCapacity:index.identifiers.count];
+
+	@synchronized(_cachedEntries)
+	{
+		if (index.revision != _cachedRevision)
+		{
+			OCKeyedCollectionChangeSet *changes;
+
+			// Drop entries that changed since the cache was last brought up to date
+			if ((changes = [index changesSinceRevision:_cachedRevision]) != nil)
+			{
+				[_cachedEntries removeObjectsForKeys:changes.affectedIdentifiers.allObjects];
+			}
+			else
+			{
+				[_cachedEntries removeAllObjects];
+			}
+
+			_cachedRevision = index.revision;
+		}
+
+		for (OCKeyedCollectionIdentifier identifier in index.identifiers)
+		{
+			id entry;
+
+			if ((entry = _cachedEntries[identifier]) == nil)
+			{
+				if ((entry = [self _readEntryForIdentifier:identifier]) != nil)
+				{
+					_cachedEntries[identifier] = entry;
+				}
+			}
+
+			if (entry != nil)
+			{
+				[entries addObject:entry];
+			}
+		}
+	}
+
+	return (entries);
+}
+
+- (nullable id)_readEntryForIdentifier:(OCKeyedCollectionIdentifier)identifier
+{
+	NSData *entryData;
+	id entry = nil;
+
+	if ((entryData = OCTypedCast([_keyValueStore readObjectForKey:[self _entryKeyForIdentifier:identifier]], NSData)) != nil)
+	{
+		NSError *error = nil;
+
+		if ((entry = [NSKeyedUnarchiver unarchivedObjectOfClasses:_classes fromData:entryData error:&error]) == nil)
+		{
+			OCLogError(@"Error decoding entry %@ of %@: %@", identifier, _collectionKey, error);
+		}
+
+		_entryReadCount++;
+	}
+
+	return (entry);
+}
+
+- (nullable id)entryForIdentifier:(OCKeyedCollectionIdentifier)identifier
+{
+	OCKeyedCollectionIndex *index = [self _readIndex];
+
+	if ([index.identifiers containsObject:identifier])
+	{
+		@synchronized(_cachedEntries)
+		{
+			if (index.revision == _cachedRevision)
+			{
+				id entry;
+
+				if ((entry = _cachedEntries[identifier]) == nil)
+				{
+					if ((entry = [self _readEntryForIdentifier:identifier]) != nil)
+					{
+						_cachedEntries[identifier] = entry;
+					}
+				}
+
+				return (entry);
+			}
+		}
+
+		return ([self _readEntryForIdentifier:identifier]);
+	}
+
+	return (nil);
+}
+
+#pragma mark - Modification
+- (void)addEntry:(id)entry
+{
+	[self _performOperation:OCKeyedCollectionOperationTypeAdd entry:entry];
+}
+
+- (void)updateEntry:(id)entry
+{
+	[self _performOperation:OCKeyedCollectionOperationTypeUpdate entry:entry];
+}
+
+- (void)removeEntry:(id)entry
+{
+	[self _performOperation:OCKeyedCollectionOperationTypeRemove entry:entry];
+}
+
+- (void)_performOperation:(OCKeyedCollectionOperationType)type entry:(id)entry
+{
+	OCKeyedCollectionOperation *operation = [OCKeyedCollectionOperation new];
+
+	operation.type = type;
+	operation.identifier = _identifierProvider(entry);
+	operation.entry = (type != OCKeyedCollectionOperationTypeRemove) ? entry : nil;
+
+	@synchronized(self)
+	{
+		if (_batchOperations != nil)
+		{
+			[_batchOperations addObject:operation];
+		}
+		else
+		{
+			[self _commitOperations:@[ operation ]];
+		}
+	}
+}
+
+- (void)performBatchUpdates:(void (^)(OCKeyedCollectionStore * _Nonnull))updates
+{
+	@synchronized(self)
+	{
+		BOOL isOutermostBatch = (_batchOperations == nil);
+
+		if (isOutermostBatch)
+		{
+			_batchOperations = [NSMutableArray new];
+		}
+
+		updates(self);
+
+		if (isOutermostBatch)
+		{
+			NSArray<OCKeyedCollectionOperation *> *operations = _batchOperations;
+
+			_batchOperations = nil;
+
+			if (operations.count > 0)
+			{
+				[self _commitOperations:operations];
+			}
+		}
+	}
+}
+
+- (void)_commitOperations:(NSArray<OCKeyedCollectionOperation *> *)operations
+{
+	NSMutableDictionary<OCKeyedCollectionIdentifier, id> *writtenEntries = [NSMutableDictionary new];
+	__block NSArray<OCKeyedCollectionIdentifier> *finalIdentifiers = nil;
+	__block NSUInteger writtenByteCount = 0;
+
+	// Write the final state of all added and updated entries before the index references them
+	for (OCKeyedCollectionOperation *operation in operations)
+	{
+		if (operation.entry != nil)
+		{
+			writtenEntries[operation.identifier] = operation.entry;
+		}
+		else
+		{
+			[writtenEntries removeObjectForKey:operation.identifier];
+		}
+	}
+
+	[writtenEntries enumerateKeysAndObjectsUsingBlock:^(OCKeyedCollectionIdentifier identifier, id entry, BOOL *stop) {
+		NSData *entryData;
+
+		if ((entryData = [self _archive:entry]) != nil)
+		{
+			[self->_keyValueStore storeObject:entryData forKey:[self _entryKeyForIdentifier:identifier]];
+			writtenByteCount += entryData.length;
+		}
+	}];
+
+	// Apply the operations to the latest version of the index
+	[_keyValueStore updateObjectForKey:self._indexKey usingModifier:^id _Nullable(id _Nullable existingObject, BOOL * _Nonnull outDidModify) {
+		OCKeyedCollectionIndex *index = [self _decodeIndex:OCTypedCast(existingObject, NSData)] ?: [OCKeyedCollectionIndex new];
+		NSMutableArray<OCKeyedCollectionIdentifier> *identifiers = [index.identifiers mutableCopy];
+		NSMutableArray<OCKeyedCollectionChangeSet *> *operationChangeSets = [NSMutableArray new];
+		OCKeyedCollectionChangeSet *changeSet;
+		NSData *indexData;
+
+		for (OCKeyedCollectionOperation *operation in operations)
+		{
+			NSSet<OCKeyedCollectionIdentifier> *identifierSet = [NSSet setWithObject:operation.identifier];
+			NSSet<OCKeyedCollectionIdentifier> *emptySet = [NSSet new];
+			BOOL exists = [identifiers containsObject:operation.identifier];
+
+			switch (operation.type)
+			{
+				case OCKeyedCollectionOperationTypeAdd:
+					if (!exists)
+					{
+						[identifiers addObject:operation.identifier];
+						[operationChangeSets addObject:[[OCKeyedCollectionChangeSet alloc] initWithRevision:0 added:identifierSet updated:emptySet removed:emptySet]];
+						break;
+					}
+				// Adding an existing entry replaces it
+
+				case OCKeyedCollectionOperationTypeUpdate:
+					if (exists)
+					{
+						[operationChangeSets addObject:[[OCKeyedCollectionChangeSet alloc] initWithRevision:0 added:emptySet updated:identifierSet removed:emptySet]];
+					}
+				break;
+
+				case OCKeyedCollectionOperationTypeRemove:
+					if (exists)
+					{
+						[identifiers removeObject:operation.identifier];
+						[operationChangeSets addObject:[[OCKeyedCollectionChangeSet alloc] initWithRevision:0 added:emptySet updated:emptySet removed:identifierSet]];
+					}
+				break;
+			}
+		}
+
+		finalIdentifiers = identifiers;
+
+		if ((changeSet = [OCKeyedCollectionChangeSet changeSetByMerging:operationChangeSets]).isEmpty)
+		{
+			return (existingObject);
+		}
+
+		changeSet = [[OCKeyedCollectionChangeSet alloc] initWithRevision:index.revision+1 added:changeSet.addedIdentifiers updated:changeSet.updatedIdentifiers removed:changeSet.removedIdentifiers];
+
+		NSMutableArray<OCKeyedCollectionChangeSet *> *recentChangeSets = [index.recentChangeSets mutableCopy];
+		[recentChangeSets addObject:changeSet];
+
+		if (recentChangeSets.count > OCKeyedCollectionMaximumRecentChangeSets)
+		{
+			[recentChangeSets removeObjectsInRange:NSMakeRange(0, recentChangeSets.count - OCKeyedCollectionMaximumRecentChangeSets)];
+		}
+
+		index.revision = changeSet.revision;
+		index.identifiers = identifiers;
+		index.recentChangeSets = recentChangeSets;
+
+		if ((indexData = [self _archive:index]) == nil)
+		{
+			return (existingObject);
+		}
+
+		writtenByteCount += indexData.length;
+
+		*outDidModify = YES;
+		return (indexData);
+	}];
+
+	// Remove records of removed entries - and of updated entries that turned out not to exist
+	NSMutableSet<OCKeyedCollectionIdentifier> *obsoleteIdentifiers = [NSMutableSet new];
+
+	for (OCKeyedCollectionOperation *operation in operations)
+	{
+		[obsoleteIdentifiers addObject:operation.identifier];
+	}
+
+	if (finalIdentifiers != nil)
+	{
+		[obsoleteIdentifiers minusSet:[NSSet setWithArray:finalIdentifiers]];
+	}
+
+	for (OCKeyedCollectionIdentifier identifier in obsoleteIdentifiers)
+	{
+		[_keyValueStore storeObject:nil forKey:[self _entryKeyForIdentifier:identifier]];
+	}
+
+	// Entries are re-read on next access, rather than cached as passed in, so that later mutations of the passed objects aren't visible before they're stored
+	@synchronized(_cachedEntries)
+	{
+		for (OCKeyedCollectionOperation *operation in operations)
+		{
+			[_cachedEntries removeObjectForKey:operation.identifier];
+		}
+	}
+
+	_writtenByteCount += writtenByteCount;
+}
+
+#pragma mark - Observation
+- (void)addObserver:(id)owner withInitial:(BOOL)initial updateHandler:(void (^)(id _Nonnull, NSArray * _Nonnull, OCKeyedCollectionChangeSet * _Nullable, BOOL))updateHandler
+{
+	__weak OCKeyedCollectionStore *weakSelf = self;
+	__block OCKeyedCollectionRevision lastRevision = self.revision;
+	__block BOOL isInitial = initial;
+
+	[_keyValueStore addObserver:^(OCKeyValueStore * _Nonnull store, id  _Nullable owner, OCKeyValueStoreKey  _Nonnull key, id  _Nullable newValue) {
+		OCKeyedCollectionStore *strongSelf;
+		OCKeyedCollectionIndex *index;
+		OCKeyedCollectionChangeSet *changes = nil;
+		BOOL isInitialCall = isInitial;
+
+		if ((strongSelf = weakSelf) == nil)
+		{
+			return;
+		}
+
+		index = [strongSelf _decodeIndex:OCTypedCast(newValue, NSData)] ?: [OCKeyedCollectionIndex new];
+		isInitial = NO;
+
+		if (!isInitialCall)
+		{
+			if (index.revision == lastRevision)
+			{
+				// No change
+				return;
+			}
+
+			changes = [index changesSinceRevision:lastRevision];
+		}
+
+		lastRevision = index.revision;
+
+		NSArray *entries = [strongSelf _entriesForIndex:index];
+
+		dispatch_async(dispatch_get_main_queue(), ^{
+			updateHandler(owner, entries, changes, isInitialCall);
+		});
+	} forKey:self._indexKey withOwner:owner initial:initial];
+}
+
+@end
@@ -18,6 +18,7 @@
 
 #import "OCImage+ViewProvider.h"
 #import "OCCircularImageView.h"
+#import "OCSVGPathCache.h"
 
 #import <PocketSVG.h>
 
@@ -30,26 +31,39 @@
 
 	if (isSVGImage && (self.data != nil))
 	{
-		NSString *svgString;
+		OCSVGPathCache *svgCache = OCSVGPathCache.sharedCache;
 		NSArray<SVGBezierPath *> *svgPaths;
+		UIImage *svgImage;
 
-		if ((svgString = [[NSString alloc] initWithData:self.data encoding:NSUTF8StringEncoding]) != nil)
+		if ([svgCache shouldPrerasterizeForSize:size] && ((svgImage = [svgCache imageForSVGData:self.data size:size scale:0]) != nil))
 		{
-			if ((svgPaths = [SVGBezierPath pathsFromSVGString:svgString]) != nil)
-			{
-				// Success
-				dispatch_async(dispatch_get_main_queue(), ^{
-					SVGImageView *imageView = [SVGImageView new];
+			// Success (pre-rasterized)
+			dispatch_async(dispatch_get_main_queue(), ^{
+				UIImageView *imageView = [[UIImageView alloc] initWithImage:svgImage];
 
-					imageView.translatesAutoresizingMaskIntoConstraints = NO;
-					imageView.contentMode = UIViewContentModeScaleAspectFit;
-					imageView.paths = svgPaths;
+				imageView.translatesAutoresizingMaskIntoConstraints = NO;
+				imageView.contentMode = UIViewContentModeScaleAspectFit;
 
-					completionHandler(imageView);
-				});
+				completionHandler(imageView);
+			});
+
+			return;
+		}
+
+		if ((svgPaths = [svgCache pathsForSVGData:self.data]) != nil)
+		{
+			// Success
+			dispatch_async(dispatch_get_main_queue(), ^{
+				SVGImageView *imageView = [SVGImageView new];
+
+				imageView.translatesAutoresizingMaskIntoConstraints = NO;
+				imageView.contentMode = UIViewContentModeScaleAspectFit;
+				imageView.paths = svgPaths;
+
+				completionHandler(imageView);
+			});
 
-				return;
-			}
+			return;
 		}
 
 		// Failure
@@ -0,0 +1,42 @@
+//
+//  OCSVGPathCache.h
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <UIKit/UIKit.h>
+
+@class SVGBezierPath;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCSVGPathCache : NSObject
+
+@property(class,readonly,nonatomic,strong) OCSVGPathCache *sharedCache;
+
+@property(strong,nullable) NSArray<NSValue *> *prerasterizationSizes; //!< Sizes (as CGSize) at which SVG images are provided as pre-rasterized bitmaps rather than as vector paths - f.ex. the avatar sizes used in list cells. Defaults to nil (no pre-rasterization).
+
+@property(readonly) NSUInteger parseCount; //!< Number of times SVG data was actually parsed
+
+- (nullable NSArray<SVGBezierPath *> *)pathsForSVGData:(NSData *)svgData; //!< Returns the parsed paths for the SVG data, parsing it only if no paths for data with the same hash are cached
+- (nullable UIImage *)imageForSVGData:(NSData *)svgData size:(CGSize)size scale:(CGFloat)scale; //!< Returns the SVG image rasterized (aspect fit) at the given size and scale, rasterizing it only on first use
+
+- (BOOL)shouldPrerasterizeForSize:(CGSize)size; //!< YES if size is one of the prerasterizationSizes
+
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
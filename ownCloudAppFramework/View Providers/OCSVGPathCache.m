@@ -0,0 +1,181 @@
+//
+//  OCSVGPathCache.m
+//  ownCloudApp
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <CommonCrypto/CommonDigest.h>
+#import <PocketSVG.h>
+
+#import "OCSVGPathCache.h"
+
+@interface OCSVGPathCache ()
+{
+	NSCache<NSData *, NSArray<SVGBezierPath *> *> *_pathsByDataHash;
+	NSCache<NSString *, UIImage *> *_imagesByKey;
+}
+@end
+
+@implementation OCSVGPathCache
+
++ (OCSVGPathCache *)sharedCache
+{
+	static dispatch_once_t onceToken;
+	static OCSVGPathCache *sharedCache;
+
+	dispatch_once(&onceToken, ^{
+		sharedCache = [OCSVGPathCache new];
+	});
+
+	return (sharedCache);
+}
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_pathsByDataHash = [NSCache new];
+		_pathsByDataHash.countLimit = 256;
+		_pathsByDataHash.name = @"SVG paths";
+
+		_imagesByKey = [NSCache new];
+		_imagesByKey.totalCostLimit = 16 * 1024 * 1024; // Pixel bytes
+		_imagesByKey.name = @"SVG images";
+
+		// NSCache evicts under memory pressure on its own, but not necessarily everything - drop all entries on memory warnings
+		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(removeAllObjects) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[NSNotificationCenter.defaultCenter removeObserver:self name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+}
+
+#pragma mark - Keys
+- (NSData *)hashForData:(NSData *)data
+{
+	unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+
+	CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+
+	return ([NSData dataWithBytes:digest length:CC_SHA256_DIGEST_LENGTH]);
+}
+
+#pragma mark - Paths
+- (NSArray<SVGBezierPath *> *)pathsForSVGData:(NSData *)svgData
+{
+	return ([self _pathsForSVGData:svgData hash:[self hashForData:svgData]]);
+}
+
+- (NSArray<SVGBezierPath *> *)_pathsForSVGData:(NSData *)svgData hash:(NSData *)dataHash
+{
+	NSArray<SVGBezierPath *> *paths;
+
+	if ((paths = [_pathsByDataHash objectForKey:dataHash]) == nil)
+	{
+		NSString *svgString;
+
+		if ((svgString = [[NSString alloc] initWithData:svgData encoding:NSUTF8StringEncoding]) != nil)
+		{
+			if ((paths = [SVGBezierPath pathsFromSVGString:svgString]) != nil)
+			{
+				[_pathsByDataHash setObject:paths forKey:dataHash];
+			}
+
+			@synchronized(self)
+			{
+				_parseCount++;
+			}
+		}
+	}
+
+	return (paths);
+}
+
+#pragma mark - Pre-rasterized images
+- (BOOL)shouldPrerasterizeForSize:(CGSize)size
+{
+	for (NSValue *sizeValue in self.prerasterizationSizes)
+	{
+		if (CGSizeEqualToSize(sizeValue.CGSizeValue, size))
+		{
+			return (YES);
+		}
+	}
+
+	return (NO);
+}
+
+- (UIImage *)imageForSVGData:(NSData *)svgData size:(CGSize)size scale:(CGFloat)scale
+{
+	NSData *dataHash = [self hashForData:svgData];
+	NSString *imageKey;
+	UIImage *image;
+
+	if ((size.width <= 0) || (size.height <= 0))
+	{
+		return (nil);
+	}
+
+	if (scale <= 0)
+	{
+		scale = UIScreen.mainScreen.scale;
+	}
+
+	imageKey = [NSString stringWithFormat:@"%@:%.1fx%.1f@%.1f", [dataHash base64EncodedStringWithOptions:0], size.width, size.height, scale];
+
+	if ((image = [_imagesByKey objectForKey:imageKey]) == nil)
+	{
+		NSArray<SVGBezierPath *> *paths;
+
+		if ((paths = [self _pathsForSVGData:svgData hash:dataHash]) != nil)
+		{
+			UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+			SVGLayer *svgLayer = [SVGLayer new];
+
+			format.scale = scale;
+			format.opaque = NO;
+
+			// Render via SVGLayer, so the result looks like the SVGImageView that would otherwise be used
+			svgLayer.paths = paths;
+			svgLayer.contentsGravity = kCAGravityResizeAspect;
+			svgLayer.frame = CGRectMake(0, 0, size.width, size.height);
+			[svgLayer layoutIfNeeded];
+
+			image = [[[UIGraphicsImageRenderer alloc] initWithSize:size format:format] imageWithActions:^(UIGraphicsImageRendererContext * _Nonnull rendererContext) {
+				[svgLayer renderInContext:rendererContext.CGContext];
+			}];
+
+			if (image != nil)
+			{
+				[_imagesByKey setObject:image forKey:imageKey cost:(NSUInteger)(size.width * scale * size.height * scale * 4)];
+			}
+		}
+	}
+
+	return (image);
+}
+
+#pragma mark - Eviction
+- (void)removeAllObjects
+{
+	[_pathsByDataHash removeAllObjects];
+	[_imagesByKey removeAllObjects];
+}
+
+@end
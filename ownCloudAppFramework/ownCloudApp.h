@@ -28,13 +28,17 @@ FOUNDATION_EXPORT const unsigned char ownCloudAppVersionString[];
 // In this header, you should import all the public headers of your framework using statements like #import <ownCloudApp/PublicHeader.h>
 #import <ownCloudApp/DisplaySettings.h>
 #import <ownCloudApp/NSData+Encoding.h>
+#import <ownCloudApp/OCKeyedCollectionStore.h>
 #import <ownCloudApp/OCCore+BundleImport.h>
 #import <ownCloudApp/OCBookmark+AppExtensions.h>
 #import <ownCloudApp/OCSearchSegment.h>
+#import <ownCloudApp/OCSearchSegmenter.h>
 #import <ownCloudApp/OCQueryCondition+SearchSegmenter.h>
+#import <ownCloudApp/OCQueryCondition+Continuation.h>
 #import <ownCloudApp/NSObject+AnnotatedProperties.h>
 #import <ownCloudApp/NSDate+RFC3339.h>
 #import <ownCloudApp/NSDate+ComputedTimes.h>
+#import <ownCloudApp/NSString+ByteCountParser.h>
 
 #import <ownCloudApp/UIViewController+HostBundleID.h>
 
@@ -45,6 +49,8 @@ FOUNDATION_EXPORT const unsigned char ownCloudAppVersionString[];
 #import <ownCloudApp/OCFileProviderServiceSession.h>
 #import <ownCloudApp/OCFileProviderServiceStandby.h>
 #import <ownCloudApp/OCFileProviderSettings.h>
+#import <ownCloudApp/OCFileProviderWorkingSet.h>
+#import <ownCloudApp/OCFileProviderProvisioningPolicy.h>
 
 #import <ownCloudApp/OCLicenseTypes.h>
 #import <ownCloudApp/OCLicenseManager.h>
@@ -80,9 +86,11 @@ FOUNDATION_EXPORT const unsigned char ownCloudAppVersionString[];
 #import <ownCloudApp/Branding.h>
 #import <ownCloudApp/OCThemeValues.h>
 #import <ownCloudApp/AppLockSettings.h>
+#import <ownCloudApp/AppLockState.h>
 
 #import <ownCloudApp/OCViewHost.h>
 #import <ownCloudApp/OCImage+ViewProvider.h>
+#import <ownCloudApp/OCSVGPathCache.h>
 #import <ownCloudApp/OCResourceTextPlaceholder+ViewProvider.h>
 #import <ownCloudApp/OCCircularContentView.h>
 #import <ownCloudApp/OCCircularImageView.h>
@@ -97,5 +105,6 @@ FOUNDATION_EXPORT const unsigned char ownCloudAppVersionString[];
 #import <ownCloudApp/OCVault+SidebarItems.h>
 
 #import <ownCloudApp/ConfidentialManager.h>
+#import <ownCloudApp/ConfidentialSettingsSnapshot.h>
 
 #import <ownCloudApp/NSURL+OCVaultTools.h>
@@ -0,0 +1,113 @@
+//
+//  AppLockStateTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface AppLockStateTests : XCTestCase
+{
+	OCKeychain *_keychain;
+
+	NSData *_savedLockedDateData;
+	NSData *_savedUnlockedData;
+}
+
+@end
+
+@implementation AppLockStateTests
+
+- (void)setUp
+{
+	_keychain = OCAppIdentity.sharedAppIdentity.keychain;
+
+	// Preserve state of the test host
+	_savedLockedDateData = [_keychain readDataFromKeychainItemForAccount:@"app.passcode" path:@"lockedDate"];
+	_savedUnlockedData = [_keychain readDataFromKeychainItemForAccount:@"app.passcode" path:@"unlocked"];
+
+	[self storeLockedDate:[NSDate dateWithTimeIntervalSinceNow:-10] unlocked:YES];
+}
+
+- (void)tearDown
+{
+	[_keychain removeItemForAccount:@"app.passcode" path:@"lockedDate"];
+	[_keychain removeItemForAccount:@"app.passcode" path:@"unlocked"];
+
+	if (_savedLockedDateData != nil)
+	{
+		[_keychain writeData:_savedLockedDateData toKeychainItemForAccount:@"app.passcode" path:@"lockedDate"];
+	}
+
+	if (_savedUnlockedData != nil)
+	{
+		[_keychain writeData:_savedUnlockedData toKeychainItemForAccount:@"app.passcode" path:@"unlocked"];
+	}
+
+	[AppLockState.sharedAppLockState invalidate];
+}
+
+- (void)storeLockedDate:(NSDate *)lockedDate unlocked:(BOOL)unlocked
+{
+	[_keychain writeData:[NSKeyedArchiver archivedDataWithRootObject:lockedDate requiringSecureCoding:YES error:NULL] toKeychainItemForAccount:@"app.passcode" path:@"lockedDate"];
+	[_keychain writeData:[NSKeyedArchiver archivedDataWithRootObject:@(unlocked) requiringSecureCoding:YES error:NULL] toKeychainItemForAccount:@"app.passcode" path:@"unlocked"];
+}
+
+- (void)testLockEvaluation
+{
+	AppLockState *state = [[AppLockState alloc] initWithKeychain:_keychain];
+
+	XCTAssertFalse([state isLockedWithLockDelay:60]);
+	XCTAssertTrue([state isLockedWithLockDelay:5]); // unlock expired
+
+	[self storeLockedDate:[NSDate date] unlocked:NO];
+
+	// Snapshot still in use until invalidated
+	XCTAssertFalse([state isLockedWithLockDelay:60]);
+
+	[state invalidate];
+	XCTAssertTrue([state isLockedWithLockDelay:60]);
+}
+
+- (void)testSnapshotExpiry
+{
+	AppLockState *state = [[AppLockState alloc] initWithKeychain:_keychain];
+
+	state.maximumSnapshotAge = 0.1;
+	XCTAssertFalse([state isLockedWithLockDelay:60]);
+
+	[self storeLockedDate:[NSDate date] unlocked:NO];
+	[NSThread sleepForTimeInterval:0.2];
+
+	XCTAssertTrue([state isLockedWithLockDelay:60]);
+}
+
+- (void)_measureEnumeratorChecksWithSnapshot:(BOOL)snapshotEnabled
+{
+	AppLockState *state = [[AppLockState alloc] initWithKeychain:_keychain];
+
+	state.snapshotEnabled = snapshotEnabled;
+
+	[self measureBlock:^{
+		// Files.app requests enumerators many times per second while browsing
+		for (NSUInteger i=0; i<1000; i++)
+		{
+			[state isLockedWithLockDelay:60];
+		}
+	}];
+}
+
+- (void)testEnumeratorCheckPerformanceWithoutSnapshot
+{
+	[self _measureEnumeratorChecksWithSnapshot:NO];
+}
+
+- (void)testEnumeratorCheckPerformanceWithSnapshot
+{
+	[self _measureEnumeratorChecksWithSnapshot:YES];
+}
+
+@end
@@ -0,0 +1,166 @@
+//
+//  BrandingCacheTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface BrandingCacheTests : XCTestCase
+{
+	NSURL *_brandingPlistURL;
+}
+@end
+
+@implementation BrandingCacheTests
+
+- (void)setUp
+{
+	NSMutableDictionary<NSString *, id> *brandingProperties = [NSMutableDictionary new];
+
+	brandingProperties[@"organizationName"] = @"Example Organization";
+	brandingProperties[@"urls"] = @{
+		@"help" : @"https://example.com/help",
+		@"privacy" : @"https://example.com/privacy",
+		@"empty" : @""
+	};
+
+	// Typical size of a customer Branding.plist
+	for (NSUInteger idx=0; idx < 200; idx++)
+	{
+		brandingProperties[[NSString stringWithFormat:@"option-%lu", (unsigned long)idx]] = @{ @"value" : @(idx), @"label" : [NSString stringWithFormat:@"Option %lu", (unsigned long)idx] };
+	}
+
+	_brandingPlistURL = [NSFileManager.defaultManager.temporaryDirectory URLByAppendingPathComponent:[NSString stringWithFormat:@"Branding-%@.plist", NSUUID.UUID.UUIDString]];
+	[[NSPropertyListSerialization dataWithPropertyList:brandingProperties format:NSPropertyListXMLFormat_v1_0 options:0 error:NULL] writeToURL:_brandingPlistURL atomically:YES];
+}
+
+- (void)tearDown
+{
+	[NSFileManager.defaultManager removeItemAtURL:_brandingPlistURL error:NULL];
+}
+
+- (Branding *)makeBrandingWithCache:(BOOL)cachesResolvedValues
+{
+	Branding *branding = [[Branding alloc] initWithAppBundle:[NSBundle bundleForClass:self.class] brandingPlistURL:_brandingPlistURL];
+
+	branding.cachesResolvedValues = cachesResolvedValues;
+
+	[branding registerLegacyKeyPath:@"urls.help" forClassSettingsKey:@"test-help-url"];
+	[branding registerLegacyKeyPath:@"urls.privacy" forClassSettingsKey:@"test-privacy-url"];
+	[branding registerLegacyKeyPath:@"urls.empty" forClassSettingsKey:@"test-empty-url"];
+
+	return (branding);
+}
+
+- (void)performTypicalLookups:(Branding *)branding
+{
+	// Lookups as performed while building the UI: theme setup, cells and URL helpers ask for the same keys over and over
+	for (NSUInteger pass=0; pass < 20; pass++)
+	{
+		(void)branding.appDisplayName;
+		(void)branding.organizationName;
+		(void)[branding isImportMethodAllowed:BrandingFileImportMethodOpenWith];
+		(void)[branding urlForClassSettingsKey:@"test-help-url"];
+		(void)[branding urlForClassSettingsKey:@"test-privacy-url"];
+		(void)[branding computedValueForClassSettingsKey:@"test-unset-key"];
+	}
+}
+
+#pragma mark - Tests
+- (void)testCachedValuesMatchResolvedValues
+{
+	Branding *cachedBranding = [self makeBrandingWithCache:YES];
+	Branding *uncachedBranding = [self makeBrandingWithCache:NO];
+
+	for (NSUInteger pass=0; pass < 2; pass++)
+	{
+		XCTAssertEqualObjects(cachedBranding.organizationName, @"Example Organization");
+		XCTAssertEqualObjects(cachedBranding.appDisplayName, uncachedBranding.appDisplayName);
+		XCTAssertEqualObjects([cachedBranding urlForClassSettingsKey:@"test-help-url"], [NSURL URLWithString:@"https://example.com/help"]);
+		XCTAssertEqualObjects([cachedBranding urlForClassSettingsKey:@"test-privacy-url"], [uncachedBranding urlForClassSettingsKey:@"test-privacy-url"]);
+		XCTAssertNil([cachedBranding urlForClassSettingsKey:@"test-empty-url"]);
+		XCTAssertNil([cachedBranding computedValueForClassSettingsKey:@"test-unset-key"]);
+		XCTAssertNil([cachedBranding brandedImageNamed:@"test-missing-image" assetSuffix:@"dark"]);
+	}
+}
+
+- (void)testValuesAreResolvedOnce
+{
+	Branding *branding = [self makeBrandingWithCache:YES];
+
+	[self performTypicalLookups:branding];
+	NSUInteger resolutionCount = branding.valueResolutionCount;
+
+	[self performTypicalLookups:branding];
+	XCTAssertEqual(branding.valueResolutionCount, resolutionCount);
+
+	XCTAssertEqual([branding urlForClassSettingsKey:@"test-help-url"], [branding urlForClassSettingsKey:@"test-help-url"]);
+}
+
+- (void)testInvalidation
+{
+	Branding *branding = [self makeBrandingWithCache:YES];
+	NSUInteger resolutionCount;
+
+	XCTAssertEqualObjects([branding urlForClassSettingsKey:@"test-help-url"].absoluteString, @"https://example.com/help");
+
+	// Legacy key path change
+	[branding registerLegacyKeyPath:@"urls.privacy" forClassSettingsKey:@"test-help-url"];
+	XCTAssertEqualObjects([branding urlForClassSettingsKey:@"test-help-url"].absoluteString, @"https://example.com/privacy");
+
+	// Managed configuration change
+	resolutionCount = branding.valueResolutionCount;
+	[NSNotificationCenter.defaultCenter postNotificationName:NSUserDefaultsDidChangeNotification object:nil];
+	(void)[branding urlForClassSettingsKey:@"test-help-url"];
+	XCTAssertEqual(branding.valueResolutionCount, resolutionCount + 1);
+
+	// Branding disabled
+	branding.allowBranding = NO;
+	XCTAssertNil(branding.organizationName);
+	XCTAssertNil([branding urlForClassSettingsKey:@"test-help-url"]);
+}
+
+#pragma mark - Benchmarks
+- (void)testColdLaunchWithoutCache
+{
+	[self measureBlock:^{
+		[self performTypicalLookups:[self makeBrandingWithCache:NO]];
+	}];
+}
+
+- (void)testColdLaunchWithCache
+{
+	[self measureBlock:^{
+		[self performTypicalLookups:[self makeBrandingWithCache:YES]];
+	}];
+}
+
+- (void)testLookupPerformanceWithoutCache
+{
+	Branding *branding = [self makeBrandingWithCache:NO];
+
+	[self measureBlock:^{
+		for (NSUInteger idx=0; idx < 100; idx++)
+		{
+			[self performTypicalLookups:branding];
+		}
+	}];
+}
+
+- (void)testLookupPerformanceWithCache
+{
+	Branding *branding = [self makeBrandingWithCache:YES];
+
+	[self measureBlock:^{
+		for (NSUInteger idx=0; idx < 100; idx++)
+		{
+			[self performTypicalLookups:branding];
+		}
+	}];
+}
+
+@end
@@ -0,0 +1,128 @@
+//
+//  ConfidentialSettingsSnapshotTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface ConfidentialSettingsSnapshotTests : XCTestCase
+@end
+
+@implementation ConfidentialSettingsSnapshotTests
+
+- (ConfidentialSettingsSnapshot *)snapshotWithValues:(NSDictionary<OCClassSettingsKey, id> *)values
+{
+	return ([[ConfidentialSettingsSnapshot alloc] initWithValueProvider:^id _Nullable(OCClassSettingsKey key) {
+		return (values[key]);
+	}]);
+}
+
+#pragma mark - Tests
+- (void)testDefaults
+{
+	ConfidentialSettingsSnapshot *snapshot = [self snapshotWithValues:@{}];
+
+	XCTAssertTrue(snapshot.allowScreenshots);
+	XCTAssertFalse(snapshot.markConfidentialViews);
+	XCTAssertFalse(snapshot.confidentialSettingsEnabled);
+	XCTAssertFalse(snapshot.allowOverwriteConfidentialMDMSettings);
+	XCTAssertEqualWithAccuracy(snapshot.textOpacity, 0.6, 0.001);
+	XCTAssertEqual(snapshot.columnSpacing, 40.0);
+	XCTAssertEqual(snapshot.lineSpacing, 40.0);
+	XCTAssertEqual(snapshot.visibleRedactedCharacters, -1);
+	XCTAssertNil(snapshot.textColor);
+	XCTAssertNil(snapshot.disallowedActions);
+}
+
+- (void)testDerivedSettings
+{
+	ConfidentialSettingsSnapshot *snapshot = [self snapshotWithValues:@{
+		OCClassSettingsKeyAllowScreenshots : @(NO),
+		OCClassSettingsKeyConfidentialTextOpacity : @(50),
+		OCClassSettingsKeyConfidentialTextColor : @"#ff0000",
+		OCClassSettingsKeyConfidentialTextShowUserEmail : @(YES),
+		OCClassSettingsKeyConfidentialExemptedActions : @[ @"com.owncloud.action.copy" ]
+	}];
+
+	XCTAssertFalse(snapshot.allowScreenshots);
+	XCTAssertTrue(snapshot.markConfidentialViews);
+	XCTAssertTrue(snapshot.confidentialSettingsEnabled);
+	XCTAssertEqualWithAccuracy(snapshot.textOpacity, 0.5, 0.001);
+	XCTAssertEqualObjects(snapshot.textColor, @"#ff0000");
+	XCTAssertEqualObjects(snapshot.disallowedActions, (@[ @"com.owncloud.action.openin", @"com.owncloud.action.markup" ]));
+
+	// Overwriting MDM settings lifts the disallowed actions
+	snapshot = [self snapshotWithValues:@{
+		OCClassSettingsKeyConfidentialTextCustomText : @"Confidential",
+		OCClassSettingsKeyAllowOverwriteConfidentialMDMSettings : @(YES)
+	}];
+
+	XCTAssertTrue(snapshot.allowOverwriteConfidentialMDMSettings);
+	XCTAssertNil(snapshot.disallowedActions);
+}
+
+- (void)testSnapshotIsKeptUntilSettingsChange
+{
+	ConfidentialManager *manager = ConfidentialManager.sharedConfidentialManager;
+	ConfidentialSettingsSnapshot *snapshot = manager.settingsSnapshot;
+
+	XCTAssertEqual(manager.settingsSnapshot, snapshot);
+	XCTAssertEqual(manager.allowScreenshots, snapshot.allowScreenshots);
+	XCTAssertEqual(manager.settingsSnapshot, snapshot);
+
+	[NSNotificationCenter.defaultCenter postNotificationName:NSUserDefaultsDidChangeNotification object:nil];
+
+	XCTAssertNotEqual(manager.settingsSnapshot, snapshot);
+	snapshot = manager.settingsSnapshot;
+
+	[manager invalidateSettingsSnapshot];
+
+	XCTAssertNotEqual(manager.settingsSnapshot, snapshot);
+}
+
+#pragma mark - Benchmarks
+static const NSUInteger sDrawIterations = 100000;
+
+- (void)testDrawLoopAccessWithClassSettings
+{
+	// Previous behaviour: resolve every property through class settings on access
+	[self measureBlock:^{
+		CGFloat sum = 0;
+
+		for (NSUInteger idx=0; idx < sDrawIterations; idx++)
+		{
+			NSNumber *opacity = [ConfidentialManager classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextOpacity];
+			NSNumber *columnSpacing = [ConfidentialManager classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextColumnSpacing];
+			NSNumber *lineSpacing = [ConfidentialManager classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextLineSpacing];
+			NSString *textColor = [ConfidentialManager classSettingForOCClassSettingsKey:OCClassSettingsKeyConfidentialTextColor];
+
+			sum += ((opacity != nil) ? (opacity.intValue / 100.0) : 0.6) + ((columnSpacing != nil) ? columnSpacing.floatValue : 40.0) + ((lineSpacing != nil) ? lineSpacing.floatValue : 40.0) + textColor.length;
+		}
+
+		XCTAssertGreaterThan(sum, 0);
+	}];
+}
+
+- (void)testDrawLoopAccessWithSnapshot
+{
+	ConfidentialManager *manager = ConfidentialManager.sharedConfidentialManager;
+
+	[self measureBlock:^{
+		CGFloat sum = 0;
+
+		for (NSUInteger idx=0; idx < sDrawIterations; idx++)
+		{
+			ConfidentialSettingsSnapshot *settings = manager.settingsSnapshot;
+
+			sum += settings.textOpacity + settings.columnSpacing + settings.lineSpacing + settings.textColor.length;
+		}
+
+		XCTAssertGreaterThan(sum, 0);
+	}];
+}
+
+@end
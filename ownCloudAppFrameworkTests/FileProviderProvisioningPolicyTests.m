@@ -0,0 +1,142 @@
+//
+//  FileProviderProvisioningPolicyTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+/// Stands in for OCCore, resolving local copies to files in a temporary directory.
+@interface ProvisioningStubCore : NSObject <OCFileProviderProvisioningSource>
+@property(strong) NSURL *rootURL;
+@end
+
+@implementation ProvisioningStubCore
+
+- (NSURL *)localURLForItem:(OCItem *)item
+{
+	return ((item.localRelativePath != nil) ? [_rootURL URLByAppendingPathComponent:item.localRelativePath] : nil);
+}
+
+@end
+
+@interface FileProviderProvisioningPolicyTests : XCTestCase
+{
+	ProvisioningStubCore *_core;
+}
+
+@end
+
+@implementation FileProviderProvisioningPolicyTests
+
+- (void)setUp
+{
+	_core = [ProvisioningStubCore new];
+	_core.rootURL = [NSFileManager.defaultManager.temporaryDirectory URLByAppendingPathComponent:NSUUID.UUID.UUIDString isDirectory:YES];
+
+	[NSFileManager.defaultManager createDirectoryAtURL:_core.rootURL withIntermediateDirectories:YES attributes:nil error:NULL];
+}
+
+- (void)tearDown
+{
+	[NSFileManager.defaultManager removeItemAtURL:_core.rootURL error:NULL];
+}
+
+- (OCItem *)makeItemWithName:(NSString *)name size:(NSUInteger)size localCopy:(BOOL)localCopy
+{
+	OCItem *item = [OCItem new];
+
+	item.type = OCItemTypeFile;
+	item.localID = name;
+	item.path = [@"/" stringByAppendingString:name];
+	item.eTag = @"etag-1";
+	item.fileID = [@"id-" stringByAppendingString:name];
+	item.size = size;
+
+	if (localCopy)
+	{
+		item.localRelativePath = name;
+		item.localCopyVersionIdentifier = item.itemVersionIdentifier;
+
+		[[NSMutableData dataWithLength:size] writeToURL:[_core localURLForItem:item] atomically:NO];
+	}
+
+	return (item);
+}
+
+- (void)testDecisions
+{
+	OCFileProviderProvisioningPolicy *policy = [OCFileProviderProvisioningPolicy new];
+	OCFileProviderProvisioningReason reason;
+	OCItem *item;
+
+	// No local copy
+	item = [self makeItemWithName:@"a.bin" size:100 localCopy:NO];
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionDownload);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonNoLocalCopy);
+
+	// Current local copy
+	item = [self makeItemWithName:@"b.bin" size:100 localCopy:YES];
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionProvideLocalCopy);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonCurrent);
+
+	// Local copy removed from disk
+	[NSFileManager.defaultManager removeItemAtURL:[_core localURLForItem:item] error:NULL];
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionDownload);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonLocalFileMissing);
+
+	// Outdated local copy
+	item = [self makeItemWithName:@"c.bin" size:100 localCopy:YES];
+	item.eTag = @"etag-2";
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionDownload);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonNewerRemoteVersion);
+
+	// Incomplete local copy
+	item = [self makeItemWithName:@"d.bin" size:100 localCopy:YES];
+	item.size = 200;
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionDownload);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonLocalFileSizeMismatch);
+
+	// Local modifications
+	item = [self makeItemWithName:@"e.bin" size:100 localCopy:YES];
+	item.locallyModified = YES;
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionProvideLocalModifications);
+	XCTAssertEqual(reason, OCFileProviderProvisioningReasonLocallyModified);
+
+	// Local modifications and newer remote version
+	OCItem *remoteItem = [self makeItemWithName:@"e.bin" size:300 localCopy:NO];
+	remoteItem.eTag = @"etag-2";
+	item.remoteItem = remoteItem;
+	XCTAssertEqual([policy decisionForItem:item source:_core reason:&reason], OCFileProviderProvisioningDecisionProvideConflictingModifications);
+}
+
+- (void)testAvoidedBytesAndDecisionLatency
+{
+	OCFileProviderProvisioningPolicy *policy = [OCFileProviderProvisioningPolicy new];
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+
+	// Reopening documents: 3 out of 4 are already cached
+	for (NSUInteger idx=0; idx < 200; idx++)
+	{
+		[items addObject:[self makeItemWithName:[NSString stringWithFormat:@"doc-%lu.bin", (unsigned long)idx] size:64 * 1024 localCopy:((idx % 4) != 0)]];
+	}
+
+	[self measureBlock:^{
+		[policy resetStatistics];
+
+		for (OCItem *item in items)
+		{
+			[policy decisionForItem:item source:self->_core reason:NULL];
+		}
+	}];
+
+	XCTAssertEqual(policy.decisionCount, 200);
+	XCTAssertEqual(policy.downloadCount, 50);
+	XCTAssertEqual(policy.avoidedBytes, 150 * 64 * 1024);
+	XCTAssertLessThan(policy.totalDecisionTime / policy.decisionCount, 0.001);
+}
+
+@end
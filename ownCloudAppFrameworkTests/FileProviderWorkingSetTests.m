@@ -0,0 +1,272 @@
+//
+//  FileProviderWorkingSetTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface FileProviderWorkingSetTests : XCTestCase
+
+@end
+
+@implementation FileProviderWorkingSetTests
+
+/// Synthetic item database: roughly 1 in 50 items is a favorite, available offline, has a local copy or was recently used.
+- (NSArray<OCItem *> *)makeItemsWithCount:(NSUInteger)count
+{
+	NSMutableArray<OCItem *> *items = [[NSMutableArray alloc] initWithCapacity:count];
+	NSDate *recentDate = [NSDate dateWithTimeIntervalSinceNow:-60];
+	NSDate *oldDate = [NSDate dateWithTimeIntervalSinceNow:-365 * 24 * 60 * 60];
+
+	for (NSUInteger idx=0; idx < count; idx++)
+	{
+		OCItem *item = [OCItem new];
+
+		item.type = OCItemTypeFile;
+		item.localID = [NSString stringWithFormat:@"local-%lu", (unsigned long)idx];
+		item.fileID = [NSString stringWithFormat:@"file-%lu", (unsigned long)idx];
+		item.path = [NSString stringWithFormat:@"/folder-%lu/file-%lu.txt", (unsigned long)(idx / 1000), (unsigned long)idx];
+		item.lastUsed = oldDate;
+
+		switch (idx % 200)
+		{
+			case 0: item.isFavorite = @(YES); break;
+			case 1: item.downloadTriggerIdentifier = OCItemDownloadTriggerIDAvailableOffline; break;
+			case 2: item.localRelativePath = item.path; break;
+			case 3: item.lastUsed = recentDate; break;
+		}
+
+		[items addObject:item];
+	}
+
+	return (items);
+}
+
+- (void)testMembership
+{
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+	NSArray<OCItem *> *items = [self makeItemsWithCount:200];
+
+	XCTAssertEqual([workingSet reasonsForItem:items[0]], OCFileProviderWorkingSetReasonFavorite);
+	XCTAssertEqual([workingSet reasonsForItem:items[1]], OCFileProviderWorkingSetReasonAvailableOffline);
+	XCTAssertEqual([workingSet reasonsForItem:items[2]], OCFileProviderWorkingSetReasonLocalCopy);
+	XCTAssertEqual([workingSet reasonsForItem:items[3]], OCFileProviderWorkingSetReasonRecentlyUsed);
+	XCTAssertEqual([workingSet reasonsForItem:items[4]], OCFileProviderWorkingSetReasonNone);
+
+	items[0].removed = YES;
+	XCTAssertFalse([workingSet includesItem:items[0]]);
+}
+
+- (void)testPaging
+{
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+	NSMutableSet<OCLocalID> *enumeratedLocalIDs = [NSMutableSet new];
+	NSData *page = nil;
+	NSUInteger pageCount = 0;
+
+	workingSet.maximumPageSize = 100;
+	[workingSet makeSnapshotFromItems:[self makeItemsWithCount:20000] syncAnchor:@(10)];
+
+	XCTAssertEqual(workingSet.count, 400);
+
+	do {
+		NSData *nextPage = nil;
+		NSArray<OCItem *> *items = [workingSet itemsForPage:page nextPage:&nextPage];
+
+		XCTAssertNotNil(items);
+		XCTAssertLessThanOrEqual(items.count, 100);
+
+		for (OCItem *item in items)
+		{
+			XCTAssertFalse([enumeratedLocalIDs containsObject:item.localID]);
+			[enumeratedLocalIDs addObject:item.localID];
+		}
+
+		page = nextPage;
+		pageCount++;
+	} while (page != nil);
+
+	XCTAssertEqual(pageCount, 4);
+	XCTAssertEqual(enumeratedLocalIDs.count, 400);
+
+	// Pages of an outdated snapshot are rejected
+	NSData *secondPage = nil;
+	[workingSet itemsForPage:nil nextPage:&secondPage];
+	[workingSet makeSnapshotFromItems:[self makeItemsWithCount:20000] syncAnchor:@(11)];
+
+	XCTAssertNil([workingSet itemsForPage:secondPage nextPage:NULL]);
+}
+
+- (void)testChangeClassification
+{
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+	NSArray<OCItem *> *items = [self makeItemsWithCount:400];
+	NSArray<OCItem *> *updatedItems = nil;
+	NSArray<OCItem *> *deletedItems = nil;
+
+	// Without a known membership, all changed items outside the working set are reported as deleted
+	[workingSet classifyChangedItems:items updatedItems:&updatedItems deletedItems:&deletedItems];
+
+	XCTAssertEqual(updatedItems.count, 8);
+	XCTAssertEqual(deletedItems.count, 392);
+}
+
+- (void)testLeavingMembersAreReportedDeleted
+{
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+	NSArray<OCItem *> *items = [self makeItemsWithCount:400];
+	NSArray<OCItem *> *updatedItems = nil;
+	NSArray<OCItem *> *deletedItems = nil;
+
+	[workingSet makeSnapshotFromItems:items syncAnchor:@(1)];
+	XCTAssertEqual(workingSet.count, 8);
+
+	// A changed member that left the working set is reported, a changed item that never was a member isn't
+	items[0].isFavorite = @(NO);
+
+	[workingSet classifyChangedItems:@[ items[0], items[4] ] updatedItems:&updatedItems deletedItems:&deletedItems];
+
+	XCTAssertEqual(updatedItems.count, 0);
+	XCTAssertEqualObjects(deletedItems, @[ items[0] ]);
+
+	// Unchanged members that are no longer recently used are reported
+	workingSet.recentlyUsedInterval = 1;
+
+	[workingSet classifyChangedItems:@[] updatedItems:&updatedItems deletedItems:&deletedItems];
+
+	XCTAssertEqual(updatedItems.count, 0);
+	XCTAssertEqualObjects([NSSet setWithArray:deletedItems], ([NSSet setWithObjects:items[3], items[203], nil]));
+
+	// ..but only once
+	[workingSet classifyChangedItems:@[] updatedItems:&updatedItems deletedItems:&deletedItems];
+
+	XCTAssertEqual(deletedItems.count, 0);
+
+	// Items entering the working set through changes become members
+	items[4].isFavorite = @(YES);
+
+	[workingSet classifyChangedItems:@[ items[4] ] updatedItems:&updatedItems deletedItems:&deletedItems];
+	XCTAssertEqualObjects(updatedItems, @[ items[4] ]);
+
+	items[4].isFavorite = @(NO);
+
+	[workingSet classifyChangedItems:@[ items[4] ] updatedItems:&updatedItems deletedItems:&deletedItems];
+	XCTAssertEqualObjects(deletedItems, @[ items[4] ]);
+}
+
+#pragma mark - Database benchmarks
+- (OCDatabase *)makeDatabaseWithItems:(NSArray<OCItem *> *)items
+{
+	NSURL *databaseURL = [NSFileManager.defaultManager.temporaryDirectory URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.sqlite", NSUUID.UUID.UUIDString]];
+	OCDatabase *database = [[OCDatabase alloc] initWithURL:databaseURL];
+	XCTestExpectation *populatedExpectation = [self expectationWithDescription:@"Database populated"];
+	NSUInteger batchSize = 10000;
+
+	[self addTeardownBlock:^{
+		[database closeWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+			[NSFileManager.defaultManager removeItemAtURL:databaseURL error:NULL];
+		}];
+	}];
+
+	[database openWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+		XCTAssertNil(error);
+
+		for (NSUInteger offset=0; offset < items.count; offset += batchSize)
+		{
+			BOOL isLastBatch = ((offset + batchSize) >= items.count);
+
+			[db addCacheItems:[items subarrayWithRange:NSMakeRange(offset, MIN(batchSize, items.count - offset))] syncAnchor:@(1) completionHandler:^(OCDatabase *db, NSError *error) {
+				XCTAssertNil(error);
+
+				if (isLastBatch)
+				{
+					[populatedExpectation fulfill];
+				}
+			}];
+		}
+	}];
+
+	[self waitForExpectations:@[ populatedExpectation ] timeout:600];
+
+	return (database);
+}
+
+- (void)testMillionItemDatabaseEnumerationPerformance
+{
+	OCDatabase *database = [self makeDatabaseWithItems:[self makeItemsWithCount:1000000]];
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+
+	workingSet.maximumSnapshotItemCount = 20000;
+
+	// Snapshot query and paging, as performed by the File Provider's working set enumerator
+	[self measureBlock:^{
+		XCTestExpectation *snapshotExpectation = [self expectationWithDescription:@"Snapshot made"];
+		NSData *page = nil;
+
+		[workingSet makeSnapshotFromDatabase:database fallbackSyncAnchor:nil completionHandler:^(NSError * _Nullable error) {
+			XCTAssertNil(error);
+			[snapshotExpectation fulfill];
+		}];
+
+		[self waitForExpectations:@[ snapshotExpectation ] timeout:60];
+
+		do {
+			NSData *nextPage = nil;
+			[workingSet itemsForPage:page nextPage:&nextPage];
+			page = nextPage;
+		} while (page != nil);
+	}];
+
+	// Favorites, local copies and recently used items (available offline items without local copy are only picked up from changes)
+	XCTAssertEqual(workingSet.count, 15000);
+}
+
+- (void)testMillionItemDatabaseChangesPerformance
+{
+	NSArray<OCItem *> *items = [self makeItemsWithCount:1000000];
+	OCDatabase *database = [self makeDatabaseWithItems:items];
+	OCFileProviderWorkingSet *workingSet = [OCFileProviderWorkingSet new];
+	NSArray<OCItem *> *membersBeforeChanges = [[self makeItemsWithCount:1000000] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(OCItem *item, NSDictionary *bindings) {
+		return ([workingSet includesItem:item]);
+	}]];
+	NSMutableArray<OCItem *> *changedItems = [NSMutableArray new];
+	XCTestExpectation *changedExpectation = [self expectationWithDescription:@"Items changed"];
+
+	// Change 1000 items, half of which leave the working set
+	for (NSUInteger idx=0; idx < 1000; idx++)
+	{
+		OCItem *item = items[idx * 200];
+
+		item.isFavorite = @((idx % 2) == 0);
+		[changedItems addObject:item];
+	}
+
+	[database updateCacheItems:changedItems syncAnchor:@(2) completionHandler:^(OCDatabase *db, NSError *error) {
+		XCTAssertNil(error);
+		[changedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ changedExpectation ] timeout:60];
+
+	[self measureBlock:^{
+		XCTestExpectation *changesExpectation = [self expectationWithDescription:@"Changes retrieved"];
+
+		// Restore the membership from before the changes
+		[workingSet makeSnapshotFromItems:membersBeforeChanges syncAnchor:@(1)];
+
+		[workingSet retrieveChangesFromDatabase:database sinceSyncAnchor:@(1) completionHandler:^(NSError * _Nullable error, OCSyncAnchor _Nullable syncAnchor, NSArray<OCItem *> * _Nullable updatedItems, NSArray<OCItem *> * _Nullable deletedItems) {
+			XCTAssertNil(error);
+			XCTAssertEqual(updatedItems.count, 500);
+			XCTAssertEqual(deletedItems.count, 500);
+			[changesExpectation fulfill];
+		}];
+
+		[self waitForExpectations:@[ changesExpectation ] timeout:60];
+	}];
+}
+
+@end
@@ -0,0 +1,177 @@
+//
+//  IncrementalSearchSegmentationTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface IncrementalSearchSegmentationTests : XCTestCase
+@end
+
+@implementation IncrementalSearchSegmentationTests
+
+static NSString *sLongQuery = @"report -draft type:pdf,docx after:2024-01-01 before:2026-06-30 greater:1mb smaller:2gb :7d owner:jdoe -:folder quarterly summary";
+
+- (void)assertSegments:(NSArray<OCSearchSegment *> *)segments equalSegments:(NSArray<OCSearchSegment *> *)expectedSegments forString:(NSString *)string
+{
+	XCTAssertEqual(segments.count, expectedSegments.count, @"Segment count mismatch for \"%@\"", string);
+
+	if (segments.count == expectedSegments.count)
+	{
+		for (NSUInteger idx=0; idx < segments.count; idx++)
+		{
+			XCTAssertEqualObjects(segments[idx].segmentedString, expectedSegments[idx].segmentedString, @"for \"%@\"", string);
+			XCTAssertEqualObjects(segments[idx].originalString, expectedSegments[idx].originalString, @"for \"%@\"", string);
+			XCTAssertTrue(NSEqualRanges(segments[idx].range, expectedSegments[idx].range), @"%@ != %@ for \"%@\"", NSStringFromRange(segments[idx].range), NSStringFromRange(expectedSegments[idx].range), string);
+			XCTAssertEqual(segments[idx].hasCursor, expectedSegments[idx].hasCursor, @"for \"%@\"", string);
+			XCTAssertEqual(segments[idx].cursorOffset, expectedSegments[idx].cursorOffset, @"for \"%@\"", string);
+		}
+	}
+}
+
+#pragma mark - Tests
+- (void)testIncrementalSegmentationMatchesFullSegmentation
+{
+	OCSearchSegmenter *segmenter = [[OCSearchSegmenter alloc] initWithQuotationMarks:NO];
+	NSArray<NSString *> *insertions = @[ @"a", @" ", @"-", @"x:", @"  ", @"\"", @"type:jpg ", @"7" ];
+	NSMutableString *string = [NSMutableString new];
+
+	srand48(42);
+
+	for (NSUInteger edit=0; edit < 5000; edit++)
+	{
+		NSUInteger position = (NSUInteger)(drand48() * (string.length + 1));
+
+		if ((string.length > 0) && (drand48() < 0.4))
+		{
+			// Delete a range
+			NSUInteger length = MIN((NSUInteger)(drand48() * 4) + 1, string.length - MIN(position, string.length - 1));
+			position = MIN(position, string.length - 1);
+
+			[string deleteCharactersInRange:NSMakeRange(position, length)];
+		}
+		else
+		{
+			NSString *insertion = insertions[(NSUInteger)(drand48() * insertions.count)];
+
+			// Keep quotation marks rare, so that most edits take the incremental path
+			if ([insertion isEqual:@"\""] && (drand48() < 0.9))
+			{
+				insertion = @"b";
+			}
+
+			[string insertString:insertion atIndex:position];
+			position += insertion.length;
+		}
+
+		if (string.length > 80)
+		{
+			[string setString:[string substringFromIndex:string.length - 40]];
+			position = MIN(position, string.length);
+		}
+
+		NSNumber *cursorPosition = (drand48() < 0.8) ? @(position) : nil;
+
+		[self assertSegments:[segmenter segmentsForString:string cursorPosition:cursorPosition] equalSegments:[string segmentedForSearchWithQuotationMarks:NO cursorPosition:cursorPosition] forString:string];
+	}
+
+	XCTAssertGreaterThan(segmenter.reusedSegmentCount, 0);
+	XCTAssertLessThan(segmenter.fullSegmentationCount, 5000);
+}
+
+- (void)testQuotedStringsAreFullySegmented
+{
+	OCSearchSegmenter *segmenter = [[OCSearchSegmenter alloc] initWithQuotationMarks:NO];
+
+	[segmenter segmentsForString:@"\"Hello World term2" cursorPosition:nil];
+	NSArray<OCSearchSegment *> *segments = [segmenter segmentsForString:@"\"Hello World\" term2" cursorPosition:nil];
+
+	XCTAssertEqualObjects([segments valueForKey:@"segmentedString"], (@[ @"Hello World", @"term2" ]));
+	XCTAssertEqual(segmenter.fullSegmentationCount, 2);
+}
+
+- (void)testCachedConditions
+{
+	[OCQueryCondition flushCachedSearchSegmentConditions];
+
+	OCQueryCondition *condition = [OCQueryCondition cachedForSearchSegment:@"greater:10mb"];
+
+	XCTAssertNotNil(condition);
+	XCTAssertEqual([OCQueryCondition cachedForSearchSegment:@"greater:10mb"], condition);
+	XCTAssertTrue([condition isEquivalentTo:[OCQueryCondition forSearchSegment:@"greater:10mb"]]);
+	XCTAssertEqualObjects(condition.composedSearchTerm, @"greater:10mb");
+
+	// Segments without condition
+	XCTAssertNil([OCQueryCondition cachedForSearchSegment:@"type:"]);
+	XCTAssertNil([OCQueryCondition cachedForSearchSegment:@"type:"]);
+
+	// Least recently used entries are evicted first
+	OCQueryCondition *firstTermCondition = [OCQueryCondition cachedForSearchSegment:@"term0"];
+
+	for (NSUInteger idx=1; idx < 200; idx++)
+	{
+		XCTAssertNotNil([OCQueryCondition cachedForSearchSegment:[NSString stringWithFormat:@"term%lu", (unsigned long)idx]]);
+		XCTAssertEqual([OCQueryCondition cachedForSearchSegment:@"greater:10mb"], condition);
+	}
+
+	XCTAssertNotEqual([OCQueryCondition cachedForSearchSegment:@"term0"], firstTermCondition);
+
+	[OCQueryCondition flushCachedSearchSegmentConditions];
+	XCTAssertNotEqual([OCQueryCondition cachedForSearchSegment:@"greater:10mb"], condition);
+
+	// Multi-segment search terms are composed freshly
+	XCTAssertNotEqual([OCQueryCondition cachedFromSearchTerm:@"report greater:10mb"], [OCQueryCondition cachedFromSearchTerm:@"report greater:10mb"]);
+}
+
+#pragma mark - Benchmarks
+/// Types the long query character by character and converts the segments into conditions after every keystroke. Per-keystroke latency is the measured time divided by the length of the query.
+- (void)_measureTypingIncrementally:(BOOL)incremental
+{
+	[self measureBlock:^{
+		OCSearchSegmenter *segmenter = [[OCSearchSegmenter alloc] initWithQuotationMarks:NO];
+		NSUInteger conditionCount = 0;
+
+		[OCQueryCondition flushCachedSearchSegmentConditions];
+
+		for (NSUInteger length=1; length <= sLongQuery.length; length++)
+		{
+			NSString *typedString = [sLongQuery substringToIndex:length];
+			NSArray<OCSearchSegment *> *segments;
+
+			if (incremental)
+			{
+				segments = [segmenter segmentsForString:typedString cursorPosition:@(length)];
+			}
+			else
+			{
+				segments = [typedString segmentedForSearchWithQuotationMarks:NO cursorPosition:@(length)];
+			}
+
+			for (OCSearchSegment *segment in segments)
+			{
+				if ((incremental ? [OCQueryCondition cachedFromSearchTerm:segment.segmentedString] : [OCQueryCondition fromSearchTerm:segment.segmentedString]) != nil)
+				{
+					conditionCount++;
+				}
+			}
+		}
+
+		XCTAssertGreaterThan(conditionCount, 0);
+	}];
+}
+
+- (void)testKeystrokePerformanceFull
+{
+	[self _measureTypingIncrementally:NO];
+}
+
+- (void)testKeystrokePerformanceIncremental
+{
+	[self _measureTypingIncrementally:YES];
+}
+
+@end
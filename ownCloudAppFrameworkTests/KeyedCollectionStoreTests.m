@@ -0,0 +1,225 @@
+//
+//  KeyedCollectionStoreTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface KeyedCollectionStoreTests : XCTestCase
+{
+	NSURL *_storeURL;
+	OCKeyValueStore *_keyValueStore;
+}
+@end
+
+@implementation KeyedCollectionStoreTests
+
+- (void)setUp
+{
+	_storeURL = [NSFileManager.defaultManager.temporaryDirectory URLByAppendingPathComponent:[NSString stringWithFormat:@"KeyedCollectionStoreTests-%@", NSUUID.UUID.UUIDString]];
+	_keyValueStore = [[OCKeyValueStore alloc] initWithURL:_storeURL identifier:_storeURL.lastPathComponent];
+
+	[OCKeyValueStore registerClasses:[NSSet setWithObjects:NSArray.class, OCSavedSearch.class, nil] forKey:@"legacySearches"];
+}
+
+- (void)tearDown
+{
+	_keyValueStore = nil;
+	[NSFileManager.defaultManager removeItemAtURL:_storeURL error:NULL];
+}
+
+- (OCKeyedCollectionStore<OCSavedSearch *> *)makeStore
+{
+	return ([[OCKeyedCollectionStore alloc] initWithKeyValueStore:_keyValueStore collectionKey:@"searches" classes:[NSSet setWithObject:OCSavedSearch.class] identifierProvider:^OCKeyedCollectionIdentifier(OCSavedSearch *savedSearch) {
+		return (savedSearch.uuid);
+	}]);
+}
+
+- (NSArray<OCSavedSearch *> *)makeSavedSearches:(NSUInteger)count
+{
+	NSMutableArray<OCSavedSearch *> *savedSearches = [NSMutableArray new];
+
+	for (NSUInteger idx=0; idx < count; idx++)
+	{
+		[savedSearches addObject:[[OCSavedSearch alloc] initWithScope:OCSavedSearchScopeAccount location:nil name:[NSString stringWithFormat:@"Search %lu", (unsigned long)idx] isTemplate:NO searchTerm:[NSString stringWithFormat:@"report type:pdf size:>%lumb after:2024-01", (unsigned long)idx] userInfo:@{ @"icon" : @"doc.text.magnifyingglass", @"index" : @(idx) }]];
+	}
+
+	return (savedSearches);
+}
+
+#pragma mark - Tests
+- (void)testAddUpdateRemove
+{
+	OCKeyedCollectionStore<OCSavedSearch *> *store = [self makeStore];
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:3];
+
+	for (OCSavedSearch *savedSearch in savedSearches)
+	{
+		[store addEntry:savedSearch];
+	}
+
+	XCTAssertEqualObjects(store.entries, savedSearches);
+	XCTAssertEqual(store.revision, 3);
+
+	savedSearches[1].name = @"Renamed";
+	[store updateEntry:savedSearches[1]];
+
+	XCTAssertEqualObjects([store entryForIdentifier:savedSearches[1].uuid].name, @"Renamed");
+	XCTAssertEqualObjects(store.entries, savedSearches);
+
+	// Updating an entry that was never added has no effect
+	[store updateEntry:[self makeSavedSearches:1].firstObject];
+	XCTAssertEqual(store.entries.count, 3);
+	XCTAssertEqual(store.revision, 4);
+
+	[store removeEntry:savedSearches[0]];
+
+	XCTAssertEqualObjects(store.entries, (@[ savedSearches[1], savedSearches[2] ]));
+	XCTAssertNil([store entryForIdentifier:savedSearches[0].uuid]);
+}
+
+- (void)testBatchUpdatesProduceSingleChangeSet
+{
+	OCKeyedCollectionStore<OCSavedSearch *> *store = [self makeStore];
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:4];
+	XCTestExpectation *changeExpectation = [self expectationWithDescription:@"Change set received"];
+	NSMutableArray<OCKeyedCollectionChangeSet *> *receivedChangeSets = [NSMutableArray new];
+
+	[store addEntry:savedSearches[0]];
+	[store addEntry:savedSearches[1]];
+
+	[store addObserver:self withInitial:NO updateHandler:^(id owner, NSArray<OCSavedSearch *> *entries, OCKeyedCollectionChangeSet *changes, BOOL initial) {
+		XCTAssertFalse(initial);
+		XCTAssertEqual(entries.count, 2);
+
+		[receivedChangeSets addObject:changes];
+		[changeExpectation fulfill];
+	}];
+
+	[store performBatchUpdates:^(OCKeyedCollectionStore<OCSavedSearch *> *store) {
+		[store addEntry:savedSearches[2]];
+		[store addEntry:savedSearches[3]];
+		[store removeEntry:savedSearches[3]]; // Added and removed again: not part of the change set
+		[store updateEntry:savedSearches[0]];
+		[store removeEntry:savedSearches[1]];
+	}];
+
+	[self waitForExpectationsWithTimeout:5 handler:nil];
+
+	XCTAssertEqual(receivedChangeSets.count, 1);
+	XCTAssertEqual(store.revision, 3);
+	XCTAssertEqualObjects(receivedChangeSets.firstObject.addedIdentifiers, [NSSet setWithObject:savedSearches[2].uuid]);
+	XCTAssertEqualObjects(receivedChangeSets.firstObject.updatedIdentifiers, [NSSet setWithObject:savedSearches[0].uuid]);
+	XCTAssertEqualObjects(receivedChangeSets.firstObject.removedIdentifiers, [NSSet setWithObject:savedSearches[1].uuid]);
+}
+
+- (void)testOnlyChangedEntriesAreReread
+{
+	OCKeyedCollectionStore<OCSavedSearch *> *writingStore = [self makeStore];
+	OCKeyedCollectionStore<OCSavedSearch *> *readingStore = [self makeStore]; // Stands in for another process
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:100];
+
+	[writingStore performBatchUpdates:^(OCKeyedCollectionStore<OCSavedSearch *> *store) {
+		for (OCSavedSearch *savedSearch in savedSearches)
+		{
+			[store addEntry:savedSearch];
+		}
+	}];
+
+	XCTAssertEqual(readingStore.entries.count, 100);
+	XCTAssertEqual(readingStore.entryReadCount, 100);
+
+	XCTAssertEqual(readingStore.entries.count, 100);
+	XCTAssertEqual(readingStore.entryReadCount, 100);
+
+	savedSearches[42].name = @"Renamed";
+	[writingStore updateEntry:savedSearches[42]];
+	[writingStore removeEntry:savedSearches[7]];
+
+	XCTAssertEqualObjects(readingStore.entries[41].name, @"Renamed");
+	XCTAssertEqual(readingStore.entries.count, 99);
+	XCTAssertEqual(readingStore.entryReadCount, 101);
+}
+
+- (void)testLegacyArrayMigration
+{
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:10];
+
+	[_keyValueStore storeObject:savedSearches forKey:@"legacySearches"];
+
+	OCKeyedCollectionStore<OCSavedSearch *> *store = [self makeStore];
+	store.legacyArrayKey = @"legacySearches";
+
+	XCTAssertEqualObjects(store.entries, savedSearches);
+	XCTAssertNil([_keyValueStore readObjectForKey:@"legacySearches"]);
+
+	// Subsequent instances read the migrated records
+	XCTAssertEqualObjects([self makeStore].entries, savedSearches);
+}
+
+#pragma mark - Benchmarks
+static const NSUInteger sBenchmarkEntryCount = 500;
+static const NSUInteger sBenchmarkEditCount = 50;
+
+- (void)testEditPerformanceWholeArray
+{
+	// Previous approach: archive and write the whole array for every edit
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:sBenchmarkEntryCount];
+	__block NSUInteger writtenByteCount = 0;
+
+	[_keyValueStore storeObject:savedSearches forKey:@"legacySearches"];
+
+	[self measureBlock:^{
+		for (NSUInteger edit=0; edit < sBenchmarkEditCount; edit++)
+		{
+			[self->_keyValueStore updateObjectForKey:@"legacySearches" usingModifier:^id _Nullable(id _Nullable existingObject, BOOL * _Nonnull outDidModify) {
+				NSMutableArray<OCSavedSearch *> *storedSearches = OCTypedCast(existingObject, NSMutableArray);
+
+				storedSearches[edit].name = [NSString stringWithFormat:@"Renamed %lu", (unsigned long)edit];
+				writtenByteCount += [NSKeyedArchiver archivedDataWithRootObject:storedSearches requiringSecureCoding:YES error:NULL].length;
+
+				*outDidModify = YES;
+				return (storedSearches);
+			}];
+		}
+	}];
+
+	// Every edit archives the entire array
+	XCTAssertGreaterThanOrEqual(writtenByteCount / (sBenchmarkEditCount * 10), [NSKeyedArchiver archivedDataWithRootObject:savedSearches requiringSecureCoding:YES error:NULL].length / 2);
+}
+
+- (void)testEditPerformanceKeyedCollection
+{
+	NSArray<OCSavedSearch *> *savedSearches = [self makeSavedSearches:sBenchmarkEntryCount];
+	OCKeyedCollectionStore<OCSavedSearch *> *store = [self makeStore];
+	NSUInteger wholeArrayByteCount = [NSKeyedArchiver archivedDataWithRootObject:savedSearches requiringSecureCoding:YES error:NULL].length;
+	__block NSUInteger editByteCount = 0;
+
+	[store performBatchUpdates:^(OCKeyedCollectionStore<OCSavedSearch *> *store) {
+		for (OCSavedSearch *savedSearch in savedSearches)
+		{
+			[store addEntry:savedSearch];
+		}
+	}];
+
+	[self measureBlock:^{
+		NSUInteger byteCountBefore = store.writtenByteCount;
+
+		for (NSUInteger edit=0; edit < sBenchmarkEditCount; edit++)
+		{
+			savedSearches[edit].name = [NSString stringWithFormat:@"Renamed %lu", (unsigned long)edit];
+			[store updateEntry:savedSearches[edit]];
+		}
+
+		editByteCount = (store.writtenByteCount - byteCountBefore) / sBenchmarkEditCount;
+	}];
+
+	XCTAssertLessThan(editByteCount, wholeArrayByteCount / 4);
+	XCTAssertEqualObjects(store.entries, savedSearches);
+}
+
+@end
@@ -0,0 +1,191 @@
+//
+//  KeywordParserTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface NSDate (ComputedTimesInternal)
++ (NSDate *)_startOfDay:(NSInteger)dayOffset relativeToDate:(NSDate *)date calendar:(NSCalendar *)calendar;
+@end
+
+@interface KeywordParserTests : XCTestCase
+@end
+
+@implementation KeywordParserTests
+
+- (NSString *)randomStringFromAlphabet:(NSString *)alphabet maxLength:(NSUInteger)maxLength
+{
+	NSUInteger length = (NSUInteger)(drand48() * (maxLength + 1));
+	NSMutableString *string = [NSMutableString new];
+
+	for (NSUInteger idx=0; idx < length; idx++)
+	{
+		[string appendString:[alphabet substringWithRange:[alphabet rangeOfComposedCharacterSequenceAtIndex:(NSUInteger)(drand48() * alphabet.length)]]];
+	}
+
+	return (string);
+}
+
+#pragma mark - Equivalence
+- (void)testByteCountEquivalence
+{
+	NSArray<NSString *> *fixedCases = @[ @"", @"10mb", @"10MB", @"1GiB", @"kb", @"b", @"-5kb", @"+3", @"007TB", @"1.5gb", @"tib", @" 5mb", @"5 mb", @"12345678901234567890gb", @"٣mb", @"10mö" ];
+
+	for (NSString *string in fixedCases)
+	{
+		XCTAssertEqualObjects(string.byteCountNumber, string.referenceByteCountNumber, @"for \"%@\"", string);
+	}
+
+	srand48(47);
+
+	for (NSUInteger idx=0; idx < 100000; idx++)
+	{
+		NSString *string = [self randomStringFromAlphabet:@"0123456789tgmkibTGMKIB-+ .xö" maxLength:12];
+
+		XCTAssertEqualObjects(string.byteCountNumber, string.referenceByteCountNumber, @"for \"%@\"", string);
+	}
+}
+
+- (void)testKeywordDateEquivalence
+{
+	NSArray<NSString *> *fixedCases = @[ @"", @"2024", @"2024-1", @"2024-01", @"2024-01-31", @"2024-02-30", @"2024-13", @"2024-00-00", @"2024-", @"2024-1-", @"2024--1", @"24-01-01", @"20245", @"2024-001", @"2024-01-01-01", @"abcd-01", @"２０２４" ];
+
+	for (NSString *string in fixedCases)
+	{
+		XCTAssertEqualObjects([NSDate dateFromKeywordString:string], [NSDate computeDateFromKeywordString:string], @"for \"%@\"", string);
+	}
+
+	srand48(47);
+
+	for (NSUInteger idx=0; idx < 20000; idx++)
+	{
+		NSString *string = [self randomStringFromAlphabet:@"0123456789------a" maxLength:11];
+
+		XCTAssertEqualObjects([NSDate dateFromKeywordString:string], [NSDate computeDateFromKeywordString:string], @"for \"%@\"", string);
+	}
+}
+
+- (void)testRelativeDateEquivalence
+{
+	[NSDate flushComputedTimes];
+
+	for (NSInteger offset=-30; offset <= 30; offset++)
+	{
+		XCTAssertEqualObjects([NSDate startOfRelativeDay:offset], [NSDate computeStartOfRelativeDay:offset]);
+		XCTAssertEqualObjects([NSDate startOfRelativeWeek:offset], [NSDate computeStartOfRelativeWeek:offset]);
+		XCTAssertEqualObjects([NSDate startOfRelativeMonth:offset], [NSDate computeStartOfRelativeMonth:offset]);
+		XCTAssertEqualObjects([NSDate startOfRelativeYear:offset], [NSDate computeStartOfRelativeYear:offset]);
+
+		// Cached
+		XCTAssertEqual([NSDate startOfRelativeDay:offset], [NSDate startOfRelativeDay:offset]);
+	}
+}
+
+- (void)testRelativeDayAcrossDSTTransition
+{
+	NSCalendar *calendar = [NSCalendar calendarWithIdentifier:NSCalendarIdentifierGregorian];
+	NSDateComponents *components = [NSDateComponents new];
+
+	calendar.timeZone = [NSTimeZone timeZoneWithName:@"America/New_York"];
+
+	// Evening before the 23 hour day of March 8, 2026
+	components.year = 2026;
+	components.month = 3;
+	components.day = 7;
+	components.hour = 23;
+	components.minute = 30;
+
+	NSDate *eveningBeforeDSTStart = [calendar dateFromComponents:components];
+
+	components.hour = 0;
+	components.minute = 0;
+
+	for (NSNumber *dayOffset in @[ @(-1), @(0), @(1), @(2) ])
+	{
+		components.day = 7 + dayOffset.integerValue;
+
+		XCTAssertEqualObjects([NSDate _startOfDay:dayOffset.integerValue relativeToDate:eveningBeforeDSTStart calendar:calendar], [calendar dateFromComponents:components]);
+	}
+
+	// Start of the day following the 23 hour day is only 23 hours after the start of that day
+	XCTAssertEqual([[NSDate _startOfDay:2 relativeToDate:eveningBeforeDSTStart calendar:calendar] timeIntervalSinceDate:[NSDate _startOfDay:1 relativeToDate:eveningBeforeDSTStart calendar:calendar]], 23 * 60 * 60);
+}
+
+#pragma mark - Benchmarks
+static NSArray<NSString *> *sByteCountSamples;
+static NSArray<NSString *> *sDateSamples;
+
++ (void)setUp
+{
+	sByteCountSamples = @[ @"10mb", @"100MB", @"500mb", @"1gb", @"2GiB", @"750kb", @"4096", @"3tb", @"12b", @"640KiB" ];
+	sDateSamples = @[ @"2024", @"2024-06", @"2024-06-30", @"2026-1-1", @"2025-12-24", @"2023-02", @"2026-10-19", @"2019", @"2022-7-4", @"2021-11-11" ];
+}
+
+- (void)testByteCountThroughputReference
+{
+	[self measureBlock:^{
+		for (NSUInteger pass=0; pass < 10000; pass++)
+		{
+			for (NSString *sample in sByteCountSamples)
+			{
+				[sample referenceByteCountNumber];
+			}
+		}
+	}];
+}
+
+- (void)testByteCountThroughputFast
+{
+	[self measureBlock:^{
+		for (NSUInteger pass=0; pass < 10000; pass++)
+		{
+			for (NSString *sample in sByteCountSamples)
+			{
+				[sample byteCountNumber];
+			}
+		}
+	}];
+}
+
+- (void)testDateThroughputReference
+{
+	[self measureBlock:^{
+		for (NSUInteger pass=0; pass < 1000; pass++)
+		{
+			for (NSString *sample in sDateSamples)
+			{
+				[NSDate computeDateFromKeywordString:sample];
+			}
+
+			[NSDate computeStartOfRelativeDay:-7];
+			[NSDate computeStartOfRelativeWeek:0];
+			[NSDate computeStartOfRelativeMonth:-1];
+			[NSDate computeStartOfRelativeYear:0];
+		}
+	}];
+}
+
+- (void)testDateThroughputFast
+{
+	[self measureBlock:^{
+		for (NSUInteger pass=0; pass < 1000; pass++)
+		{
+			for (NSString *sample in sDateSamples)
+			{
+				[NSDate dateFromKeywordString:sample];
+			}
+
+			[NSDate startOfRelativeDay:-7];
+			[NSDate startOfRelativeWeek:0];
+			[NSDate startOfRelativeMonth:-1];
+			[NSDate startOfRelativeYear:0];
+		}
+	}];
+}
+
+@end
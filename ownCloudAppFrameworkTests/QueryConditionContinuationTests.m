@@ -0,0 +1,295 @@
+//
+//  QueryConditionContinuationTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface QueryConditionContinuationTests : XCTestCase
+@end
+
+@implementation QueryConditionContinuationTests
+
+/// Items sorted by name, with every name used three times so that ties span page boundaries
+- (NSArray<OCItem *> *)makeSortedItems:(NSUInteger)count
+{
+	return ([self makeSortedItems:count itemsPerName:3]);
+}
+
+- (NSArray<OCItem *> *)makeSortedItems:(NSUInteger)count itemsPerName:(NSUInteger)itemsPerName
+{
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+
+	for (NSUInteger idx=0; idx < count; idx++)
+	{
+		OCItem *item = [OCItem new];
+
+		item.type = OCItemTypeFile;
+		item.name = [NSString stringWithFormat:@"file-%06lu.txt", (unsigned long)(idx / itemsPerName)];
+		item.path = [@"/" stringByAppendingString:item.name];
+		item.localID = [NSString stringWithFormat:@"id-%06lu", (unsigned long)idx];
+		item.size = (NSInteger)idx;
+
+		[items addObject:item];
+	}
+
+	return (items);
+}
+
+/// Emulates an indexed database query: seeks to `startIndex` in the sort index, then evaluates the condition row by row until `maxResultCount` matches are found.
+/// Conditions sorted by local ID (tie runs) are evaluated on the run of items sharing the name at `startIndex`, sorted by local ID.
+- (NSArray<OCItem *> *)runCondition:(OCQueryCondition *)condition onSortedItems:(NSArray<OCItem *> *)sortedItems startIndex:(NSUInteger)startIndex evaluations:(NSUInteger *)outEvaluations
+{
+	NSMutableArray<OCItem *> *results = [NSMutableArray new];
+	NSUInteger maxResultCount = condition.maxResultCount.unsignedIntegerValue;
+
+	if ([condition.sortBy isEqual:OCItemPropertyNameLocalID])
+	{
+		NSString *name = sortedItems[startIndex].name;
+
+		for (NSUInteger idx=startIndex; (idx < sortedItems.count) && [sortedItems[idx].name isEqual:name]; idx++)
+		{
+			(*outEvaluations)++;
+
+			if ([condition fulfilledByItem:sortedItems[idx]])
+			{
+				[results addObject:sortedItems[idx]];
+			}
+		}
+
+		[results sortUsingDescriptors:@[ [NSSortDescriptor sortDescriptorWithKey:@"localID" ascending:YES] ]];
+
+		return ((results.count > maxResultCount) ? [results subarrayWithRange:NSMakeRange(0, maxResultCount)] : results);
+	}
+
+	for (NSUInteger idx=startIndex; (idx < sortedItems.count) && (results.count < maxResultCount); idx++)
+	{
+		(*outEvaluations)++;
+
+		if ([condition fulfilledByItem:sortedItems[idx]])
+		{
+			[results addObject:sortedItems[idx]];
+		}
+	}
+
+	return (results);
+}
+
+/// Index of the first item that doesn't sort before `name`
+- (NSUInteger)seekIndexForName:(NSString *)name inSortedItems:(NSArray<OCItem *> *)sortedItems ascending:(BOOL)ascending
+{
+	NSUInteger low = 0, high = sortedItems.count;
+
+	while (low < high)
+	{
+		NSUInteger mid = (low + high) / 2;
+		NSComparisonResult result = [sortedItems[mid].name compare:name];
+
+		if (ascending ? (result == NSOrderedAscending) : (result == NSOrderedDescending))
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return (low);
+}
+
+- (OCQueryCondition *)baseConditionAscending:(BOOL)ascending pageSize:(NSUInteger)pageSize
+{
+	OCQueryCondition *condition = [OCQueryCondition where:OCItemPropertyNameName startsWith:@"file-"];
+
+	condition.sortBy = OCItemPropertyNameName;
+	condition.sortAscending = ascending;
+	condition.maxResultCount = @(pageSize);
+
+	return (condition);
+}
+
+- (NSArray<OCItem *> *)pageWithContinuation:(OCQueryCondition *)baseCondition sortedItems:(NSArray<OCItem *> *)sortedItems pageCount:(NSUInteger *)outPageCount evaluations:(NSUInteger *)outEvaluations
+{
+	NSMutableArray<OCItem *> *returnedItems = [NSMutableArray new];
+	NSMutableArray<OCItem *> *pageItems = [NSMutableArray new];
+	NSMutableSet<OCLocalID> *returnedLocalIDs = [NSMutableSet new];
+	OCQueryCondition *pageCondition = baseCondition;
+	NSArray<OCItem *> *page = [self runCondition:baseCondition onSortedItems:sortedItems startIndex:0 evaluations:outEvaluations];
+
+	*outPageCount = 1;
+
+	while (YES)
+	{
+		[pageItems addObjectsFromArray:page];
+
+		// Skip tied items returned again
+		for (OCItem *item in page)
+		{
+			if (![returnedLocalIDs containsObject:item.localID])
+			{
+				[returnedLocalIDs addObject:item.localID];
+				[returnedItems addObject:item];
+			}
+		}
+
+		OCQueryCondition *continuationCondition;
+
+		if ((continuationCondition = [baseCondition continuationConditionAfterItems:pageItems page:page ofCondition:pageCondition]) == nil)
+		{
+			break;
+		}
+
+		NSUInteger startIndex = [self seekIndexForName:pageItems.lastObject.name inSortedItems:sortedItems ascending:baseCondition.sortAscending];
+
+		page = [self runCondition:continuationCondition onSortedItems:sortedItems startIndex:startIndex evaluations:outEvaluations];
+		pageCondition = continuationCondition;
+		(*outPageCount)++;
+	}
+
+	return (returnedItems);
+}
+
+- (NSArray<OCItem *> *)pageWithGrowingLimit:(OCQueryCondition *)baseCondition sortedItems:(NSArray<OCItem *> *)sortedItems pageCount:(NSUInteger *)outPageCount evaluations:(NSUInteger *)outEvaluations
+{
+	NSUInteger pageSize = baseCondition.maxResultCount.unsignedIntegerValue;
+	NSArray<OCItem *> *results = nil;
+
+	*outPageCount = 0;
+
+	do
+	{
+		(*outPageCount)++;
+		baseCondition.maxResultCount = @(pageSize * (*outPageCount));
+		results = [self runCondition:baseCondition onSortedItems:sortedItems startIndex:0 evaluations:outEvaluations];
+	} while (results.count == baseCondition.maxResultCount.unsignedIntegerValue);
+
+	baseCondition.maxResultCount = @(pageSize);
+
+	return (results);
+}
+
+#pragma mark - Tests
+- (void)testContinuationReturnsAllItemsOnce
+{
+	NSArray<OCItem *> *items = [self makeSortedItems:1000];
+
+	for (NSNumber *ascending in @[ @(YES), @(NO) ])
+	{
+		NSArray<OCItem *> *sortedItems = ascending.boolValue ? items : items.reverseObjectEnumerator.allObjects;
+		NSUInteger pageCount = 0, evaluations = 0;
+
+		// Page size of 7 ensures ties (3 items per name) regularly span page boundaries
+		NSArray<OCItem *> *returnedItems = [self pageWithContinuation:[self baseConditionAscending:ascending.boolValue pageSize:7] sortedItems:sortedItems pageCount:&pageCount evaluations:&evaluations];
+
+		XCTAssertEqual(returnedItems.count, items.count);
+		XCTAssertEqual([NSSet setWithArray:[returnedItems valueForKey:@"localID"]].count, items.count);
+		XCTAssertEqualObjects([returnedItems valueForKey:@"name"], [sortedItems valueForKey:@"name"]);
+	}
+}
+
+- (void)testContinuationPagesThroughLongTieRuns
+{
+	for (NSNumber *itemsPerName in @[ @(50), @(1000) ])
+	{
+		NSArray<OCItem *> *items = [self makeSortedItems:1000 itemsPerName:itemsPerName.unsignedIntegerValue];
+
+		for (NSNumber *ascending in @[ @(YES), @(NO) ])
+		{
+			NSArray<OCItem *> *sortedItems = ascending.boolValue ? items : items.reverseObjectEnumerator.allObjects;
+			NSUInteger pageCount = 0, evaluations = 0;
+
+			// Tie runs span several pages
+			NSArray<OCItem *> *returnedItems = [self pageWithContinuation:[self baseConditionAscending:ascending.boolValue pageSize:7] sortedItems:sortedItems pageCount:&pageCount evaluations:&evaluations];
+
+			XCTAssertEqual(returnedItems.count, items.count);
+			XCTAssertEqual([NSSet setWithArray:[returnedItems valueForKey:@"localID"]].count, items.count);
+			XCTAssertEqualObjects([returnedItems valueForKey:@"name"], [sortedItems valueForKey:@"name"]);
+		}
+	}
+}
+
+- (void)testContinuationOfTieRunUsesLastLocalID
+{
+	OCQueryCondition *condition = [self baseConditionAscending:YES pageSize:10];
+	NSArray<OCItem *> *items = [self makeSortedItems:30 itemsPerName:30];
+	NSArray<OCItem *> *firstPage = [items subarrayWithRange:NSMakeRange(0, 10)];
+
+	// A page consisting of tied items only continues with the entire tie run, sorted by local ID
+	OCQueryCondition *tieRunCondition = [condition continuationConditionAfterItems:firstPage page:firstPage ofCondition:condition];
+
+	XCTAssertEqualObjects(tieRunCondition.sortBy, OCItemPropertyNameLocalID);
+	XCTAssertTrue([tieRunCondition fulfilledByItem:items[0]]);
+
+	// The next page of the tie run starts after the last local ID, regardless of the number of tied items returned before
+	NSArray<OCItem *> *secondPage = [items subarrayWithRange:NSMakeRange(10, 10)];
+	OCQueryCondition *nextTieRunCondition = [condition continuationConditionAfterItems:[firstPage arrayByAddingObjectsFromArray:secondPage] page:secondPage ofCondition:tieRunCondition];
+
+	XCTAssertEqualObjects(nextTieRunCondition.sortBy, OCItemPropertyNameLocalID);
+	XCTAssertFalse([nextTieRunCondition fulfilledByItem:items[19]]);
+	XCTAssertTrue([nextTieRunCondition fulfilledByItem:items[20]]);
+
+	// Once the tie run is complete, continuation resumes with the items sorting after it
+	NSArray<OCItem *> *lastPage = [items subarrayWithRange:NSMakeRange(20, 5)];
+	OCQueryCondition *afterTieRunCondition = [condition continuationConditionAfterItems:lastPage page:lastPage ofCondition:nextTieRunCondition];
+
+	XCTAssertEqualObjects(afterTieRunCondition.sortBy, OCItemPropertyNameName);
+	XCTAssertFalse([afterTieRunCondition fulfilledByItem:items[29]]);
+}
+
+- (void)testContinuationRequiresSupportedSortProperty
+{
+	OCQueryCondition *condition = [self baseConditionAscending:YES pageSize:10];
+	NSArray<OCItem *> *items = [self makeSortedItems:10];
+
+	XCTAssertTrue(condition.supportsContinuation);
+	XCTAssertNotNil([condition continuationConditionAfterItems:items page:items ofCondition:condition]);
+	XCTAssertNil([condition continuationConditionAfterItems:@[] page:@[] ofCondition:condition]);
+	XCTAssertNil([condition continuationConditionAfterItems:items page:[items subarrayWithRange:NSMakeRange(0, 5)] ofCondition:condition]); // Short page: no more results
+
+	condition.sortBy = OCItemPropertyNameLastUsed;
+
+	XCTAssertFalse(condition.supportsContinuation);
+	XCTAssertNil([condition continuationConditionAfterItems:items page:items ofCondition:condition]);
+}
+
+#pragma mark - Benchmarks
+- (void)_measurePagingThrough:(NSUInteger)itemCount pageSize:(NSUInteger)pageSize continuation:(BOOL)continuation
+{
+	NSArray<OCItem *> *sortedItems = [self makeSortedItems:itemCount];
+	OCQueryCondition *baseCondition = [self baseConditionAscending:YES pageSize:pageSize];
+	__block NSUInteger pageCount = 0, evaluations = 0, returnedCount = 0;
+
+	[self measureBlock:^{
+		pageCount = 0;
+		evaluations = 0;
+
+		if (continuation)
+		{
+			returnedCount = [self pageWithContinuation:baseCondition sortedItems:sortedItems pageCount:&pageCount evaluations:&evaluations].count;
+		}
+		else
+		{
+			returnedCount = [self pageWithGrowingLimit:baseCondition sortedItems:sortedItems pageCount:&pageCount evaluations:&evaluations].count;
+		}
+	}];
+
+	XCTAssertEqual(returnedCount, itemCount);
+	XCTAssertEqual(pageCount, (itemCount / pageSize) + 1); // All full pages, plus the one that comes back short (with ties returned again at the start of each page)
+}
+
+- (void)testPagingPerformanceWithGrowingLimit
+{
+	[self _measurePagingThrough:100000 pageSize:5000 continuation:NO];
+}
+
+- (void)testPagingPerformanceWithContinuation
+{
+	[self _measurePagingThrough:100000 pageSize:5000 continuation:YES];
+}
+
+@end
@@ -0,0 +1,138 @@
+//
+//  SVGPathCacheTests.m
+//  ownCloudAppTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <ownCloudApp/ownCloudApp.h>
+
+@interface SVGPathCacheTests : XCTestCase
+@end
+
+@implementation SVGPathCacheTests
+
+/// Sample SVGs resembling avatars (initials on a colored circle) and branding logos (many path segments)
+- (NSArray<NSData *> *)makeSampleSVGs:(NSUInteger)count
+{
+	NSMutableArray<NSData *> *svgs = [NSMutableArray new];
+
+	for (NSUInteger idx=0; idx < count; idx++)
+	{
+		NSMutableString *svg = [NSMutableString stringWithFormat:@"<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 128 128\"><circle cx=\"64\" cy=\"64\" r=\"64\" fill=\"#%06lx\"/>", (unsigned long)((idx * 2654435761) & 0xFFFFFF)];
+
+		if ((idx % 2) == 1)
+		{
+			// Logo-like: long path with many curve segments
+			[svg appendString:@"<path fill=\"#ffffff\" d=\"M20 64"];
+
+			for (NSUInteger segment=0; segment < 200; segment++)
+			{
+				[svg appendFormat:@" C%lu %lu %lu %lu %lu %lu", (unsigned long)(20 + segment % 80), (unsigned long)(30 + (segment * 7) % 60), (unsigned long)(24 + segment % 80), (unsigned long)(40 + (segment * 13) % 50), (unsigned long)(28 + segment % 80), (unsigned long)(64 + (idx + segment) % 30)];
+			}
+
+			[svg appendString:@" Z\"/>"];
+		}
+		else
+		{
+			// Avatar-like: simple shapes
+			[svg appendFormat:@"<rect x=\"40\" y=\"%lu\" width=\"48\" height=\"12\" fill=\"#ffffff\"/><path d=\"M44 44 L84 44 L64 84 Z\" fill=\"#ffffff\"/>", (unsigned long)(70 + idx % 10)];
+		}
+
+		[svg appendString:@"</svg>"];
+
+		[svgs addObject:[svg dataUsingEncoding:NSUTF8StringEncoding]];
+	}
+
+	return (svgs);
+}
+
+#pragma mark - Tests
+- (void)testPathsAreParsedOncePerData
+{
+	OCSVGPathCache *cache = [OCSVGPathCache new];
+	NSArray<NSData *> *svgs = [self makeSampleSVGs:10];
+
+	NSArray *paths = [cache pathsForSVGData:svgs[0]];
+
+	XCTAssertGreaterThan(paths.count, 0);
+	XCTAssertEqual(cache.parseCount, 1);
+
+	// Same content in a different NSData instance
+	XCTAssertEqual([cache pathsForSVGData:[svgs[0] mutableCopy]], paths);
+	XCTAssertEqual(cache.parseCount, 1);
+
+	XCTAssertNotEqual([cache pathsForSVGData:svgs[1]], paths);
+	XCTAssertEqual(cache.parseCount, 2);
+
+	// Eviction
+	[cache removeAllObjects];
+	XCTAssertNotNil([cache pathsForSVGData:svgs[0]]);
+	XCTAssertEqual(cache.parseCount, 3);
+}
+
+- (void)testPrerasterization
+{
+	OCSVGPathCache *cache = [OCSVGPathCache new];
+	NSData *svg = [self makeSampleSVGs:1].firstObject;
+
+	cache.prerasterizationSizes = @[ @(CGSizeMake(32, 32)), @(CGSizeMake(48, 48)) ];
+
+	XCTAssertTrue([cache shouldPrerasterizeForSize:CGSizeMake(32, 32)]);
+	XCTAssertFalse([cache shouldPrerasterizeForSize:CGSizeMake(33, 32)]);
+
+	UIImage *image = [cache imageForSVGData:svg size:CGSizeMake(32, 32) scale:2];
+
+	XCTAssertNotNil(image);
+	XCTAssertEqual(image.size.width, 32);
+	XCTAssertEqual(image.scale, 2);
+	XCTAssertEqual([cache imageForSVGData:svg size:CGSizeMake(32, 32) scale:2], image);
+	XCTAssertNotEqual([cache imageForSVGData:svg size:CGSizeMake(32, 32) scale:3], image);
+	XCTAssertEqual(cache.parseCount, 1);
+}
+
+#pragma mark - Benchmarks
+- (void)testParsePerformance
+{
+	NSArray<NSData *> *svgs = [self makeSampleSVGs:50];
+
+	[self measureBlock:^{
+		// Previous behaviour: parse on every request, f.ex. for every cell while scrolling
+		for (NSUInteger pass=0; pass < 10; pass++)
+		{
+			OCSVGPathCache *cache = [OCSVGPathCache new];
+
+			for (NSData *svg in svgs)
+			{
+				[cache pathsForSVGData:svg];
+			}
+		}
+	}];
+}
+
+- (void)testCacheHitPerformance
+{
+	NSArray<NSData *> *svgs = [self makeSampleSVGs:50];
+	OCSVGPathCache *cache = [OCSVGPathCache new];
+
+	for (NSData *svg in svgs)
+	{
+		[cache pathsForSVGData:svg];
+	}
+
+	[self measureBlock:^{
+		for (NSUInteger pass=0; pass < 10; pass++)
+		{
+			for (NSData *svg in svgs)
+			{
+				[cache pathsForSVGData:svg];
+			}
+		}
+	}];
+
+	XCTAssertEqual(cache.parseCount, svgs.count);
+}
+
+@end
@@ -52,6 +52,8 @@ public class AppLockManager: NSObject {
 			} else {
 				_ = keychain?.removeItem(forAccount: keychainAccount, path: keychainLockedDate)
 			}
+
+			AppLockState.postStateChangeNotification()
 		}
 	}
 
@@ -67,6 +69,8 @@ public class AppLockManager: NSObject {
 		set(newValue) {
 			let archivedData = try? NSKeyedArchiver.archivedData(withRootObject: newValue as NSNumber, requiringSecureCoding: true)
 			keychain?.write(archivedData, toKeychainItemForAccount: keychainAccount, path: keychainUnlocked)
+
+			AppLockState.postStateChangeNotification()
 		}
 	}
 
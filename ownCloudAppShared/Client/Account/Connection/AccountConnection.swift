@@ -89,7 +89,6 @@ open class AccountConnection: NSObject {
 
 	public init(bookmark: OCBookmark) {
 		self.bookmark = bookmark
-		self.taskQueue = OCAsyncSequentialQueue(queue: AccountConnectionPool.shared.serialQueue)
 		self.progressSummarizer = ProgressSummarizer.shared(forBookmark: bookmark)
 
 		super.init()
@@ -104,10 +103,8 @@ open class AccountConnection: NSObject {
 	}
 
 	// MARK: - Queue
-	private var taskQueue: OCAsyncSequentialQueue
-
 	func queue(completion: CompletionHandler? = nil, _ block: @escaping (_ connection: AccountConnection, _ jobDone: @escaping () -> Void) -> Void) {
-		AccountConnectionPool.shared.taskQueue.async({ [weak self] (jobDone) in
+		AccountConnectionPool.shared.scheduler.schedule(for: bookmark.uuidString, { [weak self] (jobDone) in
 			guard let self = self else {
 				completion?(NSError(ocError: .internal))
 				jobDone()
@@ -229,12 +226,6 @@ open class AccountConnection: NSObject {
 				}
 			}, completionHandler: { (core, error) in
 				if error == nil {
-					// Start FP standby in 5 seconds regardless of connnection status
-					// (or below: after it's clear that authentication worked)
-					OnBackgroundQueue(async: true, after: 5.0) { [weak connection] in
-						connection?.startFPServiceStandbyIfNotRunning()
-					}
-
 					// Add default icons source to core's resource manager
 					OnMainThread { [weak core] in
 						if let core = core {
@@ -242,19 +233,36 @@ open class AccountConnection: NSObject {
 						}
 					}
 
+					// Provide materialized saved search results (only in the app)
+					if OCAppIdentity.shared.componentIdentifier == .app {
+						let generation = connection.savedSearchResultSetsGeneration
+
+						OnMainThread { [weak connection, weak core] in
+							// Skip if the connection was disconnected in the meantime
+							if let connection, let core, connection.savedSearchResultSetsGeneration == generation {
+								connection.savedSearchResultSets = SavedSearchResultSetManager(core: core)
+							}
+						}
+					}
+
 					// Connected
 					connection.status = .coreAvailable
 
+					// Start FP standby in 5 seconds regardless of connnection status
+					// (or earlier, from connection status changes - see fpServiceStandbyHandleConnectionStatus())
+					OnBackgroundQueue(async: true, after: 5.0) { [weak connection] in
+						connection?.startFPServiceStandbyIfNotRunning()
+					}
+
 					// Start showing connection status
 					OnMainThread { [weak connection] () in
+						connection?.resetFPServiceStandbyConnectionAttempt()
+
 						connection?.connectionStatusObservation = core?.observe(\OCCore.connectionStatus, options: [.initial], changeHandler: { [weak connection] (_, _) in
 							connection?.updateConnectionStatusSummary()
 
-							if let connectionStatus = connection?.core?.connectionStatus,
-							   connectionStatus == .online {
-								// Start FP service standby after it's clear that authentication worked
-								// (or above: after 5 seconds regardless of connnection status)
-								connection?.startFPServiceStandbyIfNotRunning()
+							if let connectionStatus = connection?.core?.connectionStatus {
+								connection?.fpServiceStandbyHandleConnectionStatus(connectionStatus)
 							}
 						})
 					}
@@ -294,19 +302,28 @@ open class AccountConnection: NSObject {
 
 			connection.fpServiceStandby?.stop()
 
-			// Return core
-			OCCoreManager.shared.returnCore(for: self.bookmark, completionHandler: { [weak self] in
-				connection.richStatus = nil
-				connection.core = nil
-				connection.status = .noCore
+			// Prevent creation of saved search result sets still pending from connect()
+			connection.invalidateSavedSearchResultSets()
 
-				self?.progressSummarizer.resetPrioritySummaries()
+			// Persist and stop saved search result sets on the main thread (where they are created), then return the core
+			OnMainThread {
+				connection.savedSearchResultSets?.shutdown()
+				connection.savedSearchResultSets = nil
 
-				OnMainThread {
-					completion?(nil)
-				}
-				jobDone()
-			})
+				// Return core
+				OCCoreManager.shared.returnCore(for: connection.bookmark, completionHandler: { [weak connection] in
+					connection?.richStatus = nil
+					connection?.core = nil
+					connection?.status = .noCore
+
+					connection?.progressSummarizer.resetPrioritySummaries()
+
+					OnMainThread {
+						completion?(nil)
+					}
+					jobDone()
+				})
+			}
 		}
 	}
 
@@ -444,9 +461,62 @@ open class AccountConnection: NSObject {
 		appProviderActionExtensions = actionExtensions
 	}
 
+	// MARK: - Saved search result sets
+	open var savedSearchResultSets: SavedSearchResultSetManager? // only accessed on the main thread
+
+	private var _savedSearchResultSetsGeneration: UInt = 0
+	var savedSearchResultSetsGeneration: UInt {
+		var generation: UInt = 0
+
+		OCSynchronized(self) {
+			generation = _savedSearchResultSetsGeneration
+		}
+
+		return generation
+	}
+
+	func invalidateSavedSearchResultSets() {
+		OCSynchronized(self) {
+			_savedSearchResultSetsGeneration += 1
+		}
+	}
+
 	// MARK: - FileProvider Service pinging
 	var fpServiceStandby : OCFileProviderServiceStandby?
 
+	var fpServiceStandbyAttemptedConnection: Bool = false // protected by self
+
+	func resetFPServiceStandbyConnectionAttempt() {
+		OCSynchronized(self) {
+			fpServiceStandbyAttemptedConnection = false
+		}
+	}
+
+	func fpServiceStandbyHandleConnectionStatus(_ connectionStatus: OCCoreConnectionStatus) {
+		var startStandby = false
+
+		OCSynchronized(self) {
+			switch connectionStatus {
+				case .connecting:
+					fpServiceStandbyAttemptedConnection = true
+
+				case .online:
+					// Start FP service standby after it's clear that authentication worked
+					startStandby = true
+
+				case .offline, .unavailable:
+					// Start FP service standby if the server turned out to be unreachable
+					startStandby = fpServiceStandbyAttemptedConnection
+
+				default: break
+			}
+		}
+
+		if startStandby {
+			startFPServiceStandbyIfNotRunning()
+		}
+	}
+
 	func startFPServiceStandbyIfNotRunning() {
 		// Set up FP standby
 		OCSynchronized(self) {
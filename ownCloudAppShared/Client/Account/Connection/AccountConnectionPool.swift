@@ -26,11 +26,21 @@ public class AccountConnectionPool: NSObject {
 
 	var connectionsByBookmarkUUID: [String:AccountConnection] = [:]
 
-	var taskQueue: OCAsyncSequentialQueue
-	let serialQueue = DispatchQueue(label: "com.owncloud.connection-pool")
+	let scheduler: AccountConnectionScheduler
 
-	public override init() {
-		taskQueue = OCAsyncSequentialQueue(queue: serialQueue)
+	/// Maximum number of connections that can be established/torn down at the same time. Tasks for the same account are always performed one after another.
+	public var maximumConcurrentConnections: Int {
+		get {
+			return scheduler.maximumConcurrentJobs
+		}
+
+		set {
+			scheduler.maximumConcurrentJobs = max(1, newValue)
+		}
+	}
+
+	public init(maximumConcurrentConnections: Int = 3) {
+		scheduler = AccountConnectionScheduler(maximumConcurrentJobs: maximumConcurrentConnections)
 
 		super.init()
 	}
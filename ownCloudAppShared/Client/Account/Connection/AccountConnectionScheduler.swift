@@ -0,0 +1,111 @@
+//
+//  AccountConnectionScheduler.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import ownCloudSDK
+
+/// Runs jobs for the same key (f.ex. a bookmark UUID) sequentially and in order, while jobs for different keys run concurrently, up to `maximumConcurrentJobs` at a time. The next job is started as soon as a running job signals completion via its `jobDone` block.
+public class AccountConnectionScheduler: NSObject {
+	public typealias Job = (_ jobDone: @escaping () -> Void) -> Void
+
+	struct ScheduledJob {
+		var key: String
+		var job: Job
+	}
+
+	public var maximumConcurrentJobs: Int {
+		didSet {
+			runNextJobs()
+		}
+	}
+
+	private let executionQueue: DispatchQueue
+	private var pendingJobs: [ScheduledJob] = []
+	private var runningKeys: Set<String> = []
+
+	public init(maximumConcurrentJobs: Int = 3, queue: DispatchQueue? = nil) {
+		self.maximumConcurrentJobs = max(1, maximumConcurrentJobs)
+		self.executionQueue = queue ?? DispatchQueue(label: "com.owncloud.connection-scheduler", attributes: .concurrent)
+
+		super.init()
+	}
+
+	public var runningJobCount: Int {
+		var count = 0
+
+		OCSynchronized(self) {
+			count = runningKeys.count
+		}
+
+		return count
+	}
+
+	public func schedule(for key: String, _ job: @escaping Job) {
+		OCSynchronized(self) {
+			pendingJobs.append(ScheduledJob(key: key, job: job))
+		}
+
+		runNextJobs()
+	}
+
+	private func runNextJobs() {
+		var startJobs: [ScheduledJob] = []
+
+		OCSynchronized(self) {
+			var idx = 0
+
+			while idx < pendingJobs.count, runningKeys.count < maximumConcurrentJobs {
+				let scheduledJob = pendingJobs[idx]
+
+				if runningKeys.contains(scheduledJob.key) {
+					// A job for the same key is already running - keep this one (and those after it) in order
+					idx += 1
+					continue
+				}
+
+				runningKeys.insert(scheduledJob.key)
+				pendingJobs.remove(at: idx)
+				startJobs.append(scheduledJob)
+			}
+		}
+
+		for scheduledJob in startJobs {
+			executionQueue.async {
+				var isDone = false
+
+				scheduledJob.job({ [weak self] in
+					guard let self else { return }
+
+					var finished = false
+
+					OCSynchronized(self) {
+						if !isDone {
+							isDone = true
+							finished = true
+							self.runningKeys.remove(scheduledJob.key)
+						}
+					}
+
+					if finished {
+						self.runNextJobs()
+					}
+				})
+			}
+		}
+	}
+}
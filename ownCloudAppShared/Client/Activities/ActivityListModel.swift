@@ -0,0 +1,189 @@
+//
+//  ActivityListModel.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+
+/// Calls its handler at most once per display frame, no matter how often `setNeedsUpdate()` is called in between.
+public class DisplayFrameCoalescer : NSObject {
+	private var displayLink: CADisplayLink?
+	private var handler: () -> Void
+
+	public init(handler: @escaping () -> Void) {
+		self.handler = handler
+		super.init()
+	}
+
+	deinit {
+		displayLink?.invalidate()
+	}
+
+	public func setNeedsUpdate() {
+		if displayLink == nil {
+			// The display link retains its target: it is invalidated after the next frame, releasing the coalescer again
+			displayLink = CADisplayLink(target: self, selector: #selector(displayLinkFired))
+			displayLink?.add(to: .main, forMode: .common)
+		}
+	}
+
+	public func cancel() {
+		displayLink?.invalidate()
+		displayLink = nil
+	}
+
+	@objc private func displayLinkFired() {
+		cancel()
+		handler()
+	}
+}
+
+/// Keeps a list of elements (f.ex. activities) in sync with a source, collecting change notifications and applying them as one minimal diff.
+/// Rows are looked up by identifier in O(1).
+public class ActivityListModel<Element> {
+	public struct Changes {
+		public var deletedRows: [Int] = []	//!< Rows to delete, relative to the elements before the update
+		public var insertedRows: [Int] = []	//!< Rows to insert, relative to the elements after the update
+		public var reloadedRows: [Int] = []	//!< Rows to reload, relative to the elements before the update
+		public var requiresFullReload: Bool = false
+
+		public var isEmpty: Bool {
+			return deletedRows.isEmpty && insertedRows.isEmpty && reloadedRows.isEmpty && !requiresFullReload
+		}
+	}
+
+	public private(set) var elements: [Element] = []
+	private var rowByIdentifier: [String : Int] = [:]
+
+	private var identifierProvider: (Element) -> String
+	private var elementsProvider: () -> [Element]
+
+	private var needsElementsUpdate: Bool = false
+	private var updatedIdentifiers: Set<String> = []
+
+	public init(identifier identifierProvider: @escaping (Element) -> String, elements elementsProvider: @escaping () -> [Element]) {
+		self.identifierProvider = identifierProvider
+		self.elementsProvider = elementsProvider
+	}
+
+	// MARK: - Lookup
+	public func row(for identifier: String) -> Int? {
+		return rowByIdentifier[identifier]
+	}
+
+	// MARK: - Change collection
+	public var hasPendingChanges: Bool {
+		return needsElementsUpdate || !updatedIdentifiers.isEmpty
+	}
+
+	/// Elements were added or removed: the list will be re-fetched from the source with the next `applyPendingChanges()`
+	public func setNeedsElementsUpdate() {
+		needsElementsUpdate = true
+	}
+
+	/// Properties of the element with the identifier changed: its row will be reloaded with the next `applyPendingChanges()`
+	public func elementUpdated(identifier: String) {
+		updatedIdentifiers.insert(identifier)
+	}
+
+	// MARK: - Applying changes
+	/// Discards pending changes and replaces the elements with the source's elements
+	public func reload() {
+		needsElementsUpdate = false
+		updatedIdentifiers.removeAll()
+
+		setElements(elementsProvider())
+	}
+
+	/// Applies all changes collected since the last call and returns them as a minimal diff
+	public func applyPendingChanges() -> Changes {
+		var changes = Changes()
+
+		if needsElementsUpdate {
+			let newElements = elementsProvider()
+			let newIdentifiers = newElements.map(identifierProvider)
+			let newIdentifierSet = Set(newIdentifiers)
+			var retainedOldIdentifiers: [String] = []
+
+			retainedOldIdentifiers.reserveCapacity(newIdentifiers.count)
+
+			for (row, element) in elements.enumerated() {
+				let identifier = identifierProvider(element)
+
+				if newIdentifierSet.contains(identifier) {
+					retainedOldIdentifiers.append(identifier)
+
+					if updatedIdentifiers.contains(identifier) {
+						changes.reloadedRows.append(row)
+					}
+				} else {
+					changes.deletedRows.append(row)
+				}
+			}
+
+			var retainedNewIdentifiers: [String] = []
+
+			retainedNewIdentifiers.reserveCapacity(retainedOldIdentifiers.count)
+
+			for (row, identifier) in newIdentifiers.enumerated() {
+				if rowByIdentifier[identifier] != nil {
+					retainedNewIdentifiers.append(identifier)
+				} else {
+					changes.insertedRows.append(row)
+				}
+			}
+
+			// Elements that remained must keep their relative order, otherwise moves would be needed
+			if retainedOldIdentifiers != retainedNewIdentifiers {
+				changes = Changes(requiresFullReload: true)
+			}
+
+			setElements(newElements, identifiers: newIdentifiers)
+		} else {
+			changes.reloadedRows = updatedIdentifiers.compactMap { rowByIdentifier[$0] }.sorted()
+		}
+
+		needsElementsUpdate = false
+		updatedIdentifiers.removeAll()
+
+		return changes
+	}
+
+	private func setElements(_ newElements: [Element], identifiers: [String]? = nil) {
+		let identifiers = identifiers ?? newElements.map(identifierProvider)
+
+		elements = newElements
+		rowByIdentifier = Dictionary(zip(identifiers, identifiers.indices), uniquingKeysWith: { (first, _) in first })
+	}
+}
+
+public extension UITableView {
+	/// Applies `changes` to the rows of `section`
+	func apply<Element>(_ changes: ActivityListModel<Element>.Changes, in section: Int) {
+		if changes.requiresFullReload {
+			reloadData()
+			return
+		}
+
+		guard !changes.isEmpty else { return }
+
+		performBatchUpdates({
+			deleteRows(at: changes.deletedRows.map({ IndexPath(row: $0, section: section) }), with: .fade)
+			insertRows(at: changes.insertedRows.map({ IndexPath(row: $0, section: section) }), with: .fade)
+			reloadRows(at: changes.reloadedRows.map({ IndexPath(row: $0, section: section) }), with: .none)
+		})
+	}
+}
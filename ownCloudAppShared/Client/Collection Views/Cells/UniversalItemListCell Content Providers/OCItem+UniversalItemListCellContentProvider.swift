@@ -166,7 +166,7 @@ extension OCItem: UniversalItemListCellContentProvider {
 		}
 
 		// Icon
-		content.icon = .resource(request: OCResourceRequestItemThumbnail.request(for: self, maximumSize: thumbnailSize, scale: 0, waitForConnectivity: true, changeHandler: nil))
+		content.icon = .resource(request: context?.thumbnailPrefetcher?.claimRequest(for: self, maximumSize: thumbnailSize) ?? OCResourceRequestItemThumbnail.request(for: self, maximumSize: thumbnailSize, scale: 0, waitForConnectivity: true, changeHandler: nil))
 		content.iconDisabled = isPlaceholder
 
 		// Title
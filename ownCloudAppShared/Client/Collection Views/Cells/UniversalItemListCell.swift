@@ -561,8 +561,8 @@ open class UniversalItemListCell: ThemeableCollectionViewListCell {
 					iconView.activeViewProvider = iconViewProvider
 				}
 
-				if let iconRequest {
-					// Start new resource request
+				if let iconRequest, clientContext?.thumbnailPrefetcher?.hasStarted(request: iconRequest) != true {
+					// Start new resource request (unless already started by the thumbnail prefetcher)
 					clientContext?.core?.vault.resourceManager?.start(iconRequest)
 				}
 			}
@@ -20,7 +20,7 @@ import UIKit
 import ownCloudApp
 import ownCloudSDK
 
-open class CollectionViewController: UIViewController, UICollectionViewDelegate, UICollectionViewDragDelegate, UICollectionViewDropDelegate, Themeable, ThemeCSSAutoSelector {
+open class CollectionViewController: UIViewController, UICollectionViewDelegate, UICollectionViewDataSourcePrefetching, UICollectionViewDragDelegate, UICollectionViewDropDelegate, Themeable, ThemeCSSAutoSelector {
 	public var clientContext: ClientContext?
 
 	public var supportsHierarchicContent: Bool
@@ -53,6 +53,11 @@ open class CollectionViewController: UIViewController, UICollectionViewDelegate,
 			context.originatingViewController = self
 		})
 
+		if let resourceManager = clientContext?.core?.vault.resourceManager {
+			thumbnailPrefetcher = ThumbnailPrefetcher(resourceManager: resourceManager)
+			clientContext?.thumbnailPrefetcher = thumbnailPrefetcher
+		}
+
 		if let core = clientContext?.core {
 			self.navigationItem.title = core.bookmark.shortName
 		}
@@ -209,6 +214,7 @@ open class CollectionViewController: UIViewController, UICollectionViewDelegate,
 			collectionView.contentInsetAdjustmentBehavior = .never
 			collectionView.contentInset = .zero
 			collectionView.delegate = self
+			collectionView.prefetchDataSource = self
 			collectionView.dragDelegate = self
 			collectionView.dropDelegate = self
 			collectionView.dragInteractionEnabled = dragInteractionEnabled
@@ -788,6 +794,43 @@ open class CollectionViewController: UIViewController, UICollectionViewDelegate,
 		return indexPaths
 	}
 
+	// MARK: - Prefetching
+	public var thumbnailPrefetcher: ThumbnailPrefetcher?
+
+	public func collectionView(_ collectionView: UICollectionView, prefetchItemsAt indexPaths: [IndexPath]) {
+		guard let thumbnailPrefetcher else { return }
+
+		var prefetchItems: [(item: OCItem, indexPath: IndexPath?)] = []
+
+		for indexPath in indexPaths {
+			retrieveItem(at: indexPath, synchronous: true, action: { record, indexPath, _ in
+				if let item = record.item as? OCItem {
+					prefetchItems.append((item: item, indexPath: indexPath))
+				}
+			})
+		}
+
+		if prefetchItems.count > 0 {
+			thumbnailPrefetcher.prefetch(items: prefetchItems)
+		}
+	}
+
+	public func collectionView(_ collectionView: UICollectionView, cancelPrefetchingForItemsAt indexPaths: [IndexPath]) {
+		guard let thumbnailPrefetcher else { return }
+
+		var cancelItems: [OCItem] = []
+
+		for indexPath in indexPaths {
+			retrieveItem(at: indexPath, synchronous: true, action: { record, _, _ in
+				if let item = record.item as? OCItem {
+					cancelItems.append(item)
+				}
+			})
+		}
+
+		thumbnailPrefetcher.cancelPrefetching(items: cancelItems)
+	}
+
 	// MARK: - Expand / Collapse
 //	public func expandCollapse(_ collectionViewItemRef: CollectionViewController.ItemRef) {
 //		let (_, sectionID) = unwrap(collectionViewItemRef)
@@ -0,0 +1,270 @@
+//
+//  ThumbnailPrefetcher.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+
+public protocol ThumbnailPrefetchResourceManager: AnyObject {
+	func start(_ request: OCResourceRequest)
+	func stop(_ request: OCResourceRequest)
+}
+
+extension OCResourceManager: ThumbnailPrefetchResourceManager {
+}
+
+open class ThumbnailPrefetcher: NSObject, OCResourceRequestDelegate {
+	public typealias RequestKey = String
+
+	public struct Statistics {
+		public var startedRequests: Int = 0	// Prefetch requests actually started
+		public var deduplicatedRequests: Int = 0	// Prefetch attempts for which a request was already queued, running or completed
+		public var cancelledRequests: Int = 0	// Prefetch requests cancelled before a cell claimed them
+		public var hits: Int = 0		// Cells that could use a prefetched request
+		public var misses: Int = 0		// Cells that had to create their own request
+
+		public var hitRate: Double {
+			return (hits + misses) > 0 ? Double(hits) / Double(hits + misses) : 0
+		}
+	}
+
+	enum Direction {
+		case unknown
+		case forward
+		case backward
+	}
+
+	class Entry {
+		var request: OCResourceRequest
+		var indexPath: IndexPath?
+		var isStarted: Bool = false
+		var isCompleted: Bool = false
+
+		init(request: OCResourceRequest, indexPath: IndexPath?) {
+			self.request = request
+			self.indexPath = indexPath
+		}
+	}
+
+	public weak var resourceManager: ThumbnailPrefetchResourceManager?
+	public var thumbnailSize: CGSize
+	public var maximumConcurrentRequests: Int = 24
+	public var maximumRetainedCompletedRequests: Int = 200
+
+	public private(set) var statistics = Statistics()
+
+	private var entriesByKey: [RequestKey : Entry] = [:]
+	private var queuedKeys: [RequestKey] = []
+	private var completedKeys: [RequestKey] = []
+	private var runningCount: Int = 0
+	private var flushScheduled: Bool = false
+
+	private var claimedRequests: NSHashTable<OCResourceRequest> = NSHashTable.weakObjects()
+
+	private var lastPrefetchedIndexPath: IndexPath?
+	private var direction: Direction = .unknown
+
+	public init(resourceManager: ThumbnailPrefetchResourceManager?, thumbnailSize: CGSize = CGSize(width: 60, height: 60)) {
+		self.resourceManager = resourceManager
+		self.thumbnailSize = thumbnailSize
+		super.init()
+	}
+
+	deinit {
+		for entry in entriesByKey.values where entry.isStarted && !entry.isCompleted {
+			resourceManager?.stop(entry.request)
+		}
+	}
+
+	// MARK: - Keys
+	public func requestKey(for item: OCItem, maximumSize: CGSize) -> RequestKey? {
+		guard let localID = item.localID else { return nil }
+
+		return "\(localID):\(item.eTag ?? ""):\(Int(maximumSize.width))x\(Int(maximumSize.height))"
+	}
+
+	// MARK: - Prefetching
+	/// Queues thumbnail requests for the passed items. Must be called on the main thread. Requests are started in batches on the next main runloop iteration. If the scrolling direction changed since the last call, outstanding requests for items not part of this batch are cancelled.
+	public func prefetch(items: [(item: OCItem, indexPath: IndexPath?)]) {
+		let sortedIndexPaths = items.compactMap({ $0.indexPath }).sorted()
+
+		// Detect direction changes
+		if let firstIndexPath = sortedIndexPaths.first, let lastIndexPath = sortedIndexPaths.last, let lastPrefetchedIndexPath {
+			var newDirection = direction
+
+			if firstIndexPath > lastPrefetchedIndexPath {
+				newDirection = .forward
+			} else if lastIndexPath < lastPrefetchedIndexPath {
+				newDirection = .backward
+			}
+
+			if direction != .unknown, newDirection != direction {
+				let keepKeys = Set(items.compactMap({ requestKey(for: $0.item, maximumSize: thumbnailSize) }))
+				cancelOutstanding(except: keepKeys)
+			}
+
+			direction = newDirection
+		}
+
+		if let indexPath = (direction == .backward) ? sortedIndexPaths.first : sortedIndexPaths.last {
+			lastPrefetchedIndexPath = indexPath
+		}
+
+		// Queue new requests
+		for (item, indexPath) in items {
+			if item.type == .collection {
+				continue
+			}
+
+			guard let key = requestKey(for: item, maximumSize: thumbnailSize) else { continue }
+
+			if entriesByKey[key] != nil {
+				statistics.deduplicatedRequests += 1
+				continue
+			}
+
+			let request: OCResourceRequest = OCResourceRequestItemThumbnail.request(for: item, maximumSize: thumbnailSize, scale: 0, waitForConnectivity: true, changeHandler: nil)
+
+			entriesByKey[key] = Entry(request: request, indexPath: indexPath)
+			queuedKeys.append(key)
+		}
+
+		scheduleFlush()
+	}
+
+	/// Cancels queued or running requests for the passed items, f.ex. because UICollectionView no longer expects them to become visible.
+	public func cancelPrefetching(items: [OCItem]) {
+		for item in items {
+			if let key = requestKey(for: item, maximumSize: thumbnailSize) {
+				cancel(key: key)
+			}
+		}
+	}
+
+	public func cancelAll() {
+		cancelOutstanding(except: [])
+	}
+
+	private func cancelOutstanding(except keepKeys: Set<RequestKey>) {
+		for (key, entry) in entriesByKey where !entry.isCompleted && !keepKeys.contains(key) {
+			cancel(key: key)
+		}
+	}
+
+	private func cancel(key: RequestKey) {
+		guard let entry = entriesByKey[key], !entry.isCompleted else { return }
+
+		entry.request.delegate = nil
+
+		if entry.isStarted {
+			resourceManager?.stop(entry.request)
+			runningCount -= 1
+		} else {
+			queuedKeys.removeAll(where: { $0 == key })
+		}
+
+		entriesByKey[key] = nil
+		statistics.cancelledRequests += 1
+
+		scheduleFlush()
+	}
+
+	private func scheduleFlush() {
+		if !flushScheduled {
+			flushScheduled = true
+
+			OnMainThread { [weak self] in
+				self?.flushScheduled = false
+				self?.startQueuedRequests()
+			}
+		}
+	}
+
+	func startQueuedRequests() {
+		guard let resourceManager else { return }
+
+		while runningCount < maximumConcurrentRequests, queuedKeys.count > 0 {
+			let key = queuedKeys.removeFirst()
+
+			if let entry = entriesByKey[key], !entry.isStarted {
+				entry.isStarted = true
+				entry.request.delegate = self
+				runningCount += 1
+				statistics.startedRequests += 1
+
+				resourceManager.start(entry.request)
+			}
+		}
+	}
+
+	// MARK: - Claiming requests
+	/// Returns an already queued, running or completed prefetch request for the item, so that it can be used by a cell instead of creating a new request. Ownership of the returned request passes to the caller.
+	public func claimRequest(for item: OCItem, maximumSize: CGSize) -> OCResourceRequest? {
+		guard let key = requestKey(for: item, maximumSize: maximumSize), let entry = entriesByKey[key] else {
+			statistics.misses += 1
+			return nil
+		}
+
+		entriesByKey[key] = nil
+		completedKeys.removeAll(where: { $0 == key })
+
+		entry.request.delegate = nil
+
+		if entry.isStarted {
+			if !entry.isCompleted {
+				runningCount -= 1
+				scheduleFlush()
+			}
+			claimedRequests.add(entry.request)
+		} else {
+			queuedKeys.removeAll(where: { $0 == key })
+		}
+
+		statistics.hits += 1
+
+		return entry.request
+	}
+
+	/// Returns true if the request was handed out by `claimRequest(for:maximumSize:)` after it had already been started by the prefetcher, so it must not be started again.
+	public func hasStarted(request: OCResourceRequest) -> Bool {
+		return claimedRequests.contains(request)
+	}
+
+	// MARK: - OCResourceRequestDelegate
+	public func resourceRequest(_ request: OCResourceRequest, didChangeWithError error: Error?, isOngoing: Bool, previousResource: OCResource?, newResource: OCResource?) {
+		if !isOngoing {
+			OnMainThread(inline: true) { [weak self] in
+				self?.requestDidComplete(request)
+			}
+		}
+	}
+
+	private func requestDidComplete(_ request: OCResourceRequest) {
+		guard let (key, entry) = entriesByKey.first(where: { $0.value.request === request }), entry.isStarted, !entry.isCompleted else { return }
+
+		entry.isCompleted = true
+		runningCount -= 1
+
+		// Keep a limited number of completed requests around for cells to claim
+		completedKeys.append(key)
+		if completedKeys.count > maximumRetainedCompletedRequests {
+			entriesByKey[completedKeys.removeFirst()] = nil
+		}
+
+		startQueuedRequests()
+	}
+}
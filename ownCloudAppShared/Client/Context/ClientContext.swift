@@ -119,6 +119,18 @@ public class ClientContext: NSObject {
 	public weak var query: OCQuery?
 	public weak var queryDatasource: OCDataSource? // Data source with the contents of a .query
 
+	// MARK: - Thumbnail prefetching
+	private weak var _thumbnailPrefetcher: ThumbnailPrefetcher?
+	public weak var thumbnailPrefetcher: ThumbnailPrefetcher? {
+		get {
+			return _thumbnailPrefetcher ?? parent?.thumbnailPrefetcher
+		}
+
+		set {
+			_thumbnailPrefetcher = newValue
+		}
+	}
+
 	// MARK: - Items
 	public var rootItem : OCDataItem?
 
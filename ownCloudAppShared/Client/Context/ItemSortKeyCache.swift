@@ -0,0 +1,204 @@
+//
+//  ItemSortKeyCache.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import ownCloudSDK
+import ownCloudApp
+
+/// Compact, precomputed representation of the properties an item is sorted by
+public struct ItemSortKey {
+	var isFile: Bool		//!< Folder-first bit
+	var number: Double?		//!< Size, date or shared state, with the sort direction already applied
+	var text: [UInt16]		//!< Kind
+	var name: String		//!< Name, compared using the localized collation
+}
+
+/// Builds one `ItemSortKey` per item and sorts by comparing keys, so that re-sorting needs no record lookups. Names are compared with the same localized
+/// collation as `SortMethod.comparator(direction:)`, and only if the other properties are equal - so the order is identical.
+public class ItemSortKeyCache {
+	public let method: SortMethod
+	public let direction: SortDirection
+	public let foldersFirst: Bool
+
+	private var keys: [OCDataItemReference : ItemSortKey] = [:]
+	private let lock = NSLock()
+
+	// MARK: - Statistics
+	public private(set) var keyBuildCount: Int = 0
+
+	public init(sortDescriptor: SortDescriptor, foldersFirst: Bool = DisplaySettings.shared.sortFoldersFirst) {
+		method = sortDescriptor.method
+		direction = sortDescriptor.direction
+		self.foldersFirst = foldersFirst
+	}
+
+	// MARK: - Keys
+	public func makeKey(for item: OCItem) -> ItemSortKey {
+		var number: Double?
+		var text: [UInt16] = []
+		let isFile = (item.type != .collection)
+
+		switch method {
+			case .alphabetically: break
+
+			case .size:
+				// Ascending order lists the largest items first
+				number = (direction == .ascending) ? -Double(item.size) : Double(item.size)
+
+			case .date, .lastUsed:
+				// Ascending order lists the most recent items first
+				if let date = (method == .lastUsed) ? (item.lastUsed ?? item.lastModified) : item.lastModified {
+					number = (direction == .ascending) ? -date.timeIntervalSinceReferenceDate : date.timeIntervalSinceReferenceDate
+				}
+
+			case .shared:
+				let isShared = item.isSharedWithUser || item.isShared
+				number = (isShared == (direction == .ascending)) ? 0 : 1
+
+			case .kind:
+				// Folders before files, then by extension or MIME type - reversed as a whole for descending order
+				number = isFile ? 1 : 0
+				text = Array((item.fileExtension ?? item.mimeType ?? "_various").utf16)
+		}
+
+		return ItemSortKey(isFile: isFile, number: number, text: text, name: item.name ?? "")
+	}
+
+	public func key(for itemRef: OCDataItemReference, in source: OCDataSource) -> ItemSortKey? {
+		lock.lock()
+		let cachedKey = keys[itemRef]
+		lock.unlock()
+
+		if let cachedKey {
+			return cachedKey
+		}
+
+		guard let item = (try? source.record(forItemRef: itemRef))?.item as? OCItem else {
+			return nil
+		}
+
+		let key = makeKey(for: item)
+
+		lock.lock()
+		keys[itemRef] = key
+		keyBuildCount += 1
+		lock.unlock()
+
+		return key
+	}
+
+	/// Removes the keys of changed or removed items, so they're rebuilt on next use. Returns `true` if keys were removed.
+	@discardableResult public func invalidateKeys(for itemRefs: Set<OCDataItemReference>) -> Bool {
+		var removedKeys = false
+
+		lock.lock()
+		for itemRef in itemRefs {
+			if keys.removeValue(forKey: itemRef) != nil {
+				removedKeys = true
+			}
+		}
+		lock.unlock()
+
+		return removedKeys
+	}
+
+	public func removeAllKeys() {
+		lock.lock()
+		keys.removeAll()
+		lock.unlock()
+	}
+
+	// MARK: - Comparison
+	static let localizedNameComparator = OCSQLiteCollationLocalized.sortComparator!
+
+	public func compare(_ key1: ItemSortKey, _ key2: ItemSortKey) -> ComparisonResult {
+		if foldersFirst, key1.isFile != key2.isFile {
+			return key2.isFile ? .orderedAscending : .orderedDescending
+		}
+
+		var result: ComparisonResult = .orderedSame
+
+		if method == .kind {
+			result = ItemSortKeyCache.compare(key1.number ?? 0, key2.number ?? 0)
+
+			if result == .orderedSame {
+				result = ItemSortKeyCache.compare(key1.text, key2.text)
+			}
+
+			if direction == .descending {
+				result = ItemSortKeyCache.reversed(result)
+			}
+		} else if let number1 = key1.number, let number2 = key2.number {
+			result = ItemSortKeyCache.compare(number1, number2)
+		}
+
+		if result == .orderedSame {
+			result = ItemSortKeyCache.localizedNameComparator(key1.name, key2.name)
+
+			if direction == .descending {
+				result = ItemSortKeyCache.reversed(result)
+			}
+		}
+
+		return result
+	}
+
+	public var comparator: (_ source1: OCDataSource, _ ref1: OCDataItemReference, _ source2: OCDataSource, _ ref2: OCDataItemReference) -> ComparisonResult {
+		return { [weak self] (source1, ref1, source2, ref2) in
+			if let self,
+			   let key1 = self.key(for: ref1, in: source1),
+			   let key2 = self.key(for: ref2, in: source2) {
+				return self.compare(key1, key2)
+			}
+
+			return .orderedDescending
+		}
+	}
+
+	static func compare<T: Comparable>(_ value1: T, _ value2: T) -> ComparisonResult {
+		if value1 < value2 {
+			return .orderedAscending
+		}
+
+		if value1 > value2 {
+			return .orderedDescending
+		}
+
+		return .orderedSame
+	}
+
+	static func compare(_ key1: [UInt16], _ key2: [UInt16]) -> ComparisonResult {
+		if key1.lexicographicallyPrecedes(key2) {
+			return .orderedAscending
+		}
+
+		if key2.lexicographicallyPrecedes(key1) {
+			return .orderedDescending
+		}
+
+		return .orderedSame
+	}
+
+	static func reversed(_ result: ComparisonResult) -> ComparisonResult {
+		switch result {
+			case .orderedAscending:	 return .orderedDescending
+			case .orderedDescending: return .orderedAscending
+			case .orderedSame:	 return .orderedSame
+		}
+	}
+}
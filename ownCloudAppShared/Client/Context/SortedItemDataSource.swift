@@ -18,9 +18,18 @@
 
 import UIKit
 import ownCloudSDK
+import ownCloudApp
 
 open class SortedItemDataSource: OCDataSourceComposition {
 	var sortComparatorObserver: NSKeyValueObservation?
+	var sortFoldersFirstObserver: NSKeyValueObservation?
+
+	var itemDataSourceSubscription: OCDataSourceSubscription?
+	var sortKeyCache: ItemSortKeyCache?
+
+	// Items of the item data source are relayed through relayDataSource, so that the keys of changed items can be invalidated before the composition re-sorts
+	var relayDataSource: OCDataSourceArray
+	var relayedItems: [OCDataItemReference : OCDataItem] = [:]
 
 	open weak var sortingFollowsContext: ClientContext? {
 		willSet {
@@ -30,23 +39,79 @@ open class SortedItemDataSource: OCDataSourceComposition {
 
 		didSet {
 			sortComparatorObserver = sortingFollowsContext?.observe(\.sortDescriptor, options: .initial, changeHandler: { [weak self] context, change in
-				if let comparator = context.sortDescriptor?.comparator {
-					self?.sortComparator = { (source1, ref1, source2, ref2) in
-						if let record1 = try? source1.record(forItemRef: ref1),
-						   let record2 = try? source2.record(forItemRef: ref2),
-						   let item1 = record1.item as? OCItem,
-						   let item2 = record2.item as? OCItem {
-							return comparator(item1, item2)
-						}
-
-						return .orderedDescending
-					}
-				}
+				self?.updateSortKeyCache()
 			})
 		}
 	}
 
 	public init(itemDataSource: OCDataSource) {
-		super.init(sources: [itemDataSource])
+		relayDataSource = OCDataSourceArray()
+
+		super.init(sources: [relayDataSource])
+
+		itemDataSourceSubscription = itemDataSource.subscribe(updateHandler: { [weak self] (subscription) in
+			self?.relayChanges(from: subscription)
+		}, on: .main, trackDifferences: true, performInitialUpdate: true)
+
+		sortFoldersFirstObserver = DisplaySettings.shared.observe(\.sortFoldersFirst, changeHandler: { [weak self] _, _ in
+			OnMainThread {
+				self?.updateSortKeyCache()
+			}
+		})
+	}
+
+	deinit {
+		itemDataSourceSubscription?.terminate()
+		sortFoldersFirstObserver?.invalidate()
+	}
+
+	func relayChanges(from subscription: OCDataSourceSubscription) {
+		let snapshot = subscription.snapshotResettingChangeTracking(true)
+		var changedItemRefs = Set<OCDataItemReference>()
+		var updatedItems = Set<AnyHashable>()
+		var items: [OCDataItem] = []
+
+		if let removedItems = snapshot.removedItems {
+			for itemRef in removedItems {
+				relayedItems[itemRef] = nil
+			}
+			changedItemRefs.formUnion(removedItems)
+		}
+
+		if let updatedItemRefs = snapshot.updatedItems {
+			changedItemRefs.formUnion(updatedItemRefs)
+		}
+
+		items.reserveCapacity(snapshot.items.count)
+
+		for itemRef in snapshot.items {
+			// Only retrieve added and updated items
+			if changedItemRefs.contains(itemRef) || (relayedItems[itemRef] == nil), let item = (try? subscription.source?.record(forItemRef: itemRef))?.item {
+				relayedItems[itemRef] = item
+
+				if changedItemRefs.contains(itemRef), let item = item as? NSObject {
+					updatedItems.insert(item)
+				}
+			}
+
+			if let item = relayedItems[itemRef] {
+				items.append(item)
+			}
+		}
+
+		// Keys of changed items need to be rebuilt - before the composition re-sorts in response to the relayed changes
+		sortKeyCache?.invalidateKeys(for: changedItemRefs)
+
+		relayDataSource.setItems(items, updated: updatedItems)
+	}
+
+	func updateSortKeyCache() {
+		if let sortDescriptor = sortingFollowsContext?.sortDescriptor {
+			// Build one sort key per item, so re-sorting only compares keys
+			let sortKeyCache = ItemSortKeyCache(sortDescriptor: sortDescriptor)
+
+			self.sortKeyCache = sortKeyCache
+			self.sortComparator = sortKeyCache.comparator
+		}
 	}
 }
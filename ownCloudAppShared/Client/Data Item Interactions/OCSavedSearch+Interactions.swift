@@ -25,6 +25,7 @@ extension OCSavedSearchUserInfoKey {
 	static let useNameAsTitle = OCSavedSearchUserInfoKey(rawValue: "useNameAsTitle")
 	static let useSortDescriptor = OCSavedSearchUserInfoKey(rawValue: "useSortDescriptor")
 	static let isQuickAccess = OCSavedSearchUserInfoKey(rawValue: "isQuickAccess")
+	static let useMaterializedResults = OCSavedSearchUserInfoKey(rawValue: "useMaterializedResults")
 }
 
 extension OCSavedSearch {
@@ -167,6 +168,20 @@ extension OCSavedSearch {
 		}
 	}
 
+	var useMaterializedResults: Bool? {
+		set {
+			if userInfo == nil, let newValue {
+				userInfo = [.useMaterializedResults : newValue]
+			} else {
+				userInfo?[.useMaterializedResults] = newValue
+			}
+		}
+
+		get {
+			return userInfo?[.useMaterializedResults] as? Bool
+		}
+	}
+
 	func withCustomIcon(name: String) -> OCSavedSearch {
 		customIconName = name
 		return self
@@ -191,18 +206,32 @@ extension OCSavedSearch {
 extension OCSavedSearch: DataItemSelectionInteraction {
 	func buildViewController(with context: ClientContext) -> ClientItemViewController? {
 		if let condition = condition() {
-			let query = OCQuery(condition: condition, inputFilter: nil)
 			let useSortDescriptor = useSortDescriptor
-			DisplaySettings.shared.updateQuery(withDisplaySettings: query)
+			var query: OCQuery?
+			var resultsDataSource: SortedItemDataSource?
+
+			if !isTemplate, useMaterializedResults != false, let resultSet = context.accountConnection?.savedSearchResultSets?.resultSet(for: self, condition: condition) {
+				// Use materialized result set, which is restored instantly and kept up-to-date in the background
+				resultsDataSource = SortedItemDataSource(itemDataSource: resultSet.dataSource)
+			} else {
+				query = OCQuery(condition: condition, inputFilter: nil)
+				if let query {
+					DisplaySettings.shared.updateQuery(withDisplaySettings: query)
+				}
+			}
 
 			let resultsContext = ClientContext(with: context, modifier: { context in
 				context.query = query
+				if let resultsDataSource {
+					context.queryDatasource = resultsDataSource
+				}
 				if let useSortDescriptor {
 					context.sortDescriptor = useSortDescriptor
 				}
 			})
 
-			let viewController = ClientItemViewController(context: resultsContext, query: query, showRevealButtonForItems: true, emptyItemListIcon: OCSymbol.icon(forSymbolName: "magnifyingglass"), emptyItemListTitleLocalized: OCLocalizedString("No matches", nil), emptyItemListMessageLocalized: OCLocalizedString("No items found matching the search criteria.", nil))
+			let viewController = ClientItemViewController(context: resultsContext, query: query, itemsDatasource: resultsDataSource, showRevealButtonForItems: true, emptyItemListIcon: OCSymbol.icon(forSymbolName: "magnifyingglass"), emptyItemListTitleLocalized: OCLocalizedString("No matches", nil), emptyItemListMessageLocalized: OCLocalizedString("No items found matching the search criteria.", nil))
+			resultsDataSource?.sortingFollowsContext = viewController.clientContext
 			if self.useNameAsTitle == true {
 				viewController.navigationTitle = sideBarDisplayName
 			} else {
@@ -0,0 +1,147 @@
+//
+//  ImportStager.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import Darwin
+
+/// Stages files for import in per-import folders below `rootURL`, avoiding full copies where the filesystem allows:
+/// - copy-on-write clones (APFS), which share all data blocks with the source until either is modified
+/// - hard links (if allowed by the caller), which share the file itself
+/// - a chunked copy with progress reporting and cancellation as fallback
+public class ImportStager {
+	public enum Method : String {
+		case clone
+		case hardLink
+		case copy
+	}
+
+	public struct StagedFile {
+		public var url: URL
+		public var containerURL: URL
+		public var method: Method
+	}
+
+	public let rootURL: URL
+	public var chunkSize: Int = 4 * 1024 * 1024
+	public var allowsClones: Bool = true
+
+	public init(rootURL: URL) {
+		self.rootURL = rootURL
+	}
+
+	// MARK: - Staging
+	/// Stages the file at `sourceURL` synchronously. Meant to be called off the main thread, f.ex. from within a file coordination accessor.
+	/// - Parameters:
+	///   - sourceURL: the file to stage
+	///   - allowHardLink: only pass `true` for files that won't be modified in place after staging, since a hard link shares all changes with the source
+	///   - progress: optional progress object, updated as the file is copied. Cancelling it aborts the copy.
+	public func stage(_ sourceURL: URL, allowHardLink: Bool = false, progress: Progress? = nil) throws -> StagedFile {
+		let fileManager = FileManager.default
+		let protectionAttributes: [FileAttributeKey : Any] = [ .protectionKey : FileProtectionType.completeUntilFirstUserAuthentication ]
+
+		if !fileManager.fileExists(atPath: rootURL.path) {
+			try fileManager.createDirectory(at: rootURL, withIntermediateDirectories: true, attributes: protectionAttributes)
+		}
+
+		let containerURL = rootURL.appendingPathComponent(UUID().uuidString, isDirectory: true)
+		let destinationURL = containerURL.appendingPathComponent(sourceURL.lastPathComponent)
+
+		try fileManager.createDirectory(at: containerURL, withIntermediateDirectories: false, attributes: protectionAttributes)
+
+		let fileSize = (try? sourceURL.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0
+		progress?.totalUnitCount = Int64(fileSize)
+
+		do {
+			var method: Method = .copy
+
+			if allowsClones, clonefile(sourceURL.path, destinationURL.path, 0) == 0 {
+				method = .clone
+				progress?.completedUnitCount = Int64(fileSize)
+			} else if allowHardLink, link(sourceURL.path, destinationURL.path) == 0 {
+				method = .hardLink
+				progress?.completedUnitCount = Int64(fileSize)
+			} else {
+				try copyInChunks(from: sourceURL, to: destinationURL, progress: progress)
+			}
+
+			Log.debug(tagged: ["IMPORT"], "Staged \(Log.mask(sourceURL.lastPathComponent)) (\(fileSize) bytes) via \(method.rawValue)")
+
+			return StagedFile(url: destinationURL, containerURL: containerURL, method: method)
+		} catch {
+			// Don't leave partial copies behind
+			try? fileManager.removeItem(at: containerURL)
+			throw error
+		}
+	}
+
+	private func copyInChunks(from sourceURL: URL, to destinationURL: URL, progress: Progress?) throws {
+		guard FileManager.default.createFile(atPath: destinationURL.path, contents: nil) else {
+			throw CocoaError(.fileWriteUnknown)
+		}
+
+		let readHandle = try FileHandle(forReadingFrom: sourceURL)
+		defer {
+			try? readHandle.close()
+		}
+
+		let writeHandle = try FileHandle(forWritingTo: destinationURL)
+		defer {
+			try? writeHandle.close()
+		}
+
+		while true {
+			if progress?.isCancelled == true {
+				throw CocoaError(.userCancelled)
+			}
+
+			let chunk: Data? = try autoreleasepool {
+				return try readHandle.read(upToCount: chunkSize)
+			}
+
+			guard let chunk, chunk.count > 0 else {
+				break
+			}
+
+			try writeHandle.write(contentsOf: chunk)
+
+			progress?.completedUnitCount += Int64(chunk.count)
+		}
+	}
+
+	// MARK: - Cleanup
+	public func remove(_ stagedFile: StagedFile) {
+		try? FileManager.default.removeItem(at: stagedFile.containerURL)
+	}
+
+	/// Removes staged files whose folders were created before `date` - f.ex. left behind by imports interrupted by termination of the app
+	public func removeStagedFiles(createdBefore date: Date = Date.distantFuture) {
+		let fileManager = FileManager.default
+
+		guard let containerURLs = try? fileManager.contentsOfDirectory(at: rootURL, includingPropertiesForKeys: [.creationDateKey]) else {
+			return
+		}
+
+		for containerURL in containerURLs {
+			if let creationDate = try? containerURL.resourceValues(forKeys: [.creationDateKey]).creationDate, creationDate >= date {
+				continue
+			}
+
+			try? fileManager.removeItem(at: containerURL)
+		}
+	}
+}
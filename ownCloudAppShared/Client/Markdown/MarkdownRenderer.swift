@@ -0,0 +1,269 @@
+//
+//  MarkdownRenderer.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+import Down
+
+open class MarkdownRenderer: NSObject {
+	public struct Update {
+		// Range of the previously delivered output to replace with .replacement
+		public var replacedRange: NSRange
+		public var replacement: NSAttributedString
+
+		// Full output after applying the update
+		public var output: NSAttributedString
+
+		// Number of blocks that needed to be rendered with Down
+		public var renderedBlockCount: Int
+	}
+
+	public typealias UpdateHandler = (_ update: Update) -> Void
+
+	struct Block {
+		var source: String
+		var rendered: NSAttributedString
+	}
+
+	private let renderQueue = DispatchQueue(label: "com.owncloud.markdown-renderer", qos: .userInitiated)
+
+	private var blocks: [Block] = [] // only accessed on renderQueue
+	private var renderCache: [String : NSAttributedString] = [:] // only accessed on renderQueue
+
+	private var pendingMarkdown: String? // protected by self
+	private var pendingHandler: UpdateHandler? // protected by self
+	private var isRendering: Bool = false // protected by self
+
+	let stylerConfiguration: DownStylerConfiguration
+
+	public init(stylerConfiguration: DownStylerConfiguration = DownStylerConfiguration(colors: StaticColorCollection.dynamicColors)) {
+		self.stylerConfiguration = stylerConfiguration
+		super.init()
+	}
+
+	// MARK: - Rendering
+	/// Schedules rendering of `markdown` on a background queue and calls `updateHandler` on the main thread with the changed range. If newer markdown arrives while a render is in progress, only the latest version is rendered next.
+	open func render(_ markdown: String, updateHandler: @escaping UpdateHandler) {
+		var startRendering = false
+
+		OCSynchronized(self) {
+			pendingMarkdown = markdown
+			pendingHandler = updateHandler
+
+			if !isRendering {
+				isRendering = true
+				startRendering = true
+			}
+		}
+
+		if startRendering {
+			renderQueue.async { [weak self] in
+				self?.renderPending()
+			}
+		}
+	}
+
+	private func renderPending() {
+		var markdown: String?
+		var updateHandler: UpdateHandler?
+
+		OCSynchronized(self) {
+			markdown = pendingMarkdown
+			updateHandler = pendingHandler
+			pendingMarkdown = nil
+			pendingHandler = nil
+
+			if markdown == nil {
+				isRendering = false
+			}
+		}
+
+		guard let markdown else { return }
+
+		let update = renderSynchronously(markdown)
+
+		OnMainThread {
+			updateHandler?(update)
+		}
+
+		renderQueue.async { [weak self] in
+			self?.renderPending()
+		}
+	}
+
+	/// Renders `markdown` on the calling thread, re-using the output of all blocks that are unchanged since the last call. Must not be called concurrently - intended for use by `render(_:updateHandler:)` and tests.
+	public func renderSynchronously(_ markdown: String) -> Update {
+		let sources = MarkdownRenderer.blockSources(of: markdown)
+		var renderedBlockCount = 0
+
+		// Determine unchanged blocks at start and end
+		var prefixCount = 0
+		while prefixCount < sources.count, prefixCount < blocks.count, blocks[prefixCount].source == sources[prefixCount] {
+			prefixCount += 1
+		}
+
+		var suffixCount = 0
+		while suffixCount < (sources.count - prefixCount), suffixCount < (blocks.count - prefixCount), blocks[blocks.count - 1 - suffixCount].source == sources[sources.count - 1 - suffixCount] {
+			suffixCount += 1
+		}
+
+		// Compute replaced range in previous output
+		var replacedLocation = 0
+		var replacedLength = 0
+
+		for (idx, block) in blocks.enumerated() {
+			if idx < prefixCount {
+				replacedLocation += block.rendered.length
+			} else if idx < (blocks.count - suffixCount) {
+				replacedLength += block.rendered.length
+			}
+		}
+
+		// Render changed blocks
+		let replacement = NSMutableAttributedString()
+		var newBlocks: [Block] = Array(blocks[0..<prefixCount])
+		var newRenderCache: [String : NSAttributedString] = [:]
+
+		for block in newBlocks {
+			newRenderCache[block.source] = block.rendered
+		}
+
+		for source in sources[prefixCount..<(sources.count - suffixCount)] {
+			var rendered = renderCache[source]
+
+			if rendered == nil {
+				rendered = renderBlock(source)
+				renderedBlockCount += 1
+			}
+
+			if let rendered {
+				newBlocks.append(Block(source: source, rendered: rendered))
+				newRenderCache[source] = rendered
+				replacement.append(rendered)
+			}
+		}
+
+		for block in blocks[(blocks.count - suffixCount)...] {
+			newBlocks.append(block)
+			newRenderCache[block.source] = block.rendered
+		}
+
+		blocks = newBlocks
+		renderCache = newRenderCache
+
+		let output = NSMutableAttributedString()
+		for block in blocks {
+			output.append(block.rendered)
+		}
+
+		return Update(replacedRange: NSRange(location: replacedLocation, length: replacedLength), replacement: replacement, output: output, renderedBlockCount: renderedBlockCount)
+	}
+
+	func renderBlock(_ source: String) -> NSAttributedString {
+		let down = Down(markdownString: source)
+		let styler = DownStyler(configuration: stylerConfiguration)
+
+		if let attributedString = try? down.toAttributedString(.default, styler: styler) {
+			let blockString = NSMutableAttributedString(attributedString: attributedString)
+
+			// Make sure consecutive blocks are visually separated
+			if blockString.length > 0, !blockString.string.hasSuffix("\n") {
+				blockString.append(NSAttributedString(string: "\n", attributes: blockString.attributes(at: blockString.length - 1, effectiveRange: nil)))
+			}
+
+			return blockString
+		}
+
+		return NSAttributedString(string: source)
+	}
+
+	// MARK: - Block segmentation
+	/// Splits markdown into top-level blocks separated by blank lines. Fenced code blocks, indented continuations and lists are kept together, so that each block renders identically on its own. Documents with link reference definitions are returned as a single block, since their definitions affect the entire document.
+	public static func blockSources(of markdown: String) -> [String] {
+		var blocks: [String] = []
+		var currentLines: [Substring] = []
+		var fence: Substring?
+		var pendingBlankLines: [Substring] = []
+
+		func isListItem(_ line: Substring) -> Bool {
+			let trimmed = line.drop(while: { $0 == " " })
+			if let first = trimmed.first {
+				if first == "-" || first == "*" || first == "+" {
+					return trimmed.dropFirst().first == " "
+				}
+				if first.isNumber {
+					let afterDigits = trimmed.drop(while: { $0.isNumber })
+					return (afterDigits.first == "." || afterDigits.first == ")") && afterDigits.dropFirst().first == " "
+				}
+			}
+			return false
+		}
+
+		func flush() {
+			if !currentLines.isEmpty {
+				blocks.append(currentLines.joined(separator: "\n") + "\n")
+				currentLines.removeAll()
+			}
+		}
+
+		for line in markdown.split(separator: "\n", omittingEmptySubsequences: false) {
+			let trimmed = line.drop(while: { $0 == " " || $0 == "\t" })
+
+			if fence == nil, trimmed.hasPrefix("["), trimmed.contains("]:") {
+				// Link reference definition - render the document as a whole
+				return [markdown]
+			}
+
+			if let openFence = fence {
+				currentLines.append(line)
+				if trimmed.hasPrefix(openFence) {
+					fence = nil
+				}
+				continue
+			}
+
+			if trimmed.isEmpty {
+				if !currentLines.isEmpty {
+					pendingBlankLines.append(line)
+				}
+				continue
+			}
+
+			if !pendingBlankLines.isEmpty {
+				let isContinuation = (line.first == " " || line.first == "\t") || (isListItem(line) && currentLines.last.map({ isListItem($0) || $0.first == " " || $0.first == "\t" }) == true)
+
+				if isContinuation {
+					currentLines.append(contentsOf: pendingBlankLines)
+				} else {
+					flush()
+				}
+				pendingBlankLines.removeAll()
+			}
+
+			if trimmed.hasPrefix("```") || trimmed.hasPrefix("~~~") {
+				fence = trimmed.hasPrefix("```") ? "```" : "~~~"
+			}
+
+			currentLines.append(line)
+		}
+
+		flush()
+
+		return blocks
+	}
+}
@@ -38,6 +38,9 @@ open class MarkdownViewController: UIViewController {
 	var allowEditing: Bool
 	var completionHandler: CompletionHandler?
 
+	let renderer = MarkdownRenderer()
+	var hasRenderedPreview = false
+
 	public init(markdownText: String? = nil, title: String? = nil, allowEditing: Bool = true, completionHandler: CompletionHandler? = nil) {
 		self.markdownText = markdownText ?? ""
 		self.allowEditing = allowEditing
@@ -149,12 +152,23 @@ open class MarkdownViewController: UIViewController {
 	}
 
 	func renderNewMarkdown(_ markdown: String) {
-		let down = Down(markdownString: markdown)
-		let stylerConfiguration = DownStylerConfiguration(colors: StaticColorCollection.dynamicColors)
-		let styler = DownStyler(configuration: stylerConfiguration)
+		// Render off the main thread, only re-rendering changed blocks
+		renderer.render(markdown, updateHandler: { [weak self] update in
+			self?.apply(renderUpdate: update)
+		})
+	}
 
-		if let attributedString = try? down.toAttributedString(.default, styler: styler) {
-			previewView.attributedText = attributedString
+	func apply(renderUpdate update: MarkdownRenderer.Update) {
+		let textStorage = previewView.textStorage
+
+		if hasRenderedPreview, NSMaxRange(update.replacedRange) <= textStorage.length {
+			// Merge only the changed range into the preview, leaving scroll position intact
+			textStorage.beginEditing()
+			textStorage.replaceCharacters(in: update.replacedRange, with: update.replacement)
+			textStorage.endEditing()
+		} else {
+			previewView.attributedText = update.output
+			hasRenderedPreview = true
 		}
 	}
 
@@ -0,0 +1,465 @@
+//
+//  MediaRangeCache.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import ownCloudSDK
+
+// MARK: - Byte ranges
+/// Sorted set of non-overlapping, non-adjacent byte ranges
+public struct ByteRangeSet : Codable, Equatable {
+	public private(set) var ranges: [Range<Int64>] = []
+
+	public init(_ ranges: [Range<Int64>] = []) {
+		for range in ranges {
+			insert(range)
+		}
+	}
+
+	public var byteCount: Int64 {
+		return ranges.reduce(0) { $0 + $1.count }
+	}
+
+	public mutating func insert(_ range: Range<Int64>) {
+		guard !range.isEmpty else { return }
+
+		var merged = range
+		var result: [Range<Int64>] = []
+		var inserted = false
+
+		result.reserveCapacity(ranges.count + 1)
+
+		for existing in ranges {
+			if existing.upperBound < merged.lowerBound {
+				// Entirely before
+				result.append(existing)
+			} else if existing.lowerBound > merged.upperBound {
+				// Entirely after
+				if !inserted {
+					result.append(merged)
+					inserted = true
+				}
+				result.append(existing)
+			} else {
+				// Overlapping or adjacent
+				merged = min(existing.lowerBound, merged.lowerBound) ..< max(existing.upperBound, merged.upperBound)
+			}
+		}
+
+		if !inserted {
+			result.append(merged)
+		}
+
+		ranges = result
+	}
+
+	public func contains(_ range: Range<Int64>) -> Bool {
+		return missingRanges(in: range).isEmpty
+	}
+
+	/// Parts of `range` that are not in the set, in ascending order
+	public func missingRanges(in range: Range<Int64>) -> [Range<Int64>] {
+		var missing: [Range<Int64>] = []
+		var position = range.lowerBound
+
+		for existing in ranges {
+			if existing.upperBound <= position {
+				continue
+			}
+
+			if existing.lowerBound >= range.upperBound {
+				break
+			}
+
+			if existing.lowerBound > position {
+				missing.append(position ..< existing.lowerBound)
+			}
+
+			position = existing.upperBound
+
+			if position >= range.upperBound {
+				break
+			}
+		}
+
+		if position < range.upperBound {
+			missing.append(position ..< range.upperBound)
+		}
+
+		return missing
+	}
+}
+
+// MARK: - Cache entry
+/// Sparse on-disk copy of a remote file, tracking which byte ranges have been stored
+public class MediaRangeCacheEntry {
+	struct Metadata : Codable {
+		var contentLength: Int64?
+		var mimeType: String?
+		var ranges: ByteRangeSet
+		var lastAccess: Date
+	}
+
+	public let key: String
+	let dataURL: URL
+	let metadataURL: URL
+
+	weak var cache: MediaRangeCache?
+
+	static let lastAccessSaveInterval: TimeInterval = 60 //!< Minimum interval between saves of the metadata for reads only
+
+	private var metadata: Metadata
+	private var savedLastAccess: Date
+
+	init(key: String, directoryURL: URL, cache: MediaRangeCache) {
+		let fileName = key.addingPercentEncoding(withAllowedCharacters: .alphanumerics) ?? UUID().uuidString
+
+		self.key = key
+		self.cache = cache
+		dataURL = directoryURL.appendingPathComponent(fileName + ".data")
+		metadataURL = directoryURL.appendingPathComponent(fileName + ".plist")
+
+		if let metadataData = try? Data(contentsOf: metadataURL),
+		   let storedMetadata = try? PropertyListDecoder().decode(Metadata.self, from: metadataData),
+		   FileManager.default.fileExists(atPath: dataURL.path) {
+			metadata = storedMetadata
+		} else {
+			metadata = Metadata(contentLength: nil, mimeType: nil, ranges: ByteRangeSet(), lastAccess: Date())
+		}
+
+		savedLastAccess = metadata.lastAccess
+	}
+
+	// MARK: - Properties
+	public var contentLength: Int64? {
+		var contentLength: Int64?
+		OCSynchronized(self) { contentLength = metadata.contentLength }
+		return contentLength
+	}
+
+	public var mimeType: String? {
+		var mimeType: String?
+		OCSynchronized(self) { mimeType = metadata.mimeType }
+		return mimeType
+	}
+
+	public var cachedRanges: ByteRangeSet {
+		var ranges = ByteRangeSet()
+		OCSynchronized(self) { ranges = metadata.ranges }
+		return ranges
+	}
+
+	public var cachedByteCount: Int64 {
+		return cachedRanges.byteCount
+	}
+
+	var lastAccess: Date {
+		var lastAccess = Date.distantPast
+		OCSynchronized(self) { lastAccess = metadata.lastAccess }
+		return lastAccess
+	}
+
+	public var isComplete: Bool {
+		var isComplete = false
+		OCSynchronized(self) {
+			if let contentLength = metadata.contentLength {
+				isComplete = metadata.ranges.contains(0 ..< contentLength)
+			}
+		}
+		return isComplete
+	}
+
+	public func setContentInformation(contentLength: Int64, mimeType: String?) {
+		OCSynchronized(self) {
+			if metadata.contentLength != contentLength {
+				// Content changed: discard everything cached so far
+				metadata.ranges = ByteRangeSet()
+				try? FileManager.default.removeItem(at: dataURL)
+			}
+
+			metadata.contentLength = contentLength
+			metadata.mimeType = mimeType ?? metadata.mimeType
+
+			saveMetadata()
+		}
+	}
+
+	// MARK: - Reading and writing
+	public func missingRanges(in range: Range<Int64>) -> [Range<Int64>] {
+		var missingRanges: [Range<Int64>] = []
+		OCSynchronized(self) { missingRanges = metadata.ranges.missingRanges(in: range) }
+		return missingRanges
+	}
+
+	public func write(_ data: Data, at offset: Int64) {
+		guard data.count > 0 else { return }
+
+		OCSynchronized(self) {
+			if !FileManager.default.fileExists(atPath: dataURL.path) {
+				FileManager.default.createFile(atPath: dataURL.path, contents: nil, attributes: MediaRangeCache.fileAttributes)
+			}
+
+			do {
+				let fileHandle = try FileHandle(forWritingTo: dataURL)
+
+				try fileHandle.seek(toOffset: UInt64(offset))
+				try fileHandle.write(contentsOf: data)
+				try fileHandle.close()
+
+				metadata.ranges.insert(offset ..< offset + Int64(data.count))
+				metadata.lastAccess = Date()
+
+				saveMetadata()
+			} catch {
+				Log.error(tagged: ["MEDIA_CACHE"], "Error writing to \(dataURL.lastPathComponent): \(error)")
+			}
+		}
+
+		cache?.entryDidGrow(self)
+	}
+
+	/// Returns the data for `range`, or `nil` if it isn't fully cached
+	public func read(_ range: Range<Int64>) -> Data? {
+		var data: Data?
+
+		OCSynchronized(self) {
+			guard metadata.ranges.contains(range) else { return }
+
+			if let fileHandle = try? FileHandle(forReadingFrom: dataURL) {
+				try? fileHandle.seek(toOffset: UInt64(range.lowerBound))
+				data = try? fileHandle.read(upToCount: Int(range.count))
+				try? fileHandle.close()
+			}
+
+			metadata.lastAccess = Date()
+
+			// Persist the access time, so eviction order reflects playback across launches - but not for every read
+			if metadata.lastAccess.timeIntervalSince(savedLastAccess) >= MediaRangeCacheEntry.lastAccessSaveInterval {
+				saveMetadata()
+			}
+		}
+
+		return data
+	}
+
+	/// Saves an access time not yet saved by `read(_:)`
+	func saveLastAccess() {
+		OCSynchronized(self) {
+			if metadata.lastAccess != savedLastAccess, FileManager.default.fileExists(atPath: dataURL.path) {
+				saveMetadata()
+			}
+		}
+	}
+
+	/// Moves the file to `url` once all of it has been cached, removing it from the cache
+	public func promote(to url: URL) throws {
+		guard isComplete else {
+			throw CocoaError(.fileReadCorruptFile)
+		}
+
+		do {
+			objc_sync_enter(self)
+			defer {
+				objc_sync_exit(self)
+			}
+
+			try FileManager.default.moveItem(at: dataURL, to: url)
+
+			metadata.ranges = ByteRangeSet()
+		}
+
+		cache?.remove(self)
+	}
+
+	func removeFiles() {
+		OCSynchronized(self) {
+			try? FileManager.default.removeItem(at: dataURL)
+			try? FileManager.default.removeItem(at: metadataURL)
+			metadata.ranges = ByteRangeSet()
+		}
+	}
+
+	private func saveMetadata() {
+		if let metadataData = try? PropertyListEncoder().encode(metadata) {
+			try? metadataData.write(to: metadataURL, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+			savedLastAccess = metadata.lastAccess
+		}
+	}
+}
+
+// MARK: - Cache
+/// Stores byte ranges of streamed files on disk, evicting the least recently used files beyond `maximumSize`.
+public class MediaRangeCache {
+	static let fileAttributes: [FileAttributeKey : Any] = [ .protectionKey : FileProtectionType.completeUntilFirstUserAuthentication ]
+
+	// MARK: - Account caches
+	private static var cachesByBookmarkUUID: [UUID : MediaRangeCache] = [:]
+
+	static func rootURL(for bookmark: OCBookmark) -> URL? {
+		return OCVault(bookmark: bookmark).rootURL?.appendingPathComponent("MediaRangeCache", isDirectory: true)
+	}
+
+	/// Returns the cache for the account. It is located inside the account's vault, so it is removed together with it.
+	public static func cache(for bookmark: OCBookmark) -> MediaRangeCache? {
+		var cache: MediaRangeCache?
+
+		OCSynchronized(MediaRangeCache.self) {
+			if let existingCache = cachesByBookmarkUUID[bookmark.uuid] {
+				cache = existingCache
+			} else if let rootURL = rootURL(for: bookmark) {
+				cache = MediaRangeCache(rootURL: rootURL)
+				cachesByBookmarkUUID[bookmark.uuid] = cache
+			}
+		}
+
+		return cache
+	}
+
+	/// Removes all cached media of the account. Called when the account is removed.
+	public static func removeCache(for bookmark: OCBookmark) {
+		var cache: MediaRangeCache?
+
+		OCSynchronized(MediaRangeCache.self) {
+			cache = cachesByBookmarkUUID.removeValue(forKey: bookmark.uuid)
+		}
+
+		cache?.removeAll()
+
+		if let rootURL = cache?.rootURL ?? rootURL(for: bookmark) {
+			try? FileManager.default.removeItem(at: rootURL)
+		}
+	}
+
+	// MARK: - Instance
+	public let rootURL: URL
+	public var maximumSize: Int64
+
+	private var entries: [String : MediaRangeCacheEntry] = [:]
+	private var activeKeys: [String : Int] = [:]
+
+	public init(rootURL: URL, maximumSize: Int64 = 512 * 1024 * 1024) {
+		self.rootURL = rootURL
+		self.maximumSize = maximumSize
+
+		try? FileManager.default.createDirectory(at: rootURL, withIntermediateDirectories: true, attributes: MediaRangeCache.fileAttributes)
+
+		// Pick up entries from previous launches
+		if let fileURLs = try? FileManager.default.contentsOfDirectory(at: rootURL, includingPropertiesForKeys: nil) {
+			for fileURL in fileURLs where fileURL.pathExtension == "plist" {
+				if let key = fileURL.deletingPathExtension().lastPathComponent.removingPercentEncoding {
+					entries[key] = MediaRangeCacheEntry(key: key, directoryURL: rootURL, cache: self)
+				}
+			}
+		}
+	}
+
+	// MARK: - Entries
+	public var totalSize: Int64 {
+		var totalSize: Int64 = 0
+		OCSynchronized(self) { totalSize = entries.values.reduce(0) { $0 + $1.cachedByteCount } }
+		return totalSize
+	}
+
+	public func entry(for key: String) -> MediaRangeCacheEntry {
+		var entry: MediaRangeCacheEntry!
+
+		OCSynchronized(self) {
+			if let existingEntry = entries[key] {
+				entry = existingEntry
+			} else {
+				entry = MediaRangeCacheEntry(key: key, directoryURL: rootURL, cache: self)
+				entries[key] = entry
+			}
+		}
+
+		return entry
+	}
+
+	/// Entries in use are not evicted, even if they're the least recently used
+	public func beginUsing(_ entry: MediaRangeCacheEntry) {
+		OCSynchronized(self) { activeKeys[entry.key, default: 0] += 1 }
+	}
+
+	public func endUsing(_ entry: MediaRangeCacheEntry) {
+		entry.saveLastAccess()
+
+		OCSynchronized(self) {
+			if let count = activeKeys[entry.key], count > 1 {
+				activeKeys[entry.key] = count - 1
+			} else {
+				activeKeys[entry.key] = nil
+			}
+		}
+
+		evictIfNeeded()
+	}
+
+	func remove(_ entry: MediaRangeCacheEntry) {
+		OCSynchronized(self) {
+			if entries[entry.key] === entry {
+				entries[entry.key] = nil
+			}
+		}
+
+		entry.removeFiles()
+	}
+
+	public func removeAll() {
+		var allEntries: [MediaRangeCacheEntry] = []
+
+		OCSynchronized(self) {
+			allEntries = Array(entries.values)
+			entries.removeAll()
+		}
+
+		for entry in allEntries {
+			entry.removeFiles()
+		}
+	}
+
+	// MARK: - Eviction
+	func entryDidGrow(_ entry: MediaRangeCacheEntry) {
+		evictIfNeeded()
+	}
+
+	func evictIfNeeded() {
+		var evictedEntries: [MediaRangeCacheEntry] = []
+
+		OCSynchronized(self) {
+			var totalSize = entries.values.reduce(0) { $0 + $1.cachedByteCount }
+
+			guard totalSize > maximumSize else { return }
+
+			let candidates = entries.values.filter({ activeKeys[$0.key] == nil }).sorted(by: { $0.lastAccess < $1.lastAccess })
+
+			for candidate in candidates {
+				if totalSize <= maximumSize {
+					break
+				}
+
+				totalSize -= candidate.cachedByteCount
+				entries[candidate.key] = nil
+				evictedEntries.append(candidate)
+			}
+		}
+
+		for entry in evictedEntries {
+			Log.debug(tagged: ["MEDIA_CACHE"], "Evicting \(entry.key)")
+			entry.removeFiles()
+		}
+	}
+}
@@ -0,0 +1,396 @@
+//
+//  MediaRangeLoader.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import AVFoundation
+import UniformTypeIdentifiers
+
+public enum MediaRangeLoaderError : Error {
+	case invalidResponse
+	case rangeRequestsUnsupported
+	case cancelled
+}
+
+public class MediaRangeLoadTask {
+	var isCancelled: Bool = false
+	var dataTask: URLSessionDataTask?
+
+	public func cancel() {
+		isCancelled = true
+		dataTask?.cancel()
+	}
+}
+
+/// Serves byte ranges of a remote file from a `MediaRangeCacheEntry`, fetching only the parts that aren't cached yet via HTTP range requests
+/// and adding them to the cache. All handlers are called on `queue`.
+///
+/// Responses are checked before their body is loaded: if the server ignores the Range header and would return the entire file, the request is cancelled
+/// and fails with `MediaRangeLoaderError.rangeRequestsUnsupported`, so that the file isn't buffered in memory.
+public class MediaRangeLoader {
+	class Fetch {
+		let range: Range<Int64>
+		let task: MediaRangeLoadTask
+		let completionHandler: (_ data: Data?, _ error: Error?) -> Void
+
+		var offset: Int64
+		var data = Data()
+		var error: Error?
+
+		init(range: Range<Int64>, task: MediaRangeLoadTask, completionHandler: @escaping (_ data: Data?, _ error: Error?) -> Void) {
+			self.range = range
+			self.task = task
+			self.completionHandler = completionHandler
+			self.offset = range.lowerBound
+		}
+	}
+
+	/// Forwards session events to the loader without the session retaining it
+	class SessionDelegate : NSObject, URLSessionDataDelegate {
+		weak var loader: MediaRangeLoader?
+
+		func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive response: URLResponse, completionHandler: @escaping (URLSession.ResponseDisposition) -> Void) {
+			completionHandler(loader?.handle(response: response, for: dataTask) ?? .cancel)
+		}
+
+		func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+			loader?.fetches[dataTask.taskIdentifier]?.data.append(data)
+		}
+
+		func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+			loader?.complete(task, error: error)
+		}
+	}
+
+	public let remoteURL: URL
+	public let headers: [String : String]?
+	public let entry: MediaRangeCacheEntry
+
+	public var chunkSize: Int64 = 512 * 1024
+
+	public let queue = DispatchQueue(label: "com.owncloud.media-range-loader")
+	let session: URLSession
+
+	private var fetches: [Int : Fetch] = [:]
+
+	/// Set once the server has answered a range request with the entire file
+	public private(set) var rangeRequestsUnsupported: Bool = false
+
+	// MARK: - Statistics
+	public private(set) var requestCount: Int = 0
+	public private(set) var fetchedByteCount: Int64 = 0
+	public private(set) var cachedByteCount: Int64 = 0 // Bytes served from the cache
+
+	public init(remoteURL: URL, headers: [String : String]?, entry: MediaRangeCacheEntry, sessionConfiguration: URLSessionConfiguration = .default) {
+		self.remoteURL = remoteURL
+		self.headers = headers
+		self.entry = entry
+
+		let sessionDelegate = SessionDelegate()
+		let delegateQueue = OperationQueue()
+
+		delegateQueue.underlyingQueue = queue
+		delegateQueue.maxConcurrentOperationCount = 1
+
+		session = URLSession(configuration: sessionConfiguration, delegate: sessionDelegate, delegateQueue: delegateQueue)
+
+		sessionDelegate.loader = self
+
+		entry.cache?.beginUsing(entry)
+	}
+
+	deinit {
+		session.invalidateAndCancel()
+		entry.cache?.endUsing(entry)
+	}
+
+	// MARK: - Content information
+	@discardableResult public func loadContentInformation(completionHandler: @escaping (_ contentLength: Int64?, _ mimeType: String?, _ error: Error?) -> Void) -> MediaRangeLoadTask {
+		let task = MediaRangeLoadTask()
+
+		queue.async {
+			if task.isCancelled {
+				completionHandler(nil, nil, MediaRangeLoaderError.cancelled)
+				return
+			}
+
+			if let contentLength = self.entry.contentLength {
+				completionHandler(contentLength, self.entry.mimeType, nil)
+				return
+			}
+
+			// Fetch the first chunk, which provides the content length and type in the response
+			self.fetch(0 ..< self.chunkSize, task: task) { (data, error) in
+				completionHandler(self.entry.contentLength, self.entry.mimeType, error ?? ((self.entry.contentLength == nil) ? MediaRangeLoaderError.invalidResponse : nil))
+			}
+		}
+
+		return task
+	}
+
+	// MARK: - Loading
+	/// Delivers the data for `range` in order, chunk by chunk, through `dataHandler`. Cached parts are read from disk, missing parts are fetched from the server.
+	@discardableResult public func load(range: Range<Int64>, dataHandler: @escaping (_ data: Data) -> Void, completionHandler: @escaping (_ error: Error?) -> Void) -> MediaRangeLoadTask {
+		let task = MediaRangeLoadTask()
+
+		queue.async {
+			self.load(from: range.lowerBound, to: range.upperBound, task: task, dataHandler: dataHandler, completionHandler: completionHandler)
+		}
+
+		return task
+	}
+	private func load(from position: Int64, to end: Int64, task: MediaRangeLoadTask, dataHandler: @escaping (_ data: Data) -> Void, completionHandler: @escaping (_ error: Error?) -> Void) {
+		if task.isCancelled {
+			completionHandler(MediaRangeLoaderError.cancelled)
+			return
+		}
+
+		if position >= end {
+			completionHandler(nil)
+			return
+		}
+
+		let chunk = position ..< min(position + chunkSize, end)
+		var cachedEnd = chunk.upperBound
+
+		if let firstMissingRange = entry.missingRanges(in: chunk).first {
+			if firstMissingRange.lowerBound == position {
+				// Fetch the missing part at the start of the chunk
+				fetch(firstMissingRange, task: task) { (data, error) in
+					if let error {
+						completionHandler(error)
+						return
+					}
+
+					if let data, data.count > 0 {
+						dataHandler(data)
+						self.load(from: position + Int64(data.count), to: end, task: task, dataHandler: dataHandler, completionHandler: completionHandler)
+					} else {
+						completionHandler(MediaRangeLoaderError.invalidResponse)
+					}
+				}
+				return
+			}
+
+			cachedEnd = firstMissingRange.lowerBound
+		}
+
+		// Serve the cached part of the chunk from disk
+		if let data = entry.read(position ..< cachedEnd) {
+			cachedByteCount += Int64(data.count)
+			dataHandler(data)
+			load(from: cachedEnd, to: end, task: task, dataHandler: dataHandler, completionHandler: completionHandler)
+		} else {
+			// Cached part has been evicted in the meantime
+			fetch(position ..< cachedEnd, task: task) { (data, error) in
+				if let error {
+					completionHandler(error)
+				} else if let data, data.count > 0 {
+					dataHandler(data)
+					self.load(from: position + Int64(data.count), to: end, task: task, dataHandler: dataHandler, completionHandler: completionHandler)
+				} else {
+					completionHandler(MediaRangeLoaderError.invalidResponse)
+				}
+			}
+		}
+	}
+
+	// MARK: - Fetching
+	private func fetch(_ range: Range<Int64>, task: MediaRangeLoadTask, completionHandler: @escaping (_ data: Data?, _ error: Error?) -> Void) {
+		if task.isCancelled {
+			completionHandler(nil, MediaRangeLoaderError.cancelled)
+			return
+		}
+
+		var request = URLRequest(url: remoteURL)
+
+		headers?.forEach { (field, value) in
+			request.setValue(value, forHTTPHeaderField: field)
+		}
+
+		request.setValue("bytes=\(range.lowerBound)-\(range.upperBound - 1)", forHTTPHeaderField: "Range")
+
+		requestCount += 1
+
+		let dataTask = session.dataTask(with: request)
+
+		fetches[dataTask.taskIdentifier] = Fetch(range: range, task: task, completionHandler: completionHandler)
+
+		task.dataTask = dataTask
+		dataTask.resume()
+	}
+
+	fileprivate func handle(response: URLResponse, for dataTask: URLSessionDataTask) -> URLSession.ResponseDisposition {
+		guard let fetch = fetches[dataTask.taskIdentifier] else { return .cancel }
+
+		guard let httpResponse = response as? HTTPURLResponse else {
+			fetch.error = MediaRangeLoaderError.invalidResponse
+			return .cancel
+		}
+
+		var contentLength: Int64?
+
+		switch httpResponse.statusCode {
+			case 206:
+				// Content-Range: bytes 0-1023/146515
+				if let contentRange = httpResponse.value(forHTTPHeaderField: "Content-Range") {
+					let components = contentRange.replacingOccurrences(of: "bytes ", with: "").split(whereSeparator: { ($0 == "-") || ($0 == "/") })
+
+					if components.count == 3, let start = Int64(components[0]), let total = Int64(components[2]) {
+						fetch.offset = start
+						contentLength = total
+					}
+				}
+
+			case 200:
+				// Server ignored the range and returns the entire file. Only accept that if the file fits into the requested range - otherwise the
+				// caller needs to fall back to downloading the file.
+				guard fetch.range.lowerBound == 0, httpResponse.expectedContentLength >= 0, httpResponse.expectedContentLength <= Int64(fetch.range.count) else {
+					rangeRequestsUnsupported = true
+					fetch.error = MediaRangeLoaderError.rangeRequestsUnsupported
+					return .cancel
+				}
+
+				fetch.offset = 0
+				contentLength = httpResponse.expectedContentLength
+
+			default:
+				fetch.error = MediaRangeLoaderError.invalidResponse
+				return .cancel
+		}
+
+		if let contentLength, entry.contentLength != contentLength {
+			entry.setContentInformation(contentLength: contentLength, mimeType: httpResponse.mimeType)
+		}
+
+		return .allow
+	}
+
+	fileprivate func complete(_ dataTask: URLSessionTask, error: Error?) {
+		guard let fetch = fetches.removeValue(forKey: dataTask.taskIdentifier) else { return }
+
+		if fetch.task.isCancelled {
+			fetch.completionHandler(nil, MediaRangeLoaderError.cancelled)
+			return
+		}
+
+		if let error = fetch.error ?? error {
+			fetch.completionHandler(nil, error)
+			return
+		}
+
+		let data = fetch.data
+
+		fetchedByteCount += Int64(data.count)
+		entry.write(data, at: fetch.offset)
+
+		// Return only the requested part
+		let requestedStart = Int(fetch.range.lowerBound - fetch.offset)
+		let requestedEnd = min(Int(fetch.range.upperBound - fetch.offset), data.count)
+
+		if requestedStart >= 0, requestedStart < requestedEnd {
+			fetch.completionHandler(data.subdata(in: requestedStart ..< requestedEnd), nil)
+		} else {
+			fetch.completionHandler(nil, MediaRangeLoaderError.invalidResponse)
+		}
+	}
+}
+
+// MARK: - AVFoundation
+/// Serves an `AVURLAsset` through a `MediaRangeLoader`, so that replaying, seeking back and reopening media is served from the cache.
+public class MediaResourceLoader : NSObject, AVAssetResourceLoaderDelegate {
+	static let scheme = "oc-media-cache"
+
+	public let rangeLoader: MediaRangeLoader
+
+	private var tasks: [ObjectIdentifier : MediaRangeLoadTask] = [:]
+
+	public init(rangeLoader: MediaRangeLoader) {
+		self.rangeLoader = rangeLoader
+		super.init()
+	}
+
+	/// Returns an asset whose data is loaded through the receiver. The receiver must be retained for as long as the asset is used.
+	public func makeAsset() -> AVURLAsset {
+		var urlComponents = URLComponents(url: rangeLoader.remoteURL, resolvingAgainstBaseURL: false)
+
+		// A custom scheme routes all loading through the resource loader delegate
+		urlComponents?.scheme = MediaResourceLoader.scheme
+
+		let asset = AVURLAsset(url: urlComponents?.url ?? rangeLoader.remoteURL)
+		asset.resourceLoader.setDelegate(self, queue: rangeLoader.queue)
+
+		return asset
+	}
+
+	public func resourceLoader(_ resourceLoader: AVAssetResourceLoader, shouldWaitForLoadingOfRequestedResource loadingRequest: AVAssetResourceLoadingRequest) -> Bool {
+		let requestID = ObjectIdentifier(loadingRequest)
+
+		// Track the content information request, too, so that it can be cancelled before any data has been requested
+		tasks[requestID] = rangeLoader.loadContentInformation { [weak self] (contentLength, mimeType, error) in
+			if (error as? MediaRangeLoaderError) == .cancelled {
+				return
+			}
+
+			guard let self, let contentLength, error == nil else {
+				self?.tasks[requestID] = nil
+				loadingRequest.finishLoading(with: error)
+				return
+			}
+
+			if let contentInformationRequest = loadingRequest.contentInformationRequest {
+				if let mimeType {
+					contentInformationRequest.contentType = UTType(mimeType: mimeType)?.identifier
+				}
+				contentInformationRequest.contentLength = contentLength
+				contentInformationRequest.isByteRangeAccessSupported = true
+			}
+
+			guard let dataRequest = loadingRequest.dataRequest else {
+				self.tasks[requestID] = nil
+				loadingRequest.finishLoading()
+				return
+			}
+
+			let offset = (dataRequest.currentOffset != 0) ? dataRequest.currentOffset : dataRequest.requestedOffset
+			let end = dataRequest.requestsAllDataToEndOfResource ? contentLength : min(dataRequest.requestedOffset + Int64(dataRequest.requestedLength), contentLength)
+
+			self.tasks[requestID] = self.rangeLoader.load(range: offset ..< max(offset, end), dataHandler: { (data) in
+				dataRequest.respond(with: data)
+			}, completionHandler: { [weak self] (error) in
+				self?.tasks[requestID] = nil
+
+				if let error {
+					if (error as? MediaRangeLoaderError) != .cancelled {
+						loadingRequest.finishLoading(with: error)
+					}
+				} else {
+					loadingRequest.finishLoading()
+				}
+			})
+		}
+
+		return true
+	}
+
+	public func resourceLoader(_ resourceLoader: AVAssetResourceLoader, didCancel loadingRequest: AVAssetResourceLoadingRequest) {
+		let requestID = ObjectIdentifier(loadingRequest)
+
+		tasks[requestID]?.cancel()
+		tasks[requestID] = nil
+	}
+}
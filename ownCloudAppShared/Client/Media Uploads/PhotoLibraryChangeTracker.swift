@@ -0,0 +1,312 @@
+//
+//  PhotoLibraryChangeTracker.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import Photos
+
+// MARK: - Asset source
+public struct PhotoLibraryAssetInfo {
+	public var localIdentifier: String
+	public var mediaType: PHAssetMediaType
+	public var creationDate: Date?
+	public var modificationDate: Date?
+	public var hasAdjustments: Bool
+
+	public init(localIdentifier: String, mediaType: PHAssetMediaType, creationDate: Date?, modificationDate: Date?, hasAdjustments: Bool = false) {
+		self.localIdentifier = localIdentifier
+		self.mediaType = mediaType
+		self.creationDate = creationDate
+		self.modificationDate = modificationDate
+		self.hasAdjustments = hasAdjustments
+	}
+}
+
+public struct PhotoLibraryChangeSet {
+	public var insertedIdentifiers: Set<String> = []
+	public var updatedIdentifiers: Set<String> = []
+	public var deletedIdentifiers: Set<String> = []
+	public var changeToken: Data?
+
+	public init(insertedIdentifiers: Set<String> = [], updatedIdentifiers: Set<String> = [], deletedIdentifiers: Set<String> = [], changeToken: Data? = nil) {
+		self.insertedIdentifiers = insertedIdentifiers
+		self.updatedIdentifiers = updatedIdentifiers
+		self.deletedIdentifiers = deletedIdentifiers
+		self.changeToken = changeToken
+	}
+}
+
+public enum PhotoLibraryChangeTrackerError : Error {
+	case changeTokenExpired
+}
+
+public protocol PhotoLibraryChangeSource {
+	/// Serialized token representing the current state of the library
+	var currentChangeToken: Data? { get }
+
+	/// Changes since the state represented by `changeToken`. Throws `PhotoLibraryChangeTrackerError.changeTokenExpired` if the changes are no longer available.
+	func changes(since changeToken: Data) throws -> PhotoLibraryChangeSet
+
+	/// Information on the assets with the provided identifiers that are part of the user's library, omitting assets that no longer exist or are not part of it (f.ex. shared albums)
+	func assetInfos(for localIdentifiers: [String]) -> [PhotoLibraryAssetInfo]
+
+	/// Information on all assets of the user's library with the provided media types created after `date`, used when no (valid) change token is available
+	func assetInfos(with mediaTypes: [PHAssetMediaType], createdAfter date: Date?) -> [PhotoLibraryAssetInfo]
+}
+
+// MARK: - Cursor storage
+public struct PhotoLibraryChangeCursor : Codable {
+	public var changeToken: Data?
+	public var date: Date			//!< Date of the run that created the cursor
+	public var lastCreationDate: Date?	//!< Newest creation date of all assets processed so far, used as cut-off if the change token expires
+
+	public init(changeToken: Data?, date: Date, lastCreationDate: Date? = nil) {
+		self.changeToken = changeToken
+		self.date = date
+		self.lastCreationDate = lastCreationDate
+	}
+}
+
+public protocol PhotoLibraryChangeCursorStore {
+	func changeCursor(for identifier: String) -> PhotoLibraryChangeCursor?
+	func store(changeCursor: PhotoLibraryChangeCursor?, for identifier: String)
+}
+
+// MARK: - Tracker
+/// Determines the assets to upload since the last run, using persistent change tokens where available. Only inserted and edited assets are
+/// processed, so runs don't need to enumerate the whole library. Assets are selected by the same criteria as the creation date based fetch
+/// the tracker falls back to if there is no cursor yet or the change token has expired: part of the user's library and created after the activation date.
+/// Since changes are filtered against the fixed activation date rather than the newest uploaded asset, assets that show up late with an older
+/// creation date (f.ex. synced from iCloud) and edits of previously uploaded assets are picked up, too.
+public class PhotoLibraryChangeTracker {
+	public struct Delta {
+		public var assets: [PhotoLibraryAssetInfo]	//!< Assets to process, sorted by creation date
+		public var isFullScan: Bool			//!< true if the delta was determined via a creation date fetch
+		public var cursor: PhotoLibraryChangeCursor	//!< Cursor to commit after the assets have been processed
+	}
+
+	public var identifier: String
+	public var source: PhotoLibraryChangeSource
+	public var cursorStore: PhotoLibraryChangeCursorStore
+
+	public init(identifier: String, source: PhotoLibraryChangeSource, cursorStore: PhotoLibraryChangeCursorStore) {
+		self.identifier = identifier
+		self.source = source
+		self.cursorStore = cursorStore
+	}
+
+	/// Returns the assets of the provided media types created after the activation date `createdAfter` that were inserted or edited since the last committed cursor. If there's no usable cursor, returns all assets created after `createdAfter` - or, if assets have been processed before, after the newest of them.
+	public func delta(for mediaTypes: [PHAssetMediaType], createdAfter: Date?) -> Delta {
+		let runDate = Date()
+		let newChangeToken = source.currentChangeToken
+		let previousCursor = cursorStore.changeCursor(for: identifier)
+
+		if let cursor = previousCursor, let changeToken = cursor.changeToken {
+			do {
+				let changes = try source.changes(since: changeToken)
+				var candidateIdentifiers = changes.insertedIdentifiers.union(changes.updatedIdentifiers)
+
+				candidateIdentifiers.subtract(changes.deletedIdentifiers)
+
+				let assets = source.assetInfos(for: Array(candidateIdentifiers)).filter { (asset) in
+					guard mediaTypes.contains(asset.mediaType) else { return false }
+
+					// Only consider assets created after the activation date
+					if let createdAfter, (asset.creationDate ?? .distantPast) <= createdAfter {
+						return false
+					}
+
+					if changes.insertedIdentifiers.contains(asset.localIdentifier) {
+						return true
+					}
+
+					// Updates include metadata changes (f.ex. favorite) - only pick up assets that have been edited since the last run
+					if asset.hasAdjustments, let modificationDate = asset.modificationDate, modificationDate > cursor.date {
+						return true
+					}
+
+					return false
+				}
+
+				return Delta(assets: sortedByCreationDate(assets), isFullScan: false, cursor: PhotoLibraryChangeCursor(changeToken: changes.changeToken ?? newChangeToken, date: runDate, lastCreationDate: lastCreationDate(of: assets, after: cursor.lastCreationDate)))
+			} catch {
+				Log.warning(tagged: ["INSTANT_MEDIA_UPLOAD"], "Change token for \(identifier) not usable (\(error)) - falling back to creation date")
+			}
+		}
+
+		// Without a usable change token, late additions can't be told apart from assets processed before - so skip everything up to the newest processed asset
+		var fullScanCreatedAfter = createdAfter
+
+		if let previousLastCreationDate = previousCursor?.lastCreationDate, (createdAfter == nil) || (previousLastCreationDate > createdAfter!) {
+			fullScanCreatedAfter = previousLastCreationDate
+		}
+
+		let assets = source.assetInfos(with: mediaTypes, createdAfter: fullScanCreatedAfter)
+
+		return Delta(assets: sortedByCreationDate(assets), isFullScan: true, cursor: PhotoLibraryChangeCursor(changeToken: newChangeToken, date: runDate, lastCreationDate: lastCreationDate(of: assets, after: fullScanCreatedAfter)))
+	}
+
+	/// Stores the cursor of a processed delta, so the next call to `delta(for:createdAfter:)` only returns changes made after it.
+	public func commit(_ delta: Delta) {
+		cursorStore.store(changeCursor: delta.cursor, for: identifier)
+	}
+
+	/// Removes the stored cursor, so that the next call to `delta(for:createdAfter:)` falls back to the creation date.
+	public func reset() {
+		cursorStore.store(changeCursor: nil, for: identifier)
+	}
+
+	private func lastCreationDate(of assets: [PhotoLibraryAssetInfo], after date: Date?) -> Date? {
+		let assetsLastCreationDate = assets.compactMap({ $0.creationDate }).max()
+
+		if let date, let assetsLastCreationDate {
+			return max(date, assetsLastCreationDate)
+		}
+
+		return assetsLastCreationDate ?? date
+	}
+
+	private func sortedByCreationDate(_ assets: [PhotoLibraryAssetInfo]) -> [PhotoLibraryAssetInfo] {
+		return assets.sorted { (asset1, asset2) in
+			return (asset1.creationDate ?? .distantPast) < (asset2.creationDate ?? .distantPast)
+		}
+	}
+}
+
+// MARK: - Photo library source
+@available(iOS 16, *)
+public class PhotoLibraryPersistentChangeSource : PhotoLibraryChangeSource {
+	static let assetFetchBatchSize = 500
+
+	var library: PHPhotoLibrary
+
+	public init(library: PHPhotoLibrary = .shared()) {
+		self.library = library
+	}
+
+	public var currentChangeToken: Data? {
+		return try? NSKeyedArchiver.archivedData(withRootObject: library.currentChangeToken, requiringSecureCoding: true)
+	}
+
+	public func changes(since changeTokenData: Data) throws -> PhotoLibraryChangeSet {
+		guard let changeToken = try NSKeyedUnarchiver.unarchivedObject(ofClass: PHPersistentChangeToken.self, from: changeTokenData) else {
+			throw PhotoLibraryChangeTrackerError.changeTokenExpired
+		}
+
+		var changeSet = PhotoLibraryChangeSet()
+		var lastChangeToken: PHPersistentChangeToken?
+		var detailsError: Error?
+
+		do {
+			let changes = try library.fetchPersistentChanges(since: changeToken)
+
+			changes.enumerateChanges { (change, stop) in
+				do {
+					let details = try change.changeDetails(for: .asset)
+
+					changeSet.insertedIdentifiers.formUnion(details.insertedLocalIdentifiers)
+					changeSet.updatedIdentifiers.formUnion(details.updatedLocalIdentifiers)
+					changeSet.deletedIdentifiers.formUnion(details.deletedLocalIdentifiers)
+
+					lastChangeToken = change.changeToken
+				} catch {
+					detailsError = error
+					stop.pointee = true
+				}
+			}
+		} catch {
+			detailsError = error
+		}
+
+		if let detailsError = detailsError {
+			if let photosError = detailsError as? PHPhotosError, (photosError.code == .persistentChangeTokenExpired) || (photosError.code == .persistentChangeDetailsUnavailable) {
+				throw PhotoLibraryChangeTrackerError.changeTokenExpired
+			}
+
+			throw detailsError
+		}
+
+		if let lastChangeToken = lastChangeToken {
+			changeSet.changeToken = try? NSKeyedArchiver.archivedData(withRootObject: lastChangeToken, requiringSecureCoding: true)
+		} else {
+			changeSet.changeToken = changeTokenData
+		}
+
+		return changeSet
+	}
+
+	var userLibrary: PHAssetCollection? {
+		guard PHPhotoLibrary.authorizationStatus() == .authorized else { return nil }
+
+		return PHAssetCollection.fetchAssetCollections(with: .smartAlbum, subtype: .smartAlbumUserLibrary, options: nil).firstObject
+	}
+
+	public func assetInfos(for localIdentifiers: [String]) -> [PhotoLibraryAssetInfo] {
+		var assetInfos = [PhotoLibraryAssetInfo]()
+		var offset = 0
+
+		guard let cameraRoll = userLibrary else {
+			return assetInfos
+		}
+
+		while offset < localIdentifiers.count {
+			let batch = Array(localIdentifiers[offset ..< min(offset + PhotoLibraryPersistentChangeSource.assetFetchBatchSize, localIdentifiers.count)])
+			let fetchOptions = PHFetchOptions()
+
+			// Only fetch assets in the user's library, like the creation date based fetch
+			fetchOptions.predicate = NSPredicate(format: "localIdentifier IN %@", batch)
+
+			PHAsset.fetchAssets(in: cameraRoll, options: fetchOptions).enumerateObjects { (asset, _, _) in
+				assetInfos.append(asset.changeTrackerInfo)
+			}
+
+			offset += batch.count
+		}
+
+		return assetInfos
+	}
+
+	public func assetInfos(with mediaTypes: [PHAssetMediaType], createdAfter date: Date?) -> [PhotoLibraryAssetInfo] {
+		var assetInfos = [PhotoLibraryAssetInfo]()
+
+		guard let cameraRoll = userLibrary else {
+			return assetInfos
+		}
+
+		let fetchOptions = PHFetchOptions()
+		var predicates = [NSPredicate(format: "mediaType IN %@", mediaTypes.map({ $0.rawValue }))]
+
+		if let date = date {
+			predicates.append(NSPredicate(format: "creationDate > %@", date as NSDate))
+		}
+
+		fetchOptions.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: predicates)
+		fetchOptions.sortDescriptors = [NSSortDescriptor(key: "creationDate", ascending: true)]
+
+		PHAsset.fetchAssets(in: cameraRoll, options: fetchOptions).enumerateObjects { (asset, _, _) in
+			assetInfos.append(asset.changeTrackerInfo)
+		}
+
+		return assetInfos
+	}
+}
+
+extension PHAsset {
+	var changeTrackerInfo: PhotoLibraryAssetInfo {
+		return PhotoLibraryAssetInfo(localIdentifier: localIdentifier, mediaType: mediaType, creationDate: creationDate, modificationDate: modificationDate, hasAdjustments: hasAdjustments)
+	}
+}
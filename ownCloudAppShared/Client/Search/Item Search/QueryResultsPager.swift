@@ -0,0 +1,269 @@
+//
+//  QueryResultsPager.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+import ownCloudApp
+
+// MARK: - Endpoint
+public protocol QueryResultsPagerQuery : AnyObject {
+	/// Results of the query, updated on the main thread
+	var resultsDataSource: OCDataSource? { get }
+
+	func stop()
+}
+
+public protocol QueryResultsPagerEndpoint : AnyObject {
+	/// Starts a query for the items matching `condition`, in its sort order
+	func startPageQuery(for condition: OCQueryCondition) -> QueryResultsPagerQuery?
+}
+
+class CorePageQuery : QueryResultsPagerQuery {
+	weak var core: OCCore?
+	var query: OCQuery
+
+	init(core: OCCore, query: OCQuery) {
+		self.core = core
+		self.query = query
+	}
+
+	var resultsDataSource: OCDataSource? {
+		return query.queryResultsDataSource
+	}
+
+	func stop() {
+		core?.stop(query)
+	}
+}
+
+extension OCCore : QueryResultsPagerEndpoint {
+	public func startPageQuery(for condition: OCQueryCondition) -> QueryResultsPagerQuery? {
+		let pageQuery = CorePageQuery(core: self, query: OCQuery(condition: condition, inputFilter: nil))
+
+		start(pageQuery.query)
+
+		return pageQuery
+	}
+}
+
+// MARK: - Pager
+/// Pages through the results of a sorted query condition. Each further page is a separate query for the keyset continuation of the results returned so far,
+/// so previous pages are not evaluated again. The results of all pages are merged (without duplicates) into `resultsDataSource`.
+///
+/// When the results of a page change in a way that moves its boundary (f.ex. because an item was inserted into or re-sorted within its range), the query of
+/// the following page is replaced with one for the continuation of the updated results. This repeats for every following page whose boundary moves in turn,
+/// so that items pushed out of one page show up in the next one.
+public class QueryResultsPager : NSObject {
+	class Page {
+		var condition: OCQueryCondition
+		var query: QueryResultsPagerQuery?
+		var subscription: OCDataSourceSubscription?
+		var items: [OCItem] = []
+		var hasResults: Bool = false
+		var boundary: NSArray?
+		var continuationCondition: OCQueryCondition? //!< Condition for the following page, nil if there are no further results
+
+		init(condition: OCQueryCondition, items: [OCItem] = []) {
+			self.condition = condition
+			self.items = items
+		}
+
+		func stop() {
+			subscription?.terminate()
+			query?.stop()
+		}
+	}
+
+	public weak var endpoint: QueryResultsPagerEndpoint?
+	public var condition: OCQueryCondition
+	public var pageSize: Int
+
+	public var resultsDataSource: OCDataSourceArray = OCDataSourceArray()
+
+	/// Called on the main thread when results or `hasMoreResults` change
+	public var updateHandler: ((_ pager: QueryResultsPager) -> Void)?
+
+	private var pages: [Page] = []
+	private var nextPageRequested: Bool = false
+
+	public init(endpoint: QueryResultsPagerEndpoint, condition: OCQueryCondition, pageSize: Int) {
+		self.endpoint = endpoint
+		self.condition = condition
+		self.pageSize = pageSize
+
+		super.init()
+	}
+
+	public convenience init(core: OCCore, condition: OCQueryCondition, pageSize: Int) {
+		self.init(endpoint: core, condition: condition, pageSize: pageSize)
+	}
+
+	deinit {
+		stop()
+	}
+
+	// MARK: - Paging
+	public var pageCount: Int {
+		return pages.count
+	}
+
+	public var isLoading: Bool {
+		return pages.last?.hasResults == false
+	}
+
+	public var hasMoreResults: Bool {
+		guard let lastPage = pages.last, lastPage.hasResults else { return false }
+		return lastPage.continuationCondition != nil
+	}
+
+	public func start() {
+		guard pages.count == 0 else { return }
+
+		condition.maxResultCount = NSNumber(value: pageSize)
+
+		pages.append(makePage(for: condition))
+	}
+
+	/// Starts a query for the next page. If a page is still loading, the next page is loaded once it has finished. Returns false if the condition doesn't support
+	/// continuation - the caller then needs to use a new query with a larger maxResultCount instead.
+	@discardableResult public func loadNextPage() -> Bool {
+		guard condition.supportsContinuation else { return false }
+
+		if isLoading {
+			nextPageRequested = true
+			return true
+		}
+
+		nextPageRequested = false
+
+		guard let continuationCondition = pages.last?.continuationCondition else {
+			return true
+		}
+
+		pages.append(makePage(for: continuationCondition))
+
+		return true
+	}
+
+	public func stop() {
+		for page in pages {
+			page.stop()
+		}
+
+		pages.removeAll()
+		nextPageRequested = false
+	}
+
+	// MARK: - Pages
+	private func makePage(for condition: OCQueryCondition, replacing replacedPage: Page? = nil) -> Page {
+		// Keep showing the items of a replaced page until the results of its replacement are available
+		let page = Page(condition: condition, items: replacedPage?.items ?? [])
+
+		page.boundary = replacedPage?.boundary
+		page.continuationCondition = replacedPage?.continuationCondition
+
+		replacedPage?.stop()
+
+		page.query = endpoint?.startPageQuery(for: condition)
+
+		page.subscription = page.query?.resultsDataSource?.subscribe(updateHandler: { [weak self, weak page] (subscription) in
+			guard let page else { return }
+
+			let snapshot = subscription.snapshotResettingChangeTracking(true)
+
+			page.items = snapshot.items.compactMap { (itemRef) in
+				return (try? subscription.source?.record(forItemRef: itemRef))?.item as? OCItem
+			}
+
+			page.hasResults = true
+
+			self?.pageDidUpdate(page)
+		}, on: .main, trackDifferences: false, performInitialUpdate: false)
+
+		return page
+	}
+
+	private func pageDidUpdate(_ page: Page) {
+		guard let pageIndex = pages.firstIndex(where: { $0 === page }) else { return }
+
+		let precedingItems = pages[0...pageIndex].flatMap({ $0.items })
+		let precedingBoundary = boundary(of: page, precedingItems: precedingItems)
+		let continuationCondition = condition.continuationCondition(afterItems: precedingItems, page: page.items, of: page.condition)
+
+		// A page that lost items (f.ex. because they were deleted) no longer looks complete - keep the following page's query then, as no items moved into it
+		if pageIndex < pages.count - 1, precedingBoundary != page.boundary, let continuationCondition {
+			// Boundary moved: replace the following page's query with one for the continuation of the updated results
+			pages[pageIndex + 1] = makePage(for: continuationCondition, replacing: pages[pageIndex + 1])
+		}
+
+		page.boundary = precedingBoundary
+
+		if (continuationCondition != nil) || (pageIndex == pages.count - 1) {
+			page.continuationCondition = continuationCondition
+		}
+
+		mergePages()
+
+		if nextPageRequested, !isLoading {
+			loadNextPage()
+		}
+	}
+
+	/// The values the continuation condition for the following page is derived from: the sort value of the last item (plus its local ID when paging through a tie run),
+	/// whether all items of the page share that sort value, and whether the page is complete
+	private func boundary(of page: Page, precedingItems: [OCItem]) -> NSArray {
+		guard let sortBy = condition.sortBy, let lastItem = precedingItems.last, let boundaryValue = lastItem.value(forKey: sortBy.rawValue) as? NSObject else {
+			return []
+		}
+
+		var boundary: [Any] = [ boundaryValue ]
+
+		if page.condition.sortBy == .localID, let localID = lastItem.localID {
+			boundary.append(localID)
+		}
+
+		boundary.append((page.items.first?.value(forKey: sortBy.rawValue) as? NSObject)?.isEqual(boundaryValue) == true)
+		boundary.append(page.items.count >= pageSize)
+
+		return boundary as NSArray
+	}
+
+	private func mergePages() {
+		var localIDs = Set<OCLocalID>()
+		var mergedItems = [OCItem]()
+
+		// Items tied with the boundary of a page are returned again by the following page - and, until the following pages have been replaced,
+		// items whose sort value changed may show up in more than one page
+		for page in pages {
+			for item in page.items {
+				if let localID = item.localID {
+					if localIDs.contains(localID) {
+						continue
+					}
+					localIDs.insert(localID)
+				}
+
+				mergedItems.append(item)
+			}
+		}
+
+		resultsDataSource.setVersionedItems(mergedItems)
+
+		updateHandler?(self)
+	}
+}
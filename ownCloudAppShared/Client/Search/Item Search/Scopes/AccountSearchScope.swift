@@ -46,7 +46,22 @@ open class CustomQuerySearchScope : ItemSearchScope {
 	var resultsSubscription: OCDataSourceSubscription?
 
 	func composeResultsDataSource() {
-		if let queryResultsSource = customQuery?.queryResultsDataSource {
+		if let resultsPager {
+			let composedResults = OCDataSourceComposition(sources: [
+				resultsPager.resultsDataSource,
+				resultActionSource
+			])
+
+			composedResults.setInclude(resultsPager.hasMoreResults, for: resultActionSource)
+
+			resultsPager.updateHandler = { [weak composedResults, weak resultActionSource] (pager) in
+				if let resultActionSource {
+					composedResults?.setInclude(pager.hasMoreResults, for: resultActionSource)
+				}
+			}
+
+			results = composedResults
+		} else if let queryResultsSource = customQuery?.queryResultsDataSource {
 			let composedResults = OCDataSourceComposition(sources: [
 				queryResultsSource,
 				resultActionSource
@@ -89,6 +104,21 @@ open class CustomQuerySearchScope : ItemSearchScope {
 		}
 	}
 
+	/// Pages through the results via keyset continuation, used instead of `customQuery` if the query condition supports it
+	public var resultsPager: QueryResultsPager? {
+		willSet {
+			resultsPager?.stop()
+		}
+
+		didSet {
+			if let resultsPager {
+				resultsPager.start()
+
+				composeResultsDataSource()
+			}
+		}
+	}
+
 	public var queryConditionModifier : ((OCQueryCondition?) -> OCQueryCondition?)?  // MARK: modifier that can modify the query condition before it is passed to create the OCQuery backing the scope. The modification is invisible to the outside. Can be used to add constraints like limit to a drive, etc.
 
 	public var additionalRequirementCondition: OCQueryCondition? // MARK: Adds a required additional condition to the baseCondition
@@ -124,15 +154,27 @@ open class CustomQuerySearchScope : ItemSearchScope {
 				condition.sortAscending = sortDescriptor.direction == .ascending
 			}
 
-			condition.maxResultCount = NSNumber(value: maxResultCount)
+			if condition.supportsContinuation, maxResultCount == maxResultCountDefault, let core = clientContext.core {
+				// Further pages continue after the last result instead of re-running the query with a larger maxResultCount
+				customQuery = nil
+				resultsPager = QueryResultsPager(core: core, condition: condition, pageSize: maxResultCountDefault)
+			} else {
+				condition.maxResultCount = NSNumber(value: maxResultCount)
 
-			customQuery = OCQuery(condition:condition, inputFilter: nil)
+				resultsPager = nil
+				customQuery = OCQuery(condition:condition, inputFilter: nil)
+			}
  		} else {
+			resultsPager = nil
  			customQuery = nil
  		}
  	}
 
 	func showMoreResults() {
+		if let resultsPager, resultsPager.loadNextPage() {
+			return
+		}
+
 		maxResultCount += maxResultCountDefault
 		updateCustomSearchQuery()
 	}
@@ -30,7 +30,7 @@ class ServerSideSearchScope: ItemSearchScope {
 		})
 	}
 
-	var searchResult: OCSearchResult?
+	var searchSession: ServerSearchSession
 
 	var connectionStatusObservation: NSKeyValueObservation?
 
@@ -44,8 +44,21 @@ class ServerSideSearchScope: ItemSearchScope {
 			})
 		}
 
+		searchSession = ServerSearchSession(endpoint: context.core)
+
 		super.init(with: context, cellStyle: pathAndRevealCellStyle, localizedName: name, localizedPlaceholder: placeholder, icon: icon)
 
+		searchSession.resultsHandler = { [weak self] (results) in
+			self?.updateWith(results: results?.results, error: results?.error, hasMoreResults: results?.hasMoreResults ?? false)
+		}
+
+		resultActionSource.setItems([
+			OCAction(title: OCLocalizedString("Show more results", nil), icon: nil, action: { [weak self] action, options, completion in
+				self?.searchSession.loadNextPage()
+				completion(nil)
+			})
+		], updated: nil)
+
 		connectionStatusObservation = context.core?.observe(\.connectionStatus, options: .initial, changeHandler: { [weak self] core, _ in
 			let isOnline = core.connectionStatus == .online
 			OnMainThread {
@@ -86,35 +99,10 @@ class ServerSideSearchScope: ItemSearchScope {
 		}
 	}
 
-	func sendSearchRequest() {
-		guard let core = clientContext.core, let kqlQuery else { return }
-
-		searchResult?.cancel()
-
-		searchResult = core.searchFiles(withPattern: kqlQuery, limit: 100)
-		if searchResult?.error != nil {
-			updateWith(results: nil, error: searchResult?.error)
-		} else {
-			updateWith(results: searchResult?.results, error: nil)
-		}
-	}
-
-	func cancelSearchRequest() {
-		searchResult?.cancel()
-		searchResult = nil
-
-		updateWith(results: nil, error: nil)
-	}
-
 	var kqlQuery: String? {
 		didSet {
-			if let kqlQuery {
-				if kqlQuery != searchResult?.kqlQuery {
-					sendSearchRequest()
-				}
-			} else {
-				cancelSearchRequest()
-			}
+			// Debounced, cached and paged by the search session
+			searchSession.kqlQuery = kqlQuery
 		}
 	}
 
@@ -129,7 +117,7 @@ class ServerSideSearchScope: ItemSearchScope {
 		didSet {
 			if oldValue != isOnline {
 				if isOnline {
-					sendSearchRequest()
+					searchSession.reload()
 				}
 				updateDisplay()
 			}
@@ -137,8 +125,16 @@ class ServerSideSearchScope: ItemSearchScope {
 	}
 
 	var searchResults: OCDataSource?
-	func updateWith(results source: OCDataSource?, error: Error?) {
-		searchResults = source
+	var resultActionSource: OCDataSourceArray = OCDataSourceArray()
+
+	func updateWith(results source: OCDataSource?, error: Error?, hasMoreResults: Bool) {
+		if let source {
+			let composedResults = OCDataSourceComposition(sources: [ source, resultActionSource ])
+			composedResults.setInclude(hasMoreResults, for: resultActionSource)
+			searchResults = composedResults
+		} else {
+			searchResults = nil
+		}
 		updateDisplay()
 	}
 
@@ -0,0 +1,318 @@
+//
+//  ServerSearchSession.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+
+// MARK: - Endpoint
+public protocol ServerSearchRequest {
+	func cancel()
+}
+
+public protocol ServerSearchEndpoint : AnyObject {
+	/// Starts a search for `kqlQuery`, returning at most `limit` results. The completionHandler must be called on the main thread.
+	func startSearch(for kqlQuery: String, limit: Int, completionHandler: @escaping (_ results: OCDataSource?, _ resultCount: Int, _ error: Error?) -> Void) -> ServerSearchRequest?
+}
+
+class CoreServerSearchRequest : ServerSearchRequest {
+	var searchResult: OCSearchResult
+	var resultsSubscription: OCDataSourceSubscription?
+	var errorObservation: NSKeyValueObservation?
+	var completionHandler: ((OCDataSource?, Int, Error?) -> Void)?
+
+	init(searchResult: OCSearchResult, completionHandler: @escaping (OCDataSource?, Int, Error?) -> Void) {
+		self.searchResult = searchResult
+		self.completionHandler = completionHandler
+	}
+
+	/// Calls the completionHandler once - whichever comes first: results or an error
+	func complete(resultCount: Int, error: Error?) {
+		guard let completionHandler else { return }
+
+		stopObserving()
+
+		completionHandler((error == nil) ? searchResult.results : nil, resultCount, error)
+	}
+
+	func cancel() {
+		stopObserving()
+		searchResult.cancel()
+	}
+
+	private func stopObserving() {
+		completionHandler = nil
+
+		resultsSubscription?.terminate()
+		resultsSubscription = nil
+
+		errorObservation?.invalidate()
+		errorObservation = nil
+	}
+}
+
+extension OCCore : ServerSearchEndpoint {
+	public func startSearch(for kqlQuery: String, limit: Int, completionHandler: @escaping (OCDataSource?, Int, Error?) -> Void) -> ServerSearchRequest? {
+		let searchResult = searchFiles(withPattern: kqlQuery, limit: NSNumber(value: limit))
+
+		if let error = searchResult.error {
+			completionHandler(nil, 0, error)
+			return nil
+		}
+
+		let request = CoreServerSearchRequest(searchResult: searchResult, completionHandler: completionHandler)
+
+		// The results data source is populated once the server has responded
+		request.resultsSubscription = searchResult.results?.subscribe(updateHandler: { [weak request] (subscription) in
+			guard let request else { return }
+
+			let snapshot = subscription.snapshotResettingChangeTracking(true)
+
+			request.complete(resultCount: snapshot.numberOfItems, error: request.searchResult.error)
+		}, on: .main, trackDifferences: false, performInitialUpdate: false)
+
+		// Failed searches may not update the results data source at all
+		request.errorObservation = searchResult.observe(\.error, options: .new, changeHandler: { [weak request] (searchResult, _) in
+			guard let error = searchResult.error else { return }
+
+			OnMainThread {
+				request?.complete(resultCount: 0, error: error)
+			}
+		})
+
+		return request
+	}
+}
+
+// MARK: - Session
+public enum ServerSearchSessionError : Error {
+	case timeout
+}
+
+/// Sits between a search scope and a `ServerSearchEndpoint`. It coalesces rapid query changes (typing) into one request, caches recent results with
+/// a time-to-live and extends results page by page on demand, instead of issuing a new server search for every keystroke.
+/// Requests that don't complete within `requestTimeout` are cancelled and reported with `ServerSearchSessionError.timeout`.
+public class ServerSearchSession {
+	public struct Results {
+		public var kqlQuery: String
+		public var results: OCDataSource?
+		public var error: Error?
+		public var hasMoreResults: Bool
+	}
+
+	struct CacheEntry {
+		var results: OCDataSource?
+		var resultCount: Int
+		var limit: Int
+		var date: Date
+
+		var hasMoreResults: Bool {
+			return resultCount >= limit
+		}
+	}
+
+	public weak var endpoint: ServerSearchEndpoint?
+
+	public var debounceInterval: TimeInterval = 0.35
+	public var pageSize: Int = 100
+	public var cacheTimeToLive: TimeInterval = 120
+	public var maximumCacheEntries: Int = 20
+	public var requestTimeout: TimeInterval = 60
+
+	/// Called on the main thread whenever new results for the current query are available
+	public var resultsHandler: ((_ results: Results?) -> Void)?
+
+	// MARK: - Statistics
+	public private(set) var requestCount: Int = 0
+	public private(set) var cacheHitCount: Int = 0
+	public private(set) var coalescedQueryCount: Int = 0
+
+	public init(endpoint: ServerSearchEndpoint?) {
+		self.endpoint = endpoint
+	}
+
+	deinit {
+		debounceWorkItem?.cancel()
+		timeoutWorkItem?.cancel()
+		runningRequest?.cancel()
+	}
+
+	// MARK: - Query
+	private var debounceWorkItem: DispatchWorkItem?
+	private var runningRequest: ServerSearchRequest?
+	private var runningRequestID: Int = 0
+	private var timeoutWorkItem: DispatchWorkItem?
+	private var cache: [String : CacheEntry] = [:]
+
+	public private(set) var isSearching: Bool = false
+
+	/// The KQL query to search for. Changes are debounced, setting `nil` cancels any pending or running search.
+	public var kqlQuery: String? {
+		didSet {
+			guard kqlQuery != oldValue else { return }
+
+			if debounceWorkItem != nil {
+				coalescedQueryCount += 1
+			}
+
+			debounceWorkItem?.cancel()
+			debounceWorkItem = nil
+
+			cancelRunningRequest()
+
+			guard let kqlQuery else {
+				resultsHandler?(nil)
+				return
+			}
+
+			// Serve from cache without waiting for the debounce interval
+			if let entry = cachedEntry(for: kqlQuery) {
+				cacheHitCount += 1
+				deliver(entry, for: kqlQuery)
+				return
+			}
+
+			let workItem = DispatchWorkItem { [weak self] in
+				self?.debounceWorkItem = nil
+				self?.search(kqlQuery, limit: self?.pageSize ?? 100)
+			}
+
+			debounceWorkItem = workItem
+
+			DispatchQueue.main.asyncAfter(deadline: .now() + debounceInterval, execute: workItem)
+		}
+	}
+
+	/// true if the last response for the current query returned as many results as requested, so that more may be available
+	public var hasMoreResults: Bool {
+		if let kqlQuery, let entry = cache[kqlQuery] {
+			return entry.hasMoreResults
+		}
+		return false
+	}
+
+	/// Requests the next page of results for the current query
+	public func loadNextPage() {
+		guard let kqlQuery, !isSearching, let entry = cache[kqlQuery], entry.hasMoreResults else { return }
+
+		search(kqlQuery, limit: entry.limit + pageSize)
+	}
+
+	/// Discards cached results for the current query and searches again, f.ex. after reconnecting
+	public func reload() {
+		guard let kqlQuery else { return }
+
+		let limit = cache[kqlQuery]?.limit ?? pageSize
+
+		debounceWorkItem?.cancel()
+		debounceWorkItem = nil
+
+		cache[kqlQuery] = nil
+		search(kqlQuery, limit: limit)
+	}
+
+	public func invalidateCache() {
+		cache.removeAll()
+	}
+
+	// MARK: - Requests
+	private func search(_ kqlQuery: String, limit: Int) {
+		guard let endpoint else { return }
+
+		cancelRunningRequest()
+
+		runningRequestID += 1
+		requestCount += 1
+		isSearching = true
+
+		let requestID = runningRequestID
+
+		let request = endpoint.startSearch(for: kqlQuery, limit: limit, completionHandler: { [weak self] (results, resultCount, error) in
+			guard let self, requestID == self.runningRequestID else { return }
+
+			self.timeoutWorkItem?.cancel()
+			self.timeoutWorkItem = nil
+
+			self.runningRequest = nil
+			self.isSearching = false
+
+			if let error {
+				self.resultsHandler?(Results(kqlQuery: kqlQuery, results: nil, error: error, hasMoreResults: false))
+				return
+			}
+
+			let entry = CacheEntry(results: results, resultCount: resultCount, limit: limit, date: Date())
+
+			self.store(entry, for: kqlQuery)
+			self.deliver(entry, for: kqlQuery)
+		})
+
+		if isSearching, requestID == runningRequestID {
+			runningRequest = request
+
+			// Don't wait forever for endpoints that never answer
+			let workItem = DispatchWorkItem { [weak self] in
+				guard let self, requestID == self.runningRequestID else { return }
+
+				self.timeoutWorkItem = nil
+				self.cancelRunningRequest()
+
+				self.resultsHandler?(Results(kqlQuery: kqlQuery, results: nil, error: ServerSearchSessionError.timeout, hasMoreResults: false))
+			}
+
+			timeoutWorkItem = workItem
+
+			DispatchQueue.main.asyncAfter(deadline: .now() + requestTimeout, execute: workItem)
+		}
+	}
+
+	private func cancelRunningRequest() {
+		runningRequestID += 1
+		runningRequest?.cancel()
+		runningRequest = nil
+		timeoutWorkItem?.cancel()
+		timeoutWorkItem = nil
+		isSearching = false
+	}
+
+	private func deliver(_ entry: CacheEntry, for kqlQuery: String) {
+		guard kqlQuery == self.kqlQuery else { return }
+
+		resultsHandler?(Results(kqlQuery: kqlQuery, results: entry.results, error: nil, hasMoreResults: entry.hasMoreResults))
+	}
+
+	// MARK: - Cache
+	private func cachedEntry(for kqlQuery: String) -> CacheEntry? {
+		if let entry = cache[kqlQuery] {
+			if -entry.date.timeIntervalSinceNow < cacheTimeToLive {
+				return entry
+			}
+
+			cache[kqlQuery] = nil
+		}
+
+		return nil
+	}
+
+	private func store(_ entry: CacheEntry, for kqlQuery: String) {
+		cache[kqlQuery] = entry
+
+		if cache.count > maximumCacheEntries, let oldestKQLQuery = cache.min(by: { $0.value.date < $1.value.date })?.key {
+			cache[oldestKQLQuery] = nil
+		}
+	}
+}
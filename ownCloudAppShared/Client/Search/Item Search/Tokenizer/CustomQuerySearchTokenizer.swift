@@ -22,7 +22,7 @@ import ownCloudApp
 open class CustomQuerySearchTokenizer : SearchTokenizer {
 	open override func shouldTokenize(segment: OCSearchSegment) -> SearchToken? {
 		// Determine if that parsing this segment would result in a non-itemname query condition
-		if let queryCondition = OCQueryCondition.fromSearchTerm(segment.segmentedString) {
+		if let queryCondition = OCQueryCondition.cachedFromSearchTerm(segment.segmentedString) {
 			if let property = queryCondition.property {
 				if (property != .name) || (queryCondition.operator != .propertyContains) {
 					// Non-itemname, property-based query condition -> generate search token
@@ -40,6 +40,6 @@ open class CustomQuerySearchTokenizer : SearchTokenizer {
 
 	open override func composeTextElement(segment: OCSearchSegment) -> SearchElement {
 		// Compose search element with query condition representation
-		return SearchElement(text: segment.segmentedString, representedObject: OCQueryCondition.fromSearchTerm(segment.segmentedString), inputComplete: !segment.hasCursor)
+		return SearchElement(text: segment.segmentedString, representedObject: OCQueryCondition.cachedFromSearchTerm(segment.segmentedString), inputComplete: !segment.hasCursor)
 	}
 }
@@ -0,0 +1,399 @@
+//
+//  SavedSearchResultSet.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+import ownCloudApp
+
+/// Materialized result set of a saved search: restored from disk when opened, then kept up to date from item change sets instead of being re-queried from scratch.
+///
+/// Result sets that could be restored and brought up to date from the database (see `restore(from:completionHandler:)`) follow the database's changes via
+/// `startFollowingChanges(in:)`. Only result sets without a usable persisted state run the full query via `start(in:)`.
+open class SavedSearchResultSet: NSObject {
+	public let savedSearch: OCSavedSearch
+	public let condition: OCQueryCondition
+	public let signature: String
+	public let storageURL: URL?
+
+	public let dataSource: OCDataSourceArray = OCDataSourceArray(items: nil)
+
+	public private(set) var itemsByLocalID: [OCLocalID : OCItem] = [:]
+	public private(set) var wasRestored: Bool = false
+	public private(set) var isReconciled: Bool = false
+
+	/// Sync anchor up to which all changes are reflected in the result set
+	public private(set) var syncAnchor: OCSyncAnchor?
+
+	/// Number of local IDs retrieved per database query when restoring
+	public var restoreBatchSize: Int = 200
+
+	weak var core: OCCore?
+	var query: OCQuery?
+	var querySubscription: OCDataSourceSubscription?
+	var queryStateObservation: NSKeyValueObservation?
+	var querySyncAnchor: OCSyncAnchor?
+
+	weak var database: OCDatabase?
+	var syncAnchorObservation: NSKeyValueObservation?
+	var isRetrievingChanges: Bool = false
+	var needsChangeRetrieval: Bool = false
+
+	private let persistRateLimiter = OCRateLimiter(minimumTime: 2.0)
+
+	public init(savedSearch: OCSavedSearch, condition: OCQueryCondition, storageURL: URL?) {
+		self.savedSearch = savedSearch
+		self.condition = condition
+		self.signature = SavedSearchResultSet.signature(for: savedSearch)
+		self.storageURL = storageURL
+
+		super.init()
+	}
+
+	deinit {
+		stop()
+	}
+
+	static func signature(for savedSearch: OCSavedSearch) -> String {
+		return "\(savedSearch.scope.rawValue)|\(savedSearch.location?.driveID ?? "")|\(savedSearch.location?.path ?? "")|\(savedSearch.searchTerm)"
+	}
+
+	public var items: [OCItem] {
+		return Array(itemsByLocalID.values)
+	}
+
+	public var isRunning: Bool {
+		return (query != nil) || (syncAnchorObservation != nil)
+	}
+
+	// MARK: - Live updates
+	/// Starts a long-lived query for the condition. The core keeps the query up to date from its item change sets, which are then applied to this result set as deltas.
+	public func start(in core: OCCore) {
+		guard query == nil else { return }
+
+		let query = OCQuery(condition: condition, inputFilter: nil)
+		DisplaySettings.shared.updateQuery(withDisplaySettings: query)
+
+		self.core = core
+		self.query = query
+
+		// Everything up to this sync anchor is reflected once the query has completed its initial run
+		querySyncAnchor = core.latestSyncAnchor
+
+		queryStateObservation = query.observe(\OCQuery.state, options: [], changeHandler: { [weak self] query, _ in
+			OnMainThread(inline: true) {
+				self?.reconcileIfComplete()
+			}
+		})
+
+		querySubscription = query.queryResultsDataSource?.subscribe(updateHandler: { [weak self] (subscription) in
+			self?.applyChanges(from: subscription)
+		}, on: .main, trackDifferences: true, performInitialUpdate: true)
+
+		core.start(query)
+	}
+
+	/// Keeps a result set that is current as of `syncAnchor` up to date by retrieving the items changed since then from the database whenever the core's sync anchor changes.
+	public func startFollowingChanges(in core: OCCore) {
+		guard !isRunning, syncAnchor != nil, let database = core.vault.database else {
+			start(in: core)
+			return
+		}
+
+		self.core = core
+		self.database = database
+
+		syncAnchorObservation = core.observe(\OCCore.latestSyncAnchor, options: [.initial], changeHandler: { [weak self] (core, _) in
+			OnMainThread {
+				self?.retrieveChanges()
+			}
+		})
+	}
+
+	private func retrieveChanges() {
+		guard syncAnchorObservation != nil, let database, let syncAnchor else { return }
+
+		if isRetrievingChanges {
+			needsChangeRetrieval = true
+			return
+		}
+
+		isRetrievingChanges = true
+		needsChangeRetrieval = false
+
+		database.retrieveCacheItemsUpdated(sinceSyncAnchor: syncAnchor, foldersOnly: false, completionHandler: { [weak self] (_, error, newSyncAnchor, changedItems) in
+			OnMainThread {
+				guard let self else { return }
+
+				self.isRetrievingChanges = false
+
+				if error == nil {
+					self.apply(changedItems: changedItems ?? [], removedLocalIDs: [], syncAnchor: newSyncAnchor ?? syncAnchor)
+				}
+
+				if self.needsChangeRetrieval {
+					self.retrieveChanges()
+				}
+			}
+		})
+	}
+
+	public func stop() {
+		syncAnchorObservation?.invalidate()
+		syncAnchorObservation = nil
+
+		querySubscription?.terminate()
+		querySubscription = nil
+
+		queryStateObservation?.invalidate()
+		queryStateObservation = nil
+
+		if let query {
+			core?.stop(query)
+		}
+		query = nil
+	}
+
+	private func applyChanges(from subscription: OCDataSourceSubscription) {
+		guard let source = query?.queryResultsDataSource else { return }
+
+		let snapshot = subscription.snapshotResettingChangeTracking(true)
+		var changedItems: [OCItem] = []
+		var removedLocalIDs: [OCLocalID] = []
+
+		let changedRefs = Array(snapshot.addedItems ?? []) + Array(snapshot.updatedItems ?? [])
+
+		for itemRef in changedRefs {
+			if let item = (try? source.record(forItemRef: itemRef))?.item as? OCItem {
+				changedItems.append(item)
+			}
+		}
+
+		for itemRef in snapshot.removedItems ?? [] {
+			if let localID = itemRef as? OCLocalID {
+				removedLocalIDs.append(localID)
+			}
+		}
+
+		apply(changedItems: changedItems, removedLocalIDs: removedLocalIDs)
+
+		if isReconciled {
+			// Changes delivered up to the previous update are reflected now - a slightly older sync anchor only means some changes are applied again on restore
+			syncAnchor = querySyncAnchor
+			querySyncAnchor = core?.latestSyncAnchor
+		}
+
+		reconcileIfComplete()
+	}
+
+	/// Once the query has finished its initial run, removes restored items that are no longer part of the result.
+	private func reconcileIfComplete() {
+		guard !isReconciled, let query, query.state == .idle, let source = query.queryResultsDataSource,
+		      let itemRefs = (querySubscription?.snapshotResettingChangeTracking(false))?.items else { return }
+
+		var currentLocalIDs = Set<OCLocalID>()
+
+		for itemRef in itemRefs {
+			if let item = (try? source.record(forItemRef: itemRef))?.item as? OCItem, let localID = item.localID {
+				currentLocalIDs.insert(localID)
+			}
+		}
+
+		isReconciled = true
+		syncAnchor = querySyncAnchor
+
+		apply(changedItems: [], removedLocalIDs: itemsByLocalID.keys.filter({ !currentLocalIDs.contains($0) }))
+	}
+
+	// MARK: - Change sets
+	/// Applies a change set to the result set. Changed items are re-evaluated against the condition and inserted, updated or removed accordingly. Items not contained in the change set are not touched.
+	/// If the change set contains all changes up to a sync anchor, pass it as `syncAnchor`.
+	@discardableResult public func apply(changedItems: [OCItem], removedLocalIDs: [OCLocalID], syncAnchor: OCSyncAnchor? = nil, publish: Bool = true) -> Bool {
+		var changed = false
+
+		if let syncAnchor {
+			self.syncAnchor = syncAnchor
+		}
+
+		for localID in removedLocalIDs {
+			if itemsByLocalID.removeValue(forKey: localID) != nil {
+				changed = true
+			}
+		}
+
+		for item in changedItems {
+			guard let localID = item.localID else { continue }
+
+			if !item.removed, condition.fulfilled(by: item) {
+				itemsByLocalID[localID] = item
+				changed = true
+			} else if itemsByLocalID.removeValue(forKey: localID) != nil {
+				changed = true
+			}
+		}
+
+		if changed {
+			if publish {
+				publishItems()
+			}
+			schedulePersist()
+		}
+
+		return changed
+	}
+
+	public func publishItems() {
+		dataSource.setVersionedItems(items)
+	}
+
+	// MARK: - Persistence
+	func persistedArchive() -> [String : Any]? {
+		guard let storageURL, let data = try? Data(contentsOf: storageURL),
+		      let archive = try? NSKeyedUnarchiver.unarchivedObject(ofClasses: [NSDictionary.self, NSArray.self, NSString.self, NSNumber.self], from: data) as? [String : Any],
+		      let archivedSignature = archive["signature"] as? String, archivedSignature == signature else {
+			return nil
+		}
+
+		return archive
+	}
+
+	/// Returns the local IDs persisted for the same saved search signature, or nil if none were persisted.
+	public func persistedLocalIDs() -> [OCLocalID]? {
+		return persistedArchive()?["localIDs"] as? [OCLocalID]
+	}
+
+	/// Restores the result set from the local IDs persisted for the same saved search signature. The current versions of the items are retrieved from the database
+	/// in batches of `restoreBatchSize`. If a sync anchor was persisted, the items changed since then are applied, too - so that the restored result set is current
+	/// and doesn't need to be re-queried. Calls the completion handler on the main thread with `restored` = true if a result set could be restored, and `isCurrent` = true
+	/// if it has also been brought up to date.
+	public func restore(from database: OCDatabase, completionHandler: ((_ restored: Bool, _ isCurrent: Bool) -> Void)? = nil) {
+		guard let archive = persistedArchive(), let localIDs = archive["localIDs"] as? [OCLocalID] else {
+			completionHandler?(false, false)
+			return
+		}
+
+		let persistedSyncAnchor = archive["syncAnchor"] as? OCSyncAnchor
+		let retrievalGroup = DispatchGroup()
+		var restoredItems: [OCItem] = []
+		var retrievalFailed = false
+
+		for batchStart in stride(from: 0, to: localIDs.count, by: restoreBatchSize) {
+			let batch = localIDs[batchStart ..< min(batchStart + restoreBatchSize, localIDs.count)]
+			let batchCondition = OCQueryCondition.any(of: batch.map({ OCQueryCondition.where(.localID, isEqualTo: $0) }))
+
+			retrievalGroup.enter()
+
+			database.retrieveCacheItems(for: batchCondition, cancelAction: nil, completionHandler: { (_, error, _, items) in
+				OCSynchronized(retrievalGroup) {
+					if error != nil {
+						retrievalFailed = true
+					}
+
+					if let items {
+						restoredItems.append(contentsOf: items)
+					}
+				}
+				retrievalGroup.leave()
+			})
+		}
+
+		var changedItems: [OCItem]?
+		var changesSyncAnchor: OCSyncAnchor?
+
+		if let persistedSyncAnchor {
+			retrievalGroup.enter()
+
+			// Enqueued after the batches, so changes made while restoring are contained
+			database.retrieveCacheItemsUpdated(sinceSyncAnchor: persistedSyncAnchor, foldersOnly: false, completionHandler: { (_, error, newSyncAnchor, items) in
+				if error == nil {
+					changedItems = items ?? []
+					changesSyncAnchor = newSyncAnchor ?? persistedSyncAnchor
+				}
+				retrievalGroup.leave()
+			})
+		}
+
+		retrievalGroup.notify(queue: .main) { [weak self] in
+			guard let self else { return }
+
+			// Items delivered by the running query in the meantime are more recent - and once reconciled, the query's results are complete
+			if !self.isReconciled {
+				self.apply(changedItems: restoredItems.filter({ item in
+					if let localID = item.localID {
+						return self.itemsByLocalID[localID] == nil
+					}
+					return false
+				}), removedLocalIDs: [])
+			}
+
+			self.wasRestored = true
+
+			var isCurrent = false
+
+			if !self.isReconciled, !retrievalFailed, let changedItems, let changesSyncAnchor {
+				self.apply(changedItems: changedItems, removedLocalIDs: [], syncAnchor: changesSyncAnchor)
+				self.isReconciled = true
+
+				isCurrent = true
+			}
+
+			completionHandler?(true, isCurrent)
+		}
+	}
+
+	private func schedulePersist() {
+		guard storageURL != nil else { return }
+
+		persistRateLimiter.runRateLimitedBlock { [weak self] in
+			OnMainThread {
+				self?.persist()
+			}
+		}
+	}
+
+	/// Persists the local IDs of the items in the result set and the sync anchor they're current as of. The items themselves are retrieved from the database when restoring.
+	public func persist(completionHandler: (() -> Void)? = nil) {
+		guard let storageURL else {
+			completionHandler?()
+			return
+		}
+
+		var archive: [String : Any] = [
+			"signature" : signature,
+			"localIDs" : Array(itemsByLocalID.keys)
+		]
+
+		if let syncAnchor {
+			archive["syncAnchor"] = syncAnchor
+		}
+
+		OnBackgroundQueue {
+			if let data = try? NSKeyedArchiver.archivedData(withRootObject: archive, requiringSecureCoding: true) {
+				try? FileManager.default.createDirectory(at: storageURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+				try? data.write(to: storageURL, options: .atomic)
+			}
+
+			completionHandler?()
+		}
+	}
+
+	public func removePersistedResults() {
+		if let storageURL {
+			try? FileManager.default.removeItem(at: storageURL)
+		}
+	}
+}
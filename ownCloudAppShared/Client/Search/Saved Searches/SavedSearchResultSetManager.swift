@@ -0,0 +1,113 @@
+//
+//  SavedSearchResultSetManager.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+import ownCloudSDK
+import ownCloudApp
+
+/// Keeps the materialized result sets of an account's saved searches alive for as long as the account connection has a core.
+open class SavedSearchResultSetManager: NSObject {
+	weak var core: OCCore?
+	var resultSetsByUUID: [OCSavedSearchUUID : SavedSearchResultSet] = [:]
+
+	let storageRootURL: URL?
+
+	public init(core: OCCore, storageRootURL: URL? = nil) {
+		self.core = core
+		self.storageRootURL = storageRootURL ?? core.vault.rootURL?.appendingPathComponent("SavedSearchResults", isDirectory: true)
+
+		super.init()
+
+		core.vault.addSavedSearchesObserver(self, withInitial: false, updateHandler: { (owner, savedSearches, isInitial) in
+			(owner as? SavedSearchResultSetManager)?.savedSearchesChanged(savedSearches)
+		})
+	}
+
+	deinit {
+		shutdown()
+	}
+
+	/// Returns the result set for the saved search, creating, restoring and starting it on first use.
+	public func resultSet(for savedSearch: OCSavedSearch, condition: OCQueryCondition) -> SavedSearchResultSet? {
+		guard let core else { return nil }
+
+		if let resultSet = resultSetsByUUID[savedSearch.uuid] {
+			if resultSet.signature == SavedSearchResultSet.signature(for: savedSearch) {
+				return resultSet
+			}
+
+			// Saved search was changed - discard outdated result set
+			resultSet.stop()
+			resultSet.removePersistedResults()
+		}
+
+		let resultSet = SavedSearchResultSet(savedSearch: savedSearch, condition: condition, storageURL: storageRootURL?.appendingPathComponent(savedSearch.uuid).appendingPathExtension("archive"))
+
+		if let database = core.vault.database, resultSet.persistedLocalIDs() != nil {
+			// Restore the persisted result set. If it could be brought up to date, follow the database's changes instead of re-running the full query.
+			resultSet.restore(from: database, completionHandler: { [weak self, weak resultSet] (_, isCurrent) in
+				guard let self, let resultSet, self.resultSetsByUUID[savedSearch.uuid] === resultSet, let core = self.core else { return }
+
+				if isCurrent {
+					resultSet.startFollowingChanges(in: core)
+				} else {
+					resultSet.start(in: core)
+				}
+			})
+		} else {
+			resultSet.start(in: core)
+		}
+
+		resultSetsByUUID[savedSearch.uuid] = resultSet
+
+		return resultSet
+	}
+
+	func savedSearchesChanged(_ savedSearches: [OCSavedSearch]?) {
+		let existingUUIDs = Set((savedSearches ?? []).map({ $0.uuid }))
+
+		for (uuid, resultSet) in resultSetsByUUID where !existingUUIDs.contains(uuid) {
+			resultSet.stop()
+			resultSet.removePersistedResults()
+			resultSetsByUUID[uuid] = nil
+		}
+	}
+
+	/// Persists and stops all result sets. The completion handler is called once all result sets have been persisted.
+	public func shutdown(completionHandler: (() -> Void)? = nil) {
+		let persistGroup = DispatchGroup()
+
+		for resultSet in resultSetsByUUID.values {
+			persistGroup.enter()
+			resultSet.persist(completionHandler: {
+				persistGroup.leave()
+			})
+			resultSet.stop()
+		}
+
+		resultSetsByUUID.removeAll()
+
+		persistGroup.notify(queue: .main) {
+			completionHandler?()
+		}
+	}
+
+	public var activeResultSetCount: Int {
+		return resultSetsByUUID.count
+	}
+}
@@ -26,6 +26,8 @@ open class SearchTokenizer: NSObject {
 
 	weak var searchField: UISearchTextField?
 
+	private let segmenter = OCSearchSegmenter(quotationMarks: false)
+
 	public init(scope: SearchScope, clientContext: ClientContext?) {
 		super.init()
 
@@ -56,7 +58,10 @@ open class SearchTokenizer: NSObject {
 		var assembledElements : [SearchElement] = []
 
 		// Find terms and tokens in provided searchTerm
-		if let searchSegments = term?.segmentedForSearch(withQuotationMarks: false, cursorPosition: (cursorOffset as? NSNumber)) {
+		if let term {
+			// Only re-segments the part of the term that changed since the last call
+			let searchSegments = segmenter.segments(for: term, cursorPosition: (cursorOffset as? NSNumber))
+
 			Log.log("SearchSegments: \(String.init(describing: searchSegments))")
 
 			for searchSegment in searchSegments.reversed() { // Iterate segments in reverse so that replacing a segment doesn't change its position
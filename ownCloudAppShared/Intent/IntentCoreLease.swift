@@ -0,0 +1,167 @@
+//
+//  IntentCoreLease.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import ownCloudSDK
+
+public protocol IntentCoreProvider: AnyObject {
+	func requestCore(for bookmark: OCBookmark, setup setupHandler: ((OCCore?, Error?) -> Void)?, completionHandler: @escaping (OCCore?, Error?) -> Void)
+	func returnCore(for bookmark: OCBookmark, completionHandler: (() -> Void)?)
+}
+
+extension OCCoreManager: IntentCoreProvider {
+}
+
+/// Keeps cores requested by intent handlers warm for a short time after their last use, so that automations running several intents in a row only pay for the core startup once.
+///
+/// Since a core can be shared by several intent handlers, the lease acts as the core's delegate and forwards errors to the delegates of all current users of the core.
+public class IntentCoreLease: NSObject, OCCoreDelegate {
+	public typealias CompletionHandler = (_ core: OCCore?, _ error: Error?) -> Void
+
+	public static let shared = IntentCoreLease(provider: OCCoreManager.shared)
+
+	class Lease {
+		var bookmark: OCBookmark
+		var core: OCCore?
+		var isRequesting: Bool = false
+		var useCount: Int = 0
+		var pendingHandlers: [CompletionHandler] = []
+		var returnWorkItem: DispatchWorkItem?
+		var delegates: NSHashTable<OCCoreDelegate> = NSHashTable.weakObjects()
+
+		init(bookmark: OCBookmark) {
+			self.bookmark = bookmark
+		}
+	}
+
+	let provider: IntentCoreProvider
+	public var idleTimeout: TimeInterval
+
+	private let leaseQueue = DispatchQueue(label: "com.owncloud.intent-core-lease")
+	private var leasesByBookmarkUUID: [UUID : Lease] = [:]
+
+	public init(provider: IntentCoreProvider, idleTimeout: TimeInterval = 20) {
+		self.provider = provider
+		self.idleTimeout = idleTimeout
+		super.init()
+	}
+
+	/// Provides a core for the bookmark, re-using a warm core if one is available. Every successful call must be balanced by a call to `release(for:delegate:)`. The `setup` handler is only called if a new core needs to be requested. `delegate` receives the core's errors until it is released.
+	public func acquire(for bookmark: OCBookmark, delegate: OCCoreDelegate? = nil, setup: CompletionHandler? = nil, completionHandler: @escaping CompletionHandler) {
+		leaseQueue.async {
+			let lease = self.leasesByBookmarkUUID[bookmark.uuid] ?? Lease(bookmark: bookmark)
+			self.leasesByBookmarkUUID[bookmark.uuid] = lease
+
+			// Cancel pending return of the core
+			lease.returnWorkItem?.cancel()
+			lease.returnWorkItem = nil
+
+			if let delegate {
+				lease.delegates.add(delegate)
+			}
+
+			if let core = lease.core {
+				// Warm core available
+				lease.useCount += 1
+				completionHandler(core, nil)
+				return
+			}
+
+			lease.pendingHandlers.append(completionHandler)
+
+			if !lease.isRequesting {
+				lease.isRequesting = true
+
+				self.provider.requestCore(for: bookmark, setup: { (core, error) in
+					core?.delegate = self
+					setup?(core, error)
+				}, completionHandler: { (core, error) in
+					self.leaseQueue.async {
+						let handlers = lease.pendingHandlers
+
+						lease.isRequesting = false
+						lease.pendingHandlers.removeAll()
+
+						if let core, error == nil {
+							lease.core = core
+							lease.useCount += handlers.count
+						} else {
+							lease.delegates.removeAllObjects()
+							self.leasesByBookmarkUUID[bookmark.uuid] = nil
+						}
+
+						for handler in handlers {
+							handler(core, error)
+						}
+					}
+				})
+			}
+		}
+	}
+
+	/// Ends a use of the core acquired via `acquire(for:…)`. The core is returned after `idleTimeout` if it isn't acquired again in the meantime.
+	public func release(for bookmark: OCBookmark, delegate: OCCoreDelegate? = nil, completionHandler: (() -> Void)? = nil) {
+		leaseQueue.async {
+			guard let lease = self.leasesByBookmarkUUID[bookmark.uuid], lease.core != nil else {
+				completionHandler?()
+				return
+			}
+
+			if let delegate {
+				lease.delegates.remove(delegate)
+			}
+
+			lease.useCount -= 1
+
+			if lease.useCount <= 0 {
+				lease.useCount = 0
+
+				let returnWorkItem = DispatchWorkItem { [weak self, weak lease] in
+					guard let self, let lease, lease.useCount == 0, lease.core != nil else { return }
+
+					lease.core = nil
+					lease.returnWorkItem = nil
+					self.leasesByBookmarkUUID[bookmark.uuid] = nil
+
+					self.provider.returnCore(for: bookmark, completionHandler: nil)
+				}
+
+				lease.returnWorkItem = returnWorkItem
+
+				if self.idleTimeout > 0 {
+					self.leaseQueue.asyncAfter(deadline: .now() + self.idleTimeout, execute: returnWorkItem)
+				} else {
+					returnWorkItem.perform()
+				}
+			}
+
+			completionHandler?()
+		}
+	}
+
+	// MARK: - Core delegate
+	public func core(_ core: OCCore, handleError error: Error?, issue: OCIssue?) {
+		leaseQueue.async {
+			if let lease = self.leasesByBookmarkUUID[core.bookmark.uuid], (lease.core === core) || lease.isRequesting {
+				for delegate in lease.delegates.allObjects {
+					delegate.core(core, handleError: error, issue: issue)
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+//
+//  IntentDirectoryListingCache.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import ownCloudSDK
+
+/// Caches directory listings returned by intents, keyed by bookmark, path and sort order, for a short time, so that automations requesting the same listing several times in a row don't have to wait for a server roundtrip each time.
+///
+/// Entries are served until they expire, without checking with the server. The eTag passed in is the one locally known to the core, so it only invalidates entries early for changes the core has already seen - changes on the server become visible once the entry has expired.
+public class IntentDirectoryListingCache: NSObject {
+	public static let shared = IntentDirectoryListingCache()
+
+	struct Entry {
+		var eTag: String
+		var listing: [String]
+		var date: Date
+	}
+
+	public var maximumAge: TimeInterval
+	public var maximumEntries: Int
+
+	private var entriesByKey: [String : Entry] = [:]
+
+	public init(maximumAge: TimeInterval = 10, maximumEntries: Int = 64) {
+		self.maximumAge = maximumAge
+		self.maximumEntries = maximumEntries
+		super.init()
+	}
+
+	static func key(for bookmark: OCBookmark, path: String, sortType: Int, sortDirection: Int) -> String {
+		return "\(bookmark.uuid.uuidString)|\(path)|\(sortType)|\(sortDirection)"
+	}
+
+	/// Returns the cached listing if one exists for the same locally known eTag and hasn't expired.
+	public func listing(for bookmark: OCBookmark, path: String, sortType: Int, sortDirection: Int, eTag: String?) -> [String]? {
+		guard let eTag else { return nil }
+
+		let key = IntentDirectoryListingCache.key(for: bookmark, path: path, sortType: sortType, sortDirection: sortDirection)
+
+		var listing: [String]?
+
+		OCSynchronized(self) {
+			if let entry = entriesByKey[key] {
+				if entry.eTag == eTag, (-entry.date.timeIntervalSinceNow) <= maximumAge {
+					listing = entry.listing
+				} else {
+					entriesByKey[key] = nil
+				}
+			}
+		}
+
+		return listing
+	}
+
+	public func store(listing: [String], for bookmark: OCBookmark, path: String, sortType: Int, sortDirection: Int, eTag: String?) {
+		guard let eTag else { return }
+
+		let key = IntentDirectoryListingCache.key(for: bookmark, path: path, sortType: sortType, sortDirection: sortDirection)
+
+		OCSynchronized(self) {
+			if entriesByKey.count >= maximumEntries, entriesByKey[key] == nil {
+				// Evict oldest entry
+				if let oldestKey = entriesByKey.min(by: { $0.value.date < $1.value.date })?.key {
+					entriesByKey[oldestKey] = nil
+				}
+			}
+
+			entriesByKey[key] = Entry(eTag: eTag, listing: listing, date: Date())
+		}
+	}
+
+	public func removeAll(for bookmark: OCBookmark? = nil) {
+		OCSynchronized(self) {
+			if let bookmark {
+				let prefix = bookmark.uuid.uuidString + "|"
+				entriesByKey = entriesByKey.filter({ !$0.key.hasPrefix(prefix) })
+			} else {
+				entriesByKey.removeAll()
+			}
+		}
+	}
+}
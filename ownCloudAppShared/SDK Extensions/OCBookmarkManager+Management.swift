@@ -48,6 +48,8 @@ public extension OCBookmarkManager {
 				OCCoreManager.shared.scheduleOfflineOperation({ (bookmark, offlineOperationCompletion) in
 					let vault : OCVault = OCVault(bookmark: bookmark)
 
+					MediaRangeCache.removeCache(for: bookmark)
+
 					vault.erase(completionHandler: { (_, error) in
 						OnMainThread {
 							if error != nil {
@@ -0,0 +1,206 @@
+//
+//  LogBundleExporter.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+
+/// Streams log files into a single ZIP archive in one pass, optionally redacting their contents and limiting the total size to the newest entries.
+public class LogBundleExporter {
+	/// Receives a block of complete lines and returns the redacted version
+	public typealias Redactor = (_ lines: String) -> String
+
+	public struct LogFile {
+		public var url: URL
+		public var name: String
+		public var creationDate: Date?
+
+		public init(url: URL, name: String, creationDate: Date?) {
+			self.url = url
+			self.name = name
+			self.creationDate = creationDate
+		}
+	}
+
+	public struct Statistics {
+		public var includedBytes: Int64 = 0	//!< Uncompressed bytes read from the log files
+		public var omittedBytes: Int64 = 0	//!< Bytes of older entries left out because of the size limit
+		public var archiveBytes: Int64 = 0
+		public var duration: TimeInterval = 0
+	}
+
+	public var files: [LogFile]
+
+	/// Maximum number of uncompressed bytes to include. If the logs are larger, the oldest entries are left out.
+	public var maximumSize: Int64?
+	public var redactor: Redactor?
+
+	public var chunkSize: Int = 1024 * 1024
+
+	public init(files: [LogFile], maximumSize: Int64? = nil, redactor: Redactor? = nil) {
+		self.files = files
+		self.maximumSize = maximumSize
+		self.redactor = redactor
+	}
+
+	// MARK: - Export
+	/// Exports the logs to `archiveURL` on a background queue and calls `completionHandler` with the result on that queue
+	@discardableResult public func export(to archiveURL: URL, completionHandler: @escaping (_ statistics: Statistics?, _ error: Error?) -> Void) -> Progress {
+		let progress = Progress(totalUnitCount: 0)
+
+		DispatchQueue.global(qos: .userInitiated).async {
+			do {
+				let statistics = try self.export(to: archiveURL, progress: progress)
+				completionHandler(statistics, nil)
+			} catch {
+				completionHandler(nil, error)
+			}
+		}
+
+		return progress
+	}
+
+	public func export(to archiveURL: URL, progress: Progress? = nil) throws -> Statistics {
+		let startTime = Date()
+		var statistics = Statistics()
+
+		// Determine which part of each file to include, starting with the newest file
+		let newestFirst = files.sorted(by: { ($0.creationDate ?? .distantPast) > ($1.creationDate ?? .distantPast) })
+		var remainingBudget = maximumSize ?? Int64.max
+		var includedParts: [(file: LogFile, offset: Int64, size: Int64)] = []
+
+		for file in newestFirst {
+			let size = Int64((try? file.url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+			let includedSize = min(size, remainingBudget)
+
+			remainingBudget -= includedSize
+			statistics.omittedBytes += size - includedSize
+
+			if includedSize > 0 {
+				includedParts.append((file, size - includedSize, includedSize))
+			}
+		}
+
+		progress?.totalUnitCount = includedParts.reduce(0) { $0 + $1.size }
+
+		// Write oldest file first
+		let writer = try ZIPStreamWriter(outputURL: archiveURL)
+
+		do {
+			for part in includedParts.reversed() {
+				try writer.beginEntry(named: part.file.name, modificationDate: part.file.creationDate ?? Date())
+				statistics.includedBytes += try stream(part.file.url, from: part.offset, into: writer, progress: progress)
+				try writer.endEntry()
+			}
+
+			try writer.finish()
+		} catch {
+			try? FileManager.default.removeItem(at: archiveURL)
+			throw error
+		}
+
+		statistics.archiveBytes = Int64(writer.bytesWritten)
+		statistics.duration = Date().timeIntervalSince(startTime)
+
+		return statistics
+	}
+
+	private func stream(_ fileURL: URL, from offset: Int64, into writer: ZIPStreamWriter, progress: Progress?) throws -> Int64 {
+		let fileHandle = try FileHandle(forReadingFrom: fileURL)
+		defer {
+			try? fileHandle.close()
+		}
+
+		let newline = UInt8(ascii: "\n")
+		var skipPartialLine = (offset > 0)
+		var carryOver = Data()
+		var readBytes: Int64 = 0
+
+		if offset > 0 {
+			try fileHandle.seek(toOffset: UInt64(offset))
+			try writer.write(Data("[… \(offset) bytes of older log entries omitted …]\n".utf8))
+		}
+
+		while true {
+			if progress?.isCancelled == true {
+				throw CocoaError(.userCancelled)
+			}
+
+			let chunk: Data? = try autoreleasepool {
+				return try fileHandle.read(upToCount: chunkSize)
+			}
+
+			guard var chunk, chunk.count > 0 else {
+				break
+			}
+
+			readBytes += Int64(chunk.count)
+			progress?.completedUnitCount += Int64(chunk.count)
+
+			if skipPartialLine {
+				// Start with the first complete line after the offset
+				guard let newlineIndex = chunk.firstIndex(of: newline) else {
+					continue
+				}
+
+				chunk = chunk.subdata(in: (newlineIndex + 1) ..< chunk.endIndex)
+				skipPartialLine = false
+			}
+
+			if let redactor {
+				// Only pass complete lines to the redactor, carrying the rest over to the next chunk
+				carryOver.append(chunk)
+
+				if let lastNewlineIndex = carryOver.lastIndex(of: newline) {
+					let lines = carryOver.subdata(in: carryOver.startIndex ..< (lastNewlineIndex + 1))
+
+					carryOver = carryOver.subdata(in: (lastNewlineIndex + 1) ..< carryOver.endIndex)
+
+					try writer.write(Data(redactor(String(decoding: lines, as: UTF8.self)).utf8))
+				}
+			} else {
+				try writer.write(chunk)
+			}
+		}
+
+		if let redactor, carryOver.count > 0 {
+			try writer.write(Data(redactor(String(decoding: carryOver, as: UTF8.self)).utf8))
+		}
+
+		return readBytes
+	}
+
+	// MARK: - Redaction
+	/// Redacts e-mail addresses, credentials in URLs, authorization headers and password/token parameters
+	public static func makeDefaultRedactor() -> Redactor {
+		let replacements: [(NSRegularExpression?, String)] = [
+			(try? NSRegularExpression(pattern: "[A-Z0-9._%+-]+@[A-Z0-9.-]+\\.[A-Z]{2,}", options: .caseInsensitive), "[redacted-email]"),
+			(try? NSRegularExpression(pattern: "(https?://)[^/\\s:@]+(:[^/\\s@]*)?@", options: .caseInsensitive), "$1[redacted]@"),
+			(try? NSRegularExpression(pattern: "\\b(bearer|basic)[ \\t]+[A-Za-z0-9._~+/-]+=*", options: .caseInsensitive), "$1 [redacted]"),
+			(try? NSRegularExpression(pattern: "\\b((?:password|passwd|access_token|refresh_token|token)\"?[ \\t]*[=:][ \\t]*\"?)[^\\s\"&,;]+", options: .caseInsensitive), "$1[redacted]")
+		]
+
+		return { (lines) in
+			let mutableLines = NSMutableString(string: lines)
+
+			for (regex, template) in replacements {
+				regex?.replaceMatches(in: mutableLines, range: NSRange(location: 0, length: mutableLines.length), withTemplate: template)
+			}
+
+			return mutableLines as String
+		}
+	}
+}
@@ -0,0 +1,312 @@
+//
+//  ZIPStreamWriter.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import Foundation
+import Compression
+
+public enum ZIPStreamWriterError : Error {
+	case compressionFailed
+	case noOpenEntry
+	case archiveTooLarge
+}
+
+/// Writes a ZIP archive of DEFLATE-compressed entries in a single pass: entry data is compressed as it is written and sizes and checksums
+/// follow the data in data descriptors, so neither the input nor the output ever needs to be held in memory or re-read.
+public class ZIPStreamWriter {
+	struct EntryRecord {
+		var name: Data
+		var dosTime: UInt16
+		var dosDate: UInt16
+		var crc32: UInt32
+		var compressedSize: UInt64
+		var uncompressedSize: UInt64
+		var localHeaderOffset: UInt64
+	}
+
+	private let fileHandle: FileHandle
+	private var outputBuffer = Data()
+	private var outputOffset: UInt64 = 0
+	private let outputBufferFlushSize = 1024 * 1024
+
+	private var entries: [EntryRecord] = []
+	private var currentEntry: EntryRecord?
+
+	private var stream: UnsafeMutablePointer<compression_stream>?
+	private var streamBuffer: UnsafeMutablePointer<UInt8>
+	private let streamBufferSize = 256 * 1024
+
+	public var bytesWritten: UInt64 {
+		return outputOffset
+	}
+
+	public init(outputURL: URL) throws {
+		guard FileManager.default.createFile(atPath: outputURL.path, contents: nil) else {
+			throw CocoaError(.fileWriteUnknown)
+		}
+
+		fileHandle = try FileHandle(forWritingTo: outputURL)
+		streamBuffer = UnsafeMutablePointer<UInt8>.allocate(capacity: streamBufferSize)
+	}
+
+	deinit {
+		destroyStream()
+		streamBuffer.deallocate()
+		try? fileHandle.close()
+	}
+
+	// MARK: - Entries
+	public func beginEntry(named name: String, modificationDate: Date = Date()) throws {
+		if currentEntry != nil {
+			try endEntry()
+		}
+
+		let stream = UnsafeMutablePointer<compression_stream>.allocate(capacity: 1)
+
+		// COMPRESSION_ZLIB produces raw DEFLATE data, as required by ZIP
+		guard compression_stream_init(stream, COMPRESSION_STREAM_ENCODE, COMPRESSION_ZLIB) == COMPRESSION_STATUS_OK else {
+			stream.deallocate()
+			throw ZIPStreamWriterError.compressionFailed
+		}
+
+		self.stream = stream
+
+		let (dosTime, dosDate) = ZIPStreamWriter.dosDateTime(for: modificationDate)
+		let entry = EntryRecord(name: Data(name.utf8), dosTime: dosTime, dosDate: dosDate, crc32: 0, compressedSize: 0, uncompressedSize: 0, localHeaderOffset: outputOffset)
+
+		// Local file header
+		var header = Data()
+		header.appendLittleEndian(UInt32(0x04034b50))
+		header.appendLittleEndian(UInt16(20)) // Version needed to extract (2.0)
+		header.appendLittleEndian(UInt16(0x0808)) // Flags: sizes and CRC in data descriptor, UTF-8 name
+		header.appendLittleEndian(UInt16(8)) // Method: DEFLATE
+		header.appendLittleEndian(entry.dosTime)
+		header.appendLittleEndian(entry.dosDate)
+		header.appendLittleEndian(UInt32(0)) // CRC-32
+		header.appendLittleEndian(UInt32(0)) // Compressed size
+		header.appendLittleEndian(UInt32(0)) // Uncompressed size
+		header.appendLittleEndian(UInt16(entry.name.count))
+		header.appendLittleEndian(UInt16(0)) // Extra field length
+		header.append(entry.name)
+
+		try output(header)
+
+		currentEntry = entry
+	}
+
+	public func write(_ data: Data) throws {
+		guard currentEntry != nil else {
+			throw ZIPStreamWriterError.noOpenEntry
+		}
+
+		guard data.count > 0 else { return }
+
+		currentEntry?.crc32 = CRC32.update(currentEntry?.crc32 ?? 0, with: data)
+		currentEntry?.uncompressedSize += UInt64(data.count)
+
+		try process(data, finalize: false)
+	}
+
+	public func endEntry() throws {
+		guard currentEntry != nil else {
+			throw ZIPStreamWriterError.noOpenEntry
+		}
+
+		try process(Data(), finalize: true)
+		destroyStream()
+
+		guard var entry = currentEntry else { return }
+
+		entry.compressedSize = outputOffset - entry.localHeaderOffset - UInt64(30 + entry.name.count)
+
+		guard entry.compressedSize <= UInt32.max, entry.uncompressedSize <= UInt32.max, outputOffset <= UInt32.max else {
+			// Larger archives require ZIP64 extensions
+			throw ZIPStreamWriterError.archiveTooLarge
+		}
+
+		// Data descriptor
+		var descriptor = Data()
+		descriptor.appendLittleEndian(UInt32(0x08074b50))
+		descriptor.appendLittleEndian(entry.crc32)
+		descriptor.appendLittleEndian(UInt32(entry.compressedSize))
+		descriptor.appendLittleEndian(UInt32(entry.uncompressedSize))
+
+		try output(descriptor)
+
+		entries.append(entry)
+		currentEntry = nil
+	}
+
+	/// Writes the central directory and closes the archive
+	public func finish() throws {
+		if currentEntry != nil {
+			try endEntry()
+		}
+
+		let centralDirectoryOffset = outputOffset
+		var centralDirectory = Data()
+
+		for entry in entries {
+			centralDirectory.appendLittleEndian(UInt32(0x02014b50))
+			centralDirectory.appendLittleEndian(UInt16(20)) // Version made by
+			centralDirectory.appendLittleEndian(UInt16(20)) // Version needed to extract
+			centralDirectory.appendLittleEndian(UInt16(0x0808))
+			centralDirectory.appendLittleEndian(UInt16(8))
+			centralDirectory.appendLittleEndian(entry.dosTime)
+			centralDirectory.appendLittleEndian(entry.dosDate)
+			centralDirectory.appendLittleEndian(entry.crc32)
+			centralDirectory.appendLittleEndian(UInt32(entry.compressedSize))
+			centralDirectory.appendLittleEndian(UInt32(entry.uncompressedSize))
+			centralDirectory.appendLittleEndian(UInt16(entry.name.count))
+			centralDirectory.appendLittleEndian(UInt16(0)) // Extra field length
+			centralDirectory.appendLittleEndian(UInt16(0)) // Comment length
+			centralDirectory.appendLittleEndian(UInt16(0)) // Disk number
+			centralDirectory.appendLittleEndian(UInt16(0)) // Internal attributes
+			centralDirectory.appendLittleEndian(UInt32(0)) // External attributes
+			centralDirectory.appendLittleEndian(UInt32(entry.localHeaderOffset))
+			centralDirectory.append(entry.name)
+		}
+
+		try output(centralDirectory)
+
+		// End of central directory record
+		var endRecord = Data()
+		endRecord.appendLittleEndian(UInt32(0x06054b50))
+		endRecord.appendLittleEndian(UInt16(0)) // Disk number
+		endRecord.appendLittleEndian(UInt16(0)) // Disk with central directory
+		endRecord.appendLittleEndian(UInt16(entries.count))
+		endRecord.appendLittleEndian(UInt16(entries.count))
+		endRecord.appendLittleEndian(UInt32(centralDirectory.count))
+		endRecord.appendLittleEndian(UInt32(centralDirectoryOffset))
+		endRecord.appendLittleEndian(UInt16(0)) // Comment length
+
+		try output(endRecord)
+		try flush()
+
+		try fileHandle.close()
+	}
+
+	// MARK: - Compression
+	private func process(_ data: Data, finalize: Bool) throws {
+		guard let stream else {
+			throw ZIPStreamWriterError.noOpenEntry
+		}
+
+		let flags = finalize ? Int32(COMPRESSION_STREAM_FINALIZE.rawValue) : 0
+
+		try data.withUnsafeBytes { (sourceBuffer: UnsafeRawBufferPointer) in
+			stream.pointee.src_ptr = sourceBuffer.bindMemory(to: UInt8.self).baseAddress ?? UnsafePointer(streamBuffer)
+			stream.pointee.src_size = sourceBuffer.count
+
+			repeat {
+				stream.pointee.dst_ptr = streamBuffer
+				stream.pointee.dst_size = streamBufferSize
+
+				let status = compression_stream_process(stream, flags)
+
+				if status == COMPRESSION_STATUS_ERROR {
+					throw ZIPStreamWriterError.compressionFailed
+				}
+
+				let producedCount = streamBufferSize - stream.pointee.dst_size
+
+				if producedCount > 0 {
+					try output(Data(bytes: streamBuffer, count: producedCount))
+				}
+
+				if finalize, status == COMPRESSION_STATUS_END {
+					break
+				}
+
+				if !finalize, stream.pointee.src_size == 0, stream.pointee.dst_size > 0 {
+					break
+				}
+			} while true
+		}
+	}
+
+	private func destroyStream() {
+		if let stream {
+			compression_stream_destroy(stream)
+			stream.deallocate()
+			self.stream = nil
+		}
+	}
+
+	// MARK: - Output
+	private func output(_ data: Data) throws {
+		outputBuffer.append(data)
+		outputOffset += UInt64(data.count)
+
+		if outputBuffer.count >= outputBufferFlushSize {
+			try flush()
+		}
+	}
+
+	private func flush() throws {
+		if outputBuffer.count > 0 {
+			try fileHandle.write(contentsOf: outputBuffer)
+			outputBuffer.removeAll(keepingCapacity: true)
+		}
+	}
+
+	// MARK: - Tools
+	static func dosDateTime(for date: Date) -> (time: UInt16, date: UInt16) {
+		let components = Calendar(identifier: .gregorian).dateComponents([.year, .month, .day, .hour, .minute, .second], from: date)
+		let year = max((components.year ?? 1980) - 1980, 0)
+
+		let time = UInt16(((components.hour ?? 0) << 11) | ((components.minute ?? 0) << 5) | ((components.second ?? 0) / 2))
+		let date = UInt16((year << 9) | ((components.month ?? 1) << 5) | (components.day ?? 1))
+
+		return (time, date)
+	}
+}
+
+// MARK: - CRC-32
+public struct CRC32 {
+	static let table: [UInt32] = (0 ..< 256).map { (index: UInt32) in
+		var value = index
+
+		for _ in 0 ..< 8 {
+			value = ((value & 1) != 0) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1)
+		}
+
+		return value
+	}
+
+	/// Continues the checksum `crc` (starting at 0) with the bytes in `data`
+	public static func update(_ crc: UInt32, with data: Data) -> UInt32 {
+		var value = ~crc
+
+		table.withUnsafeBufferPointer { table in
+			data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+				for byte in bytes {
+					value = table[Int((value ^ UInt32(byte)) & 0xFF)] ^ (value >> 8)
+				}
+			}
+		}
+
+		return ~value
+	}
+}
+
+extension Data {
+	mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+		var littleEndianValue = value.littleEndian
+		Swift.withUnsafeBytes(of: &littleEndianValue) { append(contentsOf: $0) }
+	}
+}
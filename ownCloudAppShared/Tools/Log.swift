@@ -46,43 +46,35 @@ public class Log {
 		return "level=\(OCLogger.logLevel.label), destinations=\(OCLogger.shared.writers.filter({ (writer) -> Bool in writer.enabled}).map({ (writer) -> String in writer.identifier.rawValue })), options=\(OCLogger.shared.toggles.filter({ (toggle) -> Bool in toggle.enabled}).map({ (toggle) -> String in toggle.identifier.rawValue })), maskPrivateData=\( OCLogger.maskPrivateData ? "true" : "false" )"
 	}
 
-	static public func debug(tagged : [String]? = nil, _ message: String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
-		withVaList(parameters) { va_list in
- 			var tags : [String] = ["APP"]
-
-			if tagged != nil {
-				tags.append(contentsOf: tagged!)
-			}
+	/// Returns `true` if messages of the provided level are currently logged. Cheap enough to guard the construction of expensive log messages.
+	static public func isEnabled(for level: OCLogLevel) -> Bool {
+		let logLevel = OCLogger.logLevel
 
-			OCLogger.shared.appendLogLevel(OCLogLevel.debug, functionName: functionName, file: file, line: line, tags: tags, message: message, arguments: va_list)
-		}
+		return (logLevel != .off) && (level.rawValue >= logLevel.rawValue)
 	}
 
-	static public func log(tagged : [String]? = nil, _ message: String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
-		withVaList(parameters) { va_list in
- 			var tags : [String] = ["APP"]
-
-			if tagged != nil {
-				tags.append(contentsOf: tagged!)
-			}
+	// Messages are passed as autoclosures, so that string interpolation and formatting only take place if the level is actually logged
+	static public func debug(tagged : [String]? = nil, _ message: @autoclosure () -> String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
+		append(level: .debug, tagged: tagged, message: message, parameters: parameters, file: file, functionName: functionName, line: line)
+	}
 
-			OCLogger.shared.appendLogLevel(OCLogLevel.info, functionName: functionName, file: file, line: line, tags: tags, message: message, arguments: va_list)
-		}
+	static public func log(tagged : [String]? = nil, _ message: @autoclosure () -> String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
+		append(level: .info, tagged: tagged, message: message, parameters: parameters, file: file, functionName: functionName, line: line)
 	}
 
-	static public func warning(tagged : [String]? = nil, _ message: String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
-		withVaList(parameters) { va_list in
- 			var tags : [String] = ["APP"]
+	static public func warning(tagged : [String]? = nil, _ message: @autoclosure () -> String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
+		append(level: .warning, tagged: tagged, message: message, parameters: parameters, file: file, functionName: functionName, line: line)
+	}
 
-			if tagged != nil {
-				tags.append(contentsOf: tagged!)
-			}
+	static public func error(tagged : [String]? = nil, _ message: @autoclosure () -> String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
+		append(level: .error, tagged: tagged, message: message, parameters: parameters, file: file, functionName: functionName, line: line)
+	}
 
-			OCLogger.shared.appendLogLevel(OCLogLevel.warning, functionName: functionName, file: file, line: line, tags: tags, message: message, arguments: va_list)
+	static private func append(level: OCLogLevel, tagged : [String]?, message: () -> String, parameters: [CVarArg], file: String, functionName: String, line: UInt) {
+		guard isEnabled(for: level) else {
+			return
 		}
-	}
 
-	static public func error(tagged : [String]? = nil, _ message: String, _ parameters: CVarArg..., file: String = #file, functionName: String = #function, line: UInt = #line ) {
 		withVaList(parameters) { va_list in
  			var tags : [String] = ["APP"]
 
@@ -90,7 +82,7 @@ public class Log {
 				tags.append(contentsOf: tagged!)
 			}
 
-			OCLogger.shared.appendLogLevel(OCLogLevel.error, functionName: functionName, file: file, line: line, tags: tags, message: message, arguments: va_list)
+			OCLogger.shared.appendLogLevel(level, functionName: functionName, file: file, line: line, tags: tags, message: message(), arguments: va_list)
 		}
 	}
 
@@ -23,14 +23,16 @@ public struct Watermark {
 	var texts: [String]
 	var textColor: UIColor {
 		get {
-			if let textColor = ConfidentialManager.shared.textColor, let color = String(textColor).colorFromHex?.withAlphaComponent(ConfidentialManager.shared.textOpacity) {
+			let settings = ConfidentialManager.shared.settingsSnapshot
+
+			if let textColor = settings.textColor, let color = String(textColor).colorFromHex?.withAlphaComponent(settings.textOpacity) {
 				return color
 			} else {
 				if let color = Theme.shared.activeCollection.css.getColor(.stroke, selectors: [.confidentialLabel], for: nil) {
-					return color.withAlphaComponent(ConfidentialManager.shared.textOpacity)
+					return color.withAlphaComponent(settings.textOpacity)
 				}
 			}
-			return .red.withAlphaComponent(ConfidentialManager.shared.textOpacity)
+			return .red.withAlphaComponent(settings.textOpacity)
 		}
 		set {
 		}
@@ -41,12 +43,13 @@ public struct Watermark {
 	var lineSpacing: CGFloat
 	var marginY: CGFloat
 
-	init(texts: [String], angle: CGFloat = 45) {
+	public init(texts: [String], angle: CGFloat = 45) {
 		self.texts = texts
 		self.font = UIFont.systemFont(ofSize: 14)
 		self.angle = angle
-		self.columnSpacing = ConfidentialManager.shared.columnSpacing
-		self.lineSpacing = ConfidentialManager.shared.lineSpacing
+		let settings = ConfidentialManager.shared.settingsSnapshot
+		self.columnSpacing = settings.columnSpacing
+		self.lineSpacing = settings.lineSpacing
 		self.marginY = 10
 	}
 }
@@ -129,8 +132,8 @@ public class ConfidentialContentView: UIView, Themeable {
 	}
 
 	public override func draw(_ rect: CGRect) {
-		guard ConfidentialManager.shared.markConfidentialViews, let context = UIGraphicsGetCurrentContext() else { return }
-		context.draw(watermark: watermark, in: rect)
+		guard ConfidentialManager.shared.settingsSnapshot.markConfidentialViews, let context = UIGraphicsGetCurrentContext() else { return }
+		context.draw(watermark: watermark, in: bounds) // Lay out relative to the bounds, so partial redraws match the rest of the view
 	}
 
 	public func applyThemeCollection(theme: Theme, collection: ThemeCollection, event: ThemeEvent) {
@@ -143,6 +146,11 @@ public class ConfidentialContentView: UIView, Themeable {
 
 public extension CGContext {
 	func draw(watermark: Watermark, in rect: CGRect) {
+		WatermarkRenderer.shared.draw(watermark, in: rect, context: self)
+	}
+
+	/// Lays out and draws each watermark string individually
+	func drawWatermarkStrings(_ watermark: Watermark, in rect: CGRect) {
 		UIGraphicsPushContext(self)
 
 		saveGState()
@@ -187,7 +195,9 @@ public extension CGContext {
 
 public extension UIView {
 	func secureView(core: OCCore?, useLayer: Bool = false) {
-		if !ConfidentialManager.shared.markConfidentialViews { return }
+		let settings = ConfidentialManager.shared.settingsSnapshot
+
+		if !settings.markConfidentialViews { return }
 		
 		func removeConfidentialContentLayerIfNeeded() {
 			layer.sublayers?.forEach { sublayer in
@@ -206,16 +216,16 @@ public extension UIView {
 		}
 
 		var texts: [String] = []
-		if ConfidentialManager.shared.showUserEmail, let email = core?.bookmark.user?.emailAddress {
+		if settings.showUserEmail, let email = core?.bookmark.user?.emailAddress {
 			texts.append(email)
 		}
-		if ConfidentialManager.shared.showUserID, let userID = core?.bookmark.user?.userName {
+		if settings.showUserID, let userID = core?.bookmark.user?.userName {
 			texts.append(userID)
 		}
-		if let text = ConfidentialManager.shared.customText, !text.isEmpty {
+		if let text = settings.customText, !text.isEmpty {
 			texts.append(text)
 		}
-		if ConfidentialManager.shared.showTimestamp {
+		if settings.showTimestamp {
 			texts.append(Date().formatted(.dateTime))
 		}
 		
@@ -0,0 +1,114 @@
+//
+//  WatermarkRenderer.swift
+//  ownCloudAppShared
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import UIKit
+
+public class WatermarkTile : NSObject {
+	public let image: CGImage
+	public let size: CGSize // in points
+
+	init(image: CGImage, size: CGSize) {
+		self.image = image
+		self.size = size
+	}
+}
+
+/// Draws watermarks by rasterizing the text once per text, font, color, spacing and scale into a tile, which is then repeated across the
+/// rotated coordinate system - rather than laying out and drawing every single string on every redraw.
+public class WatermarkRenderer {
+	public static let shared = WatermarkRenderer()
+
+	private let tileCache = NSCache<NSString, WatermarkTile>()
+
+	// MARK: - Statistics
+	public private(set) var renderedTileCount: Int = 0
+
+	public init() {
+		tileCache.countLimit = 16
+	}
+
+	// MARK: - Tiles
+	public func tile(for watermark: Watermark, textColor: UIColor, scale: CGFloat) -> WatermarkTile? {
+		let text = watermark.texts.joined(separator: ", ")
+
+		var red: CGFloat = 0, green: CGFloat = 0, blue: CGFloat = 0, alpha: CGFloat = 0
+		textColor.getRed(&red, green: &green, blue: &blue, alpha: &alpha)
+
+		let cacheKey = "\(text)|\(watermark.font.fontName)|\(watermark.font.pointSize)|\(red),\(green),\(blue),\(alpha)|\(watermark.columnSpacing)|\(watermark.lineSpacing)|\(scale)" as NSString
+
+		if let tile = tileCache.object(forKey: cacheKey) {
+			return tile
+		}
+
+		let textAttributes: [NSAttributedString.Key: Any] = [
+			.font: watermark.font,
+			.foregroundColor: textColor
+		]
+
+		let textSize = text.size(withAttributes: textAttributes)
+
+		// One period of the watermark grid: the text plus spacing to the next column and line
+		let tileSize = CGSize(width: ceil(textSize.width + watermark.columnSpacing), height: ceil(textSize.height + watermark.lineSpacing))
+
+		guard tileSize.width > 0, tileSize.height > 0 else { return nil }
+
+		let format = UIGraphicsImageRendererFormat()
+		format.scale = scale
+		format.opaque = false
+
+		let image = UIGraphicsImageRenderer(size: tileSize, format: format).image { _ in
+			text.draw(at: .zero, withAttributes: textAttributes)
+		}
+
+		guard let cgImage = image.cgImage else { return nil }
+
+		let tile = WatermarkTile(image: cgImage, size: tileSize)
+
+		tileCache.setObject(tile, forKey: cacheKey)
+		renderedTileCount += 1
+
+		return tile
+	}
+
+	public func removeAllTiles() {
+		tileCache.removeAllObjects()
+	}
+
+	// MARK: - Drawing
+	public func draw(_ watermark: Watermark, in rect: CGRect, context: CGContext) {
+		// Rasterize at the resolution of the target context
+		let deviceTransform = context.userSpaceToDeviceSpaceTransform
+		let scale = max(sqrt(deviceTransform.a * deviceTransform.a + deviceTransform.b * deviceTransform.b), 1)
+
+		guard let tile = tile(for: watermark, textColor: watermark.textColor, scale: scale) else { return }
+
+		let rotatedDiagonal = sqrt(rect.width * rect.width + rect.height * rect.height)
+
+		context.saveGState()
+
+		context.rotate(by: watermark.angle * .pi / 180)
+
+		// Same grid origin as the per-string layout. The y axis is flipped, as CGImages are drawn bottom-up in UIKit's flipped contexts.
+		let tileRect = CGRect(x: -rotatedDiagonal, y: -(-rotatedDiagonal + watermark.marginY) - tile.size.height, width: tile.size.width, height: tile.size.height)
+
+		context.scaleBy(x: 1, y: -1)
+		context.draw(tile.image, in: tileRect, byTiling: true)
+
+		context.restoreGState()
+	}
+}
@@ -0,0 +1,122 @@
+//
+//  AccountConnectionSchedulerTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class AccountConnectionSchedulerTests: XCTestCase {
+	let coreStartupTime: TimeInterval = 0.2
+
+	func makeBookmarks(count: Int) -> [OCBookmark] {
+		return (0..<count).map { idx in
+			OCBookmark(for: URL(string: "https://demo\(idx).owncloud.org/")!)
+		}
+	}
+
+	/// Schedules a stubbed core startup for every bookmark and returns the time until all of them are "connected".
+	func connectAll(_ bookmarks: [OCBookmark], scheduler: AccountConnectionScheduler) -> TimeInterval {
+		let allConnected = expectation(description: "All connected")
+		allConnected.expectedFulfillmentCount = bookmarks.count
+
+		let startDate = Date()
+
+		for bookmark in bookmarks {
+			scheduler.schedule(for: bookmark.uuidString, { (jobDone) in
+				DispatchQueue.global().asyncAfter(deadline: .now() + self.coreStartupTime) {
+					_ = OCCore(bookmark: bookmark)
+					allConnected.fulfill()
+					jobDone()
+				}
+			})
+		}
+
+		wait(for: [allConnected], timeout: 10)
+
+		return -startDate.timeIntervalSinceNow
+	}
+
+	func testParallelConnectionTiming() {
+		let bookmarks = makeBookmarks(count: 6)
+
+		let sequentialDuration = connectAll(bookmarks, scheduler: AccountConnectionScheduler(maximumConcurrentJobs: 1))
+		let parallelDuration = connectAll(bookmarks, scheduler: AccountConnectionScheduler(maximumConcurrentJobs: 3))
+
+		XCTAssertGreaterThanOrEqual(sequentialDuration, coreStartupTime * 6)
+		XCTAssertGreaterThanOrEqual(parallelDuration, coreStartupTime * 2)
+		XCTAssertLessThan(parallelDuration, coreStartupTime * 4)
+	}
+
+	func testParallelismLimit() {
+		let scheduler = AccountConnectionScheduler(maximumConcurrentJobs: 2)
+		let allDone = expectation(description: "All done")
+		let lock = NSLock()
+		var running = 0
+		var maximumRunning = 0
+
+		allDone.expectedFulfillmentCount = 8
+
+		for bookmark in makeBookmarks(count: 8) {
+			scheduler.schedule(for: bookmark.uuidString, { (jobDone) in
+				lock.lock()
+				running += 1
+				maximumRunning = max(maximumRunning, running)
+				lock.unlock()
+
+				DispatchQueue.global().asyncAfter(deadline: .now() + 0.05) {
+					lock.lock()
+					running -= 1
+					lock.unlock()
+
+					jobDone()
+					allDone.fulfill()
+				}
+			})
+		}
+
+		wait(for: [allDone], timeout: 10)
+
+		XCTAssertEqual(maximumRunning, 2)
+	}
+
+	func testSameBookmarkJobsRunInOrder() {
+		let scheduler = AccountConnectionScheduler(maximumConcurrentJobs: 4)
+		let bookmark = makeBookmarks(count: 1)[0]
+		let allDone = expectation(description: "All done")
+		var order: [Int] = []
+
+		allDone.expectedFulfillmentCount = 5
+
+		for idx in 0..<5 {
+			scheduler.schedule(for: bookmark.uuidString, { (jobDone) in
+				XCTAssertEqual(scheduler.runningJobCount, 1)
+
+				// Later jobs finish faster, so they'd overtake earlier ones if run concurrently
+				DispatchQueue.global().asyncAfter(deadline: .now() + 0.01 * Double(5 - idx)) {
+					order.append(idx)
+					jobDone()
+					allDone.fulfill()
+				}
+			})
+		}
+
+		wait(for: [allDone], timeout: 10)
+
+		XCTAssertEqual(order, [0, 1, 2, 3, 4])
+	}
+}
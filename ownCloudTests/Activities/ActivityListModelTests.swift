@@ -0,0 +1,187 @@
+//
+//  ActivityListModelTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class ActivityListModelTests: XCTestCase {
+	class StubActivity : Equatable {
+		var identifier: String
+		var progress: Double = 0
+
+		init(_ identifier: String) {
+			self.identifier = identifier
+		}
+
+		static func == (lhs: StubActivity, rhs: StubActivity) -> Bool {
+			return lhs.identifier == rhs.identifier
+		}
+	}
+
+	class StubActivityManager {
+		var activities: [StubActivity] = []
+		var nextID = 0
+
+		@discardableResult func publish() -> StubActivity {
+			let activity = StubActivity("activity-\(nextID)")
+			nextID += 1
+			activities.append(activity)
+			return activity
+		}
+
+		func unpublish(_ activity: StubActivity) {
+			activities.removeAll(where: { $0 === activity })
+		}
+	}
+
+	func makeModel(for manager: StubActivityManager) -> ActivityListModel<StubActivity> {
+		return ActivityListModel(identifier: { $0.identifier }, elements: { manager.activities })
+	}
+
+	func testDiff() {
+		let manager = StubActivityManager()
+		let model = makeModel(for: manager)
+
+		for _ in 0..<10 {
+			manager.publish()
+		}
+
+		model.reload()
+
+		XCTAssertEqual(model.row(for: "activity-4"), 4)
+
+		// Remove rows 2 and 5, add two new activities, update rows 0 and 7 (the latter being removed)
+		let removed1 = manager.activities[2], removed2 = manager.activities[5]
+		manager.unpublish(removed1)
+		manager.unpublish(removed2)
+		manager.publish()
+		manager.publish()
+
+		model.setNeedsElementsUpdate()
+		model.elementUpdated(identifier: "activity-0")
+		model.elementUpdated(identifier: "activity-5")
+
+		let changes = model.applyPendingChanges()
+
+		XCTAssertFalse(changes.requiresFullReload)
+		XCTAssertEqual(changes.deletedRows, [2, 5])
+		XCTAssertEqual(changes.insertedRows, [8, 9])
+		XCTAssertEqual(changes.reloadedRows, [0])
+		XCTAssertEqual(model.elements.count, 10)
+		XCTAssertEqual(model.row(for: "activity-6"), 4)
+		XCTAssertNil(model.row(for: "activity-5"))
+
+		// Property updates only
+		model.elementUpdated(identifier: "activity-11")
+		model.elementUpdated(identifier: "activity-11")
+		XCTAssertEqual(model.applyPendingChanges().reloadedRows, [9])
+
+		// Nothing pending
+		XCTAssertTrue(model.applyPendingChanges().isEmpty)
+
+		// Reordering requires a full reload
+		manager.activities.swapAt(0, 1)
+		model.setNeedsElementsUpdate()
+		XCTAssertTrue(model.applyPendingChanges().requiresFullReload)
+		XCTAssertEqual(model.row(for: "activity-1"), 0)
+	}
+
+	// MARK: - Benchmark
+	let activityCount = 5000
+	let notificationsPerSecond = 20000
+	let framesPerSecond = 60
+
+	/// Replays one second of a notification flood (mostly progress updates, some publish/unpublish)
+	func replayFlood(handleNotification: (_ manager: StubActivityManager, _ isStructural: Bool, _ activity: StubActivity) -> Void, handleFrame: () -> Void, manager: StubActivityManager) {
+		let notificationsPerFrame = notificationsPerSecond / framesPerSecond
+
+		for frame in 0..<framesPerSecond {
+			for idx in 0..<notificationsPerFrame {
+				let notification = frame * notificationsPerFrame + idx
+
+				if notification % 50 == 0 {
+					// Sync activity finished and a new one started
+					manager.unpublish(manager.activities[0])
+					let activity = manager.publish()
+					handleNotification(manager, true, activity)
+				} else {
+					let activity = manager.activities[(notification * 7919) % manager.activities.count]
+					activity.progress += 0.01
+					handleNotification(manager, false, activity)
+				}
+			}
+
+			handleFrame()
+		}
+	}
+
+	func makeFloodManager() -> StubActivityManager {
+		let manager = StubActivityManager()
+
+		for _ in 0..<activityCount {
+			manager.publish()
+		}
+
+		return manager
+	}
+
+	func testMainThreadTimePerNotification() {
+		// Previous behaviour: reload all activities for every publish/unpublish, linear row lookup for every property update
+		measure {
+			let manager = makeFloodManager()
+			var activities = manager.activities
+			var reloadedRowCount = 0
+
+			replayFlood(handleNotification: { (manager, isStructural, activity) in
+				if isStructural {
+					activities = manager.activities
+					reloadedRowCount += activities.count
+				} else if activities.firstIndex(of: activity) != nil {
+					reloadedRowCount += 1
+				}
+			}, handleFrame: {}, manager: manager)
+
+			XCTAssertGreaterThan(reloadedRowCount, 0)
+		}
+	}
+
+	func testMainThreadTimePerFrame() {
+		measure {
+			let manager = makeFloodManager()
+			let model = makeModel(for: manager)
+			var changedRowCount = 0
+
+			model.reload()
+
+			replayFlood(handleNotification: { (manager, isStructural, activity) in
+				if isStructural {
+					model.setNeedsElementsUpdate()
+				} else {
+					model.elementUpdated(identifier: activity.identifier)
+				}
+			}, handleFrame: {
+				let changes = model.applyPendingChanges()
+				changedRowCount += changes.deletedRows.count + changes.insertedRows.count + changes.reloadedRows.count
+			}, manager: manager)
+
+			XCTAssertGreaterThan(changedRowCount, 0)
+			XCTAssertEqual(model.elements.count, activityCount)
+		}
+	}
+}
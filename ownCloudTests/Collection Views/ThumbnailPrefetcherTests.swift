@@ -0,0 +1,106 @@
+//
+//  ThumbnailPrefetcherTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class MockThumbnailResourceManager: ThumbnailPrefetchResourceManager {
+	var started: [OCResourceRequest] = []
+	var stopped: [OCResourceRequest] = []
+
+	func start(_ request: OCResourceRequest) {
+		started.append(request)
+	}
+
+	func stop(_ request: OCResourceRequest) {
+		stopped.append(request)
+	}
+
+	func completeAll() {
+		for request in started where !stopped.contains(where: { $0 === request }) {
+			request.delegate?.resourceRequest(request, didChangeWithError: nil, isOngoing: false, previousResource: nil, newResource: nil)
+		}
+	}
+}
+
+class ThumbnailPrefetcherTests: XCTestCase {
+	func makeItems(count: Int) -> [OCItem] {
+		return (0..<count).map { idx in
+			let item = OCItem()
+			item.type = .file
+			item.localID = "local-\(idx)"
+			item.eTag = "etag-\(idx)"
+			item.path = "/photo-\(idx).jpg"
+			return item
+		}
+	}
+
+	func runMainQueue() {
+		RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+	}
+
+	func testDeduplicationAndDirectionChange() {
+		let resourceManager = MockThumbnailResourceManager()
+		let prefetcher = ThumbnailPrefetcher(resourceManager: resourceManager)
+		let items = makeItems(count: 100)
+
+		prefetcher.prefetch(items: (20..<30).map { (item: items[$0], indexPath: IndexPath(item: $0, section: 0)) })
+		prefetcher.prefetch(items: (25..<35).map { (item: items[$0], indexPath: IndexPath(item: $0, section: 0)) })
+		runMainQueue()
+
+		XCTAssertEqual(resourceManager.started.count, 15)
+		XCTAssertEqual(prefetcher.statistics.deduplicatedRequests, 5)
+
+		// Scroll forward, then reverse direction: outstanding requests should be cancelled
+		prefetcher.prefetch(items: (40..<50).map { (item: items[$0], indexPath: IndexPath(item: $0, section: 0)) })
+		prefetcher.prefetch(items: (0..<10).map { (item: items[$0], indexPath: IndexPath(item: $0, section: 0)) })
+		runMainQueue()
+
+		XCTAssertEqual(prefetcher.statistics.cancelledRequests, 25)
+		XCTAssertEqual(resourceManager.stopped.count, 15)
+	}
+
+	func testHitRateWhileScrolling() {
+		let resourceManager = MockThumbnailResourceManager()
+		let prefetcher = ThumbnailPrefetcher(resourceManager: resourceManager)
+		let items = makeItems(count: 5000)
+		let visibleCount = 12
+		let prefetchDistance = 24
+
+		measure {
+			for firstVisible in stride(from: 0, to: items.count - visibleCount - prefetchDistance, by: visibleCount) {
+				// UICollectionView asks for items beyond the visible range
+				let prefetchRange = (firstVisible + visibleCount)..<(firstVisible + visibleCount + prefetchDistance)
+				prefetcher.prefetch(items: prefetchRange.map { (item: items[$0], indexPath: IndexPath(item: $0, section: 0)) })
+				runMainQueue()
+				resourceManager.completeAll()
+
+				// Cells become visible and ask for their thumbnails
+				for idx in (firstVisible + visibleCount)..<(firstVisible + 2 * visibleCount) {
+					if prefetcher.claimRequest(for: items[idx], maximumSize: prefetcher.thumbnailSize) == nil {
+						_ = OCResourceRequestItemThumbnail.request(for: items[idx], maximumSize: prefetcher.thumbnailSize, scale: 0, waitForConnectivity: true, changeHandler: nil)
+					}
+				}
+			}
+		}
+
+		XCTAssertGreaterThan(prefetcher.statistics.hitRate, 0.9)
+		XCTAssertGreaterThan(prefetcher.statistics.startedRequests, 0)
+	}
+}
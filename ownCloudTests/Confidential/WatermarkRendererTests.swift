@@ -0,0 +1,115 @@
+//
+//  WatermarkRendererTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class WatermarkRendererTests: XCTestCase {
+	let watermark = Watermark(texts: [ "jane.doe@example.com", "jdoe", "Confidential" ], angle: -45)
+	let viewSize = CGSize(width: 1024, height: 1366)
+
+	func render(size: CGSize, scale: CGFloat = 2, drawing: (CGContext, CGRect) -> Void) -> UIImage {
+		let format = UIGraphicsImageRendererFormat()
+		format.scale = scale
+
+		return UIGraphicsImageRenderer(size: size, format: format).image { rendererContext in
+			drawing(rendererContext.cgContext, CGRect(origin: .zero, size: size))
+		}
+	}
+
+	/// Sum of the alpha values of all pixels, as a measure of the amount of text drawn
+	func alphaCoverage(of image: UIImage) -> Double {
+		guard let cgImage = image.cgImage,
+		      let context = CGContext(data: nil, width: cgImage.width, height: cgImage.height, bitsPerComponent: 8, bytesPerRow: cgImage.width, space: CGColorSpaceCreateDeviceGray(), bitmapInfo: CGImageAlphaInfo.alphaOnly.rawValue) else {
+			return 0
+		}
+
+		context.draw(cgImage, in: CGRect(x: 0, y: 0, width: cgImage.width, height: cgImage.height))
+
+		guard let data = context.data else { return 0 }
+
+		let pixels = data.bindMemory(to: UInt8.self, capacity: cgImage.width * cgImage.height)
+		var coverage: Double = 0
+
+		for idx in 0 ..< (cgImage.width * cgImage.height) {
+			coverage += Double(pixels[idx])
+		}
+
+		return coverage / 255
+	}
+
+	// MARK: - Tests
+	func testTilesAreCachedPerScale() {
+		let renderer = WatermarkRenderer()
+
+		let tile = renderer.tile(for: watermark, textColor: .red, scale: 2)
+		XCTAssertNotNil(tile)
+		XCTAssertIdentical(renderer.tile(for: watermark, textColor: .red, scale: 2), tile)
+		XCTAssertEqual(renderer.renderedTileCount, 1)
+
+		XCTAssertNotNil(renderer.tile(for: watermark, textColor: .red, scale: 3))
+		XCTAssertNotNil(renderer.tile(for: watermark, textColor: .blue, scale: 2))
+		XCTAssertEqual(renderer.renderedTileCount, 3)
+
+		XCTAssertEqual(tile?.image.width, Int((tile?.size.width ?? 0) * 2))
+	}
+
+	func testTiledWatermarkMatchesPerStringWatermark() {
+		let size = CGSize(width: 400, height: 600)
+
+		let perStringImage = render(size: size) { context, rect in
+			context.drawWatermarkStrings(watermark, in: rect)
+		}
+
+		let tiledImage = render(size: size) { context, rect in
+			WatermarkRenderer().draw(watermark, in: rect, context: context)
+		}
+
+		let perStringCoverage = alphaCoverage(of: perStringImage)
+		let tiledCoverage = alphaCoverage(of: tiledImage)
+
+		XCTAssertGreaterThan(perStringCoverage, 0)
+		XCTAssertEqual(tiledCoverage, perStringCoverage, accuracy: perStringCoverage * 0.05)
+	}
+
+	// MARK: - Benchmark
+	func testDrawPerformancePerString() {
+		measure {
+			for _ in 0 ..< 10 {
+				_ = render(size: viewSize) { context, rect in
+					context.drawWatermarkStrings(watermark, in: rect)
+				}
+			}
+		}
+	}
+
+	func testDrawPerformanceTiled() {
+		let renderer = WatermarkRenderer()
+
+		measure {
+			for _ in 0 ..< 10 {
+				_ = render(size: viewSize) { context, rect in
+					renderer.draw(watermark, in: rect, context: context)
+				}
+			}
+		}
+
+		XCTAssertEqual(renderer.renderedTileCount, 1)
+	}
+}
@@ -0,0 +1,153 @@
+//
+//  ImportStagerTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class ImportStagerTests: XCTestCase {
+	var testDirectoryURL: URL!
+	var stager: ImportStager!
+
+	override func setUp() {
+		testDirectoryURL = FileManager.default.temporaryDirectory.appendingPathComponent("ImportStagerTests-\(UUID().uuidString)", isDirectory: true)
+		try? FileManager.default.createDirectory(at: testDirectoryURL, withIntermediateDirectories: true)
+
+		stager = ImportStager(rootURL: testDirectoryURL.appendingPathComponent("File-Import"))
+	}
+
+	override func tearDown() {
+		try? FileManager.default.removeItem(at: testDirectoryURL)
+	}
+
+	func makeFile(named name: String, size: Int) -> URL {
+		let fileURL = testDirectoryURL.appendingPathComponent(name)
+		let chunk = Data((0 ..< (1024 * 1024)).map { UInt8(truncatingIfNeeded: $0 * 7) })
+
+		FileManager.default.createFile(atPath: fileURL.path, contents: nil)
+
+		if let fileHandle = try? FileHandle(forWritingTo: fileURL) {
+			var written = 0
+
+			while written < size {
+				let data = chunk.prefix(size - written)
+				try? fileHandle.write(contentsOf: data)
+				written += data.count
+			}
+
+			try? fileHandle.close()
+		}
+
+		return fileURL
+	}
+
+	var availableCapacity: Int64 {
+		return Int64((try? testDirectoryURL.resourceValues(forKeys: [.volumeAvailableCapacityKey]).volumeAvailableCapacity) ?? 0)
+	}
+
+	// MARK: - Tests
+	func testStagingAndCleanup() throws {
+		let sourceURL = makeFile(named: "video.mov", size: 3 * 1024 * 1024 + 123)
+		let progress = Progress(totalUnitCount: 0)
+
+		let stagedFile = try stager.stage(sourceURL, progress: progress)
+
+		XCTAssertEqual(stagedFile.url.lastPathComponent, "video.mov")
+		XCTAssertEqual(try Data(contentsOf: stagedFile.url), try Data(contentsOf: sourceURL))
+		XCTAssertEqual(progress.completedUnitCount, progress.totalUnitCount)
+
+		// The staged file is independent of the source
+		try FileManager.default.removeItem(at: sourceURL)
+		XCTAssertTrue(FileManager.default.fileExists(atPath: stagedFile.url.path))
+
+		stager.remove(stagedFile)
+		XCTAssertFalse(FileManager.default.fileExists(atPath: stagedFile.containerURL.path))
+	}
+
+	func testChunkedCopyWithProgressAndCancellation() throws {
+		let sourceURL = makeFile(named: "archive.zip", size: 10 * 1024 * 1024)
+		let progress = Progress(totalUnitCount: 0)
+		var observedFractions: [Double] = []
+
+		// Force a chunked copy, as on filesystems without clone support
+		stager.allowsClones = false
+		stager.chunkSize = 1024 * 1024
+
+		let observation = progress.observe(\.completedUnitCount) { (progress, _) in
+			observedFractions.append(progress.fractionCompleted)
+		}
+
+		let stagedFile = try stager.stage(sourceURL, allowHardLink: false, progress: progress)
+		observation.invalidate()
+
+		XCTAssertEqual(stagedFile.method, .copy)
+		XCTAssertEqual(try Data(contentsOf: stagedFile.url), try Data(contentsOf: sourceURL))
+		XCTAssertEqual(observedFractions.count, 10)
+		XCTAssertEqual(observedFractions.last, 1.0)
+
+		// Cancelled staging leaves nothing behind
+		let cancelledProgress = Progress(totalUnitCount: 0)
+		cancelledProgress.cancel()
+
+		XCTAssertThrowsError(try stager.stage(sourceURL, progress: cancelledProgress))
+		XCTAssertEqual(try FileManager.default.contentsOfDirectory(atPath: stager.rootURL.path).count, 1)
+	}
+
+	func testRemoveStaleStagedFiles() throws {
+		let sourceURL = makeFile(named: "document.pdf", size: 1024)
+
+		_ = try stager.stage(sourceURL)
+		_ = try stager.stage(sourceURL)
+
+		XCTAssertEqual(try FileManager.default.contentsOfDirectory(atPath: stager.rootURL.path).count, 2)
+
+		stager.removeStagedFiles(createdBefore: Date(timeIntervalSinceNow: 60))
+
+		XCTAssertEqual(try FileManager.default.contentsOfDirectory(atPath: stager.rootURL.path).count, 0)
+	}
+
+	// MARK: - Large files
+	let largeFileSize = 1024 * 1024 * 1024 // 1 GB
+
+	func testStagingDiskUsage() throws {
+		let sourceURL = makeFile(named: "large-video.mov", size: largeFileSize)
+
+		// Staging
+		let startCapacity = availableCapacity
+		let stagedFile = try stager.stage(sourceURL)
+
+		XCTAssertEqual(try stagedFile.url.resourceValues(forKeys: [.fileSizeKey]).fileSize, largeFileSize)
+
+		if stagedFile.method == .clone {
+			// Clones share the data blocks of the source, while FileManager.copyItem used to duplicate them
+			XCTAssertLessThan(startCapacity - availableCapacity, Int64(largeFileSize / 10))
+		}
+
+		stager.remove(stagedFile)
+
+		// Chunked copy fallback
+		stager.allowsClones = false
+
+		let copiedFile = try stager.stage(sourceURL)
+
+		XCTAssertEqual(copiedFile.method, .copy)
+		XCTAssertEqual(try copiedFile.url.resourceValues(forKeys: [.fileSizeKey]).fileSize, largeFileSize)
+
+		stager.remove(copiedFile)
+	}
+}
@@ -0,0 +1,203 @@
+//
+//  IntentCoreLeaseTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+/// Stands in for OCCoreManager, simulating the time a core needs to start up.
+class StubIntentCoreProvider: IntentCoreProvider {
+	var startupDelay: TimeInterval
+	var requestCount: Int = 0
+	var returnCount: Int = 0
+
+	init(startupDelay: TimeInterval) {
+		self.startupDelay = startupDelay
+	}
+
+	func requestCore(for bookmark: OCBookmark, setup setupHandler: ((OCCore?, Error?) -> Void)?, completionHandler: @escaping (OCCore?, Error?) -> Void) {
+		requestCount += 1
+
+		DispatchQueue.global().asyncAfter(deadline: .now() + startupDelay) {
+			let core = OCCore(bookmark: bookmark)
+			setupHandler?(core, nil)
+			completionHandler(core, nil)
+		}
+	}
+
+	func returnCore(for bookmark: OCBookmark, completionHandler: (() -> Void)?) {
+		returnCount += 1
+		completionHandler?()
+	}
+}
+
+class RecordingCoreDelegate: NSObject, OCCoreDelegate {
+	var errorCount: Int = 0
+
+	func core(_ core: OCCore, handleError error: Error?, issue: OCIssue?) {
+		errorCount += 1
+	}
+}
+
+class IntentCoreLeaseTests: XCTestCase {
+	let bookmark = OCBookmark(for: URL(string: "https://demo.owncloud.org/")!)
+
+	/// Runs `count` simulated intents back to back and returns the total time taken.
+	func runSequentialIntents(count: Int, lease: IntentCoreLease) -> TimeInterval {
+		let startDate = Date()
+
+		for _ in 0..<count {
+			let intentDone = expectation(description: "Intent done")
+
+			lease.acquire(for: bookmark, completionHandler: { (core, error) in
+				XCTAssertNotNil(core)
+				lease.release(for: self.bookmark, completionHandler: {
+					intentDone.fulfill()
+				})
+			})
+
+			wait(for: [intentDone], timeout: 10)
+		}
+
+		return -startDate.timeIntervalSinceNow
+	}
+
+	func testSequentialIntentLatency() {
+		let coldProvider = StubIntentCoreProvider(startupDelay: 0.1)
+		let coldLease = IntentCoreLease(provider: coldProvider, idleTimeout: 0)
+
+		let warmProvider = StubIntentCoreProvider(startupDelay: 0.1)
+		let warmLease = IntentCoreLease(provider: warmProvider, idleTimeout: 5)
+
+		let coldDuration = runSequentialIntents(count: 10, lease: coldLease)
+		let warmDuration = runSequentialIntents(count: 10, lease: warmLease)
+
+		XCTAssertEqual(coldProvider.requestCount, 10)
+		XCTAssertEqual(coldProvider.returnCount, 10)
+		XCTAssertEqual(warmProvider.requestCount, 1)
+		XCTAssertEqual(warmProvider.returnCount, 0)
+		XCTAssertLessThan(warmDuration, coldDuration / 2)
+	}
+
+	func testConcurrentRequestersShareCore() {
+		let provider = StubIntentCoreProvider(startupDelay: 0.1)
+		let lease = IntentCoreLease(provider: provider, idleTimeout: 0)
+		let allDone = expectation(description: "All done")
+		var cores: [OCCore] = []
+
+		allDone.expectedFulfillmentCount = 5
+
+		for _ in 0..<5 {
+			lease.acquire(for: bookmark, completionHandler: { (core, error) in
+				if let core {
+					cores.append(core)
+				}
+				allDone.fulfill()
+			})
+		}
+
+		wait(for: [allDone], timeout: 10)
+
+		XCTAssertEqual(provider.requestCount, 1)
+		XCTAssertEqual(cores.count, 5)
+		XCTAssertTrue(cores.allSatisfy({ $0 === cores.first }))
+
+		// Core is only returned after the last release
+		let released = expectation(description: "Released")
+		released.expectedFulfillmentCount = 5
+
+		for _ in 0..<5 {
+			lease.release(for: bookmark, completionHandler: {
+				released.fulfill()
+			})
+		}
+
+		wait(for: [released], timeout: 10)
+
+		XCTAssertEqual(provider.returnCount, 1)
+	}
+
+	func testErrorsAreForwardedToCurrentUsers() {
+		let lease = IntentCoreLease(provider: StubIntentCoreProvider(startupDelay: 0), idleTimeout: 5)
+		let firstDelegate = RecordingCoreDelegate()
+		let secondDelegate = RecordingCoreDelegate()
+		var sharedCore: OCCore?
+
+		let acquired = expectation(description: "Acquired")
+		acquired.expectedFulfillmentCount = 2
+
+		for delegate in [firstDelegate, secondDelegate] {
+			lease.acquire(for: bookmark, delegate: delegate, completionHandler: { (core, error) in
+				sharedCore = core
+				acquired.fulfill()
+			})
+		}
+
+		wait(for: [acquired], timeout: 10)
+
+		guard let core = sharedCore else {
+			XCTFail("No core")
+			return
+		}
+
+		// The lease is the core's delegate, not the last intent handler
+		XCTAssertTrue(core.delegate === lease)
+
+		lease.core(core, handleError: NSError(ocError: .internal), issue: nil)
+
+		let released = expectation(description: "Released")
+		lease.release(for: bookmark, delegate: firstDelegate, completionHandler: {
+			released.fulfill()
+		})
+		wait(for: [released], timeout: 10)
+
+		lease.core(core, handleError: NSError(ocError: .internal), issue: nil)
+
+		let flushed = expectation(description: "Flushed")
+		lease.release(for: bookmark, delegate: secondDelegate, completionHandler: {
+			flushed.fulfill()
+		})
+		wait(for: [flushed], timeout: 10)
+
+		XCTAssertEqual(firstDelegate.errorCount, 1)
+		XCTAssertEqual(secondDelegate.errorCount, 2)
+	}
+
+	func testListingCacheValidation() {
+		let cache = IntentDirectoryListingCache(maximumAge: 60, maximumEntries: 2)
+		let listing = ["/Documents/a.txt", "/Documents/b.txt"]
+
+		cache.store(listing: listing, for: bookmark, path: "/Documents/", sortType: 1, sortDirection: 1, eTag: "etag-1")
+
+		XCTAssertEqual(cache.listing(for: bookmark, path: "/Documents/", sortType: 1, sortDirection: 1, eTag: "etag-1"), listing)
+		XCTAssertNil(cache.listing(for: bookmark, path: "/Documents/", sortType: 2, sortDirection: 1, eTag: "etag-1"))
+		XCTAssertNil(cache.listing(for: bookmark, path: "/Documents/", sortType: 1, sortDirection: 1, eTag: nil))
+
+		// Changed eTag invalidates the entry
+		XCTAssertNil(cache.listing(for: bookmark, path: "/Documents/", sortType: 1, sortDirection: 1, eTag: "etag-2"))
+		XCTAssertNil(cache.listing(for: bookmark, path: "/Documents/", sortType: 1, sortDirection: 1, eTag: "etag-1"))
+
+		// Oldest entry is evicted
+		cache.store(listing: listing, for: bookmark, path: "/A/", sortType: 1, sortDirection: 1, eTag: "a")
+		cache.store(listing: listing, for: bookmark, path: "/B/", sortType: 1, sortDirection: 1, eTag: "b")
+		cache.store(listing: listing, for: bookmark, path: "/C/", sortType: 1, sortDirection: 1, eTag: "c")
+
+		XCTAssertNil(cache.listing(for: bookmark, path: "/A/", sortType: 1, sortDirection: 1, eTag: "a"))
+		XCTAssertNotNil(cache.listing(for: bookmark, path: "/C/", sortType: 1, sortDirection: 1, eTag: "c"))
+	}
+}
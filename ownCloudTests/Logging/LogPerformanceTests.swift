@@ -0,0 +1,99 @@
+//
+//  LogPerformanceTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+class LogPerformanceTests: XCTestCase {
+	var previousLogLevel: OCLogLevel = .off
+
+	let callCount = 100_000
+	let fetchOptions: [String : Any] = [ "predicate" : "creationDate > 2026-10-19 12:00:00", "sortDescriptors" : [ "creationDate", "modificationDate" ], "includeHiddenAssets" : false ]
+
+	override func setUp() {
+		previousLogLevel = OCLogger.logLevel
+	}
+
+	override func tearDown() {
+		OCLogger.logLevel = previousLogLevel
+	}
+
+	class DescriptionCounter: CustomDebugStringConvertible {
+		var count = 0
+
+		var debugDescription: String {
+			count += 1
+			return "<DescriptionCounter>"
+		}
+	}
+
+	/// Previous behaviour: the message is built before the call, regardless of the log level
+	func eagerDebug(_ message: String, _ parameters: CVarArg...) {
+		withVaList(parameters) { va_list in
+			OCLogger.shared.appendLogLevel(.debug, functionName: #function, file: #file, line: #line, tags: ["APP"], message: message, arguments: va_list)
+		}
+	}
+
+	// MARK: - Tests
+	func testLevelCheck() {
+		OCLogger.logLevel = .warning
+
+		XCTAssertFalse(Log.isEnabled(for: .debug))
+		XCTAssertFalse(Log.isEnabled(for: .info))
+		XCTAssertTrue(Log.isEnabled(for: .warning))
+		XCTAssertTrue(Log.isEnabled(for: .error))
+
+		OCLogger.logLevel = .off
+
+		XCTAssertFalse(Log.isEnabled(for: .error))
+	}
+
+	func testMessageIsOnlyBuiltWhenLogged() {
+		let counter = DescriptionCounter()
+
+		OCLogger.logLevel = .info
+
+		Log.debug("Counter: \(counter.debugDescription)")
+		XCTAssertEqual(counter.count, 0)
+
+		Log.log("Counter: \(counter.debugDescription)")
+		XCTAssertEqual(counter.count, 1)
+	}
+
+	// MARK: - Benchmarks
+	func testDisabledLogPerformanceEager() {
+		OCLogger.logLevel = .off
+
+		measure {
+			for idx in 0 ..< callCount {
+				eagerDebug("Fetching assets \(idx) with options \(fetchOptions.debugDescription)")
+			}
+		}
+	}
+
+	func testDisabledLogPerformanceDeferred() {
+		OCLogger.logLevel = .off
+
+		measure {
+			for idx in 0 ..< callCount {
+				Log.debug("Fetching assets \(idx) with options \(fetchOptions.debugDescription)")
+			}
+		}
+	}
+}
@@ -0,0 +1,121 @@
+//
+//  MarkdownRendererTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import UIKit
+import ownCloudSDK
+import ownCloudAppShared
+
+class MarkdownRendererTests: XCTestCase {
+	func largeMarkdownDocument(sections: Int) -> String {
+		var markdown = ""
+
+		for section in 0..<sections {
+			markdown += "## Section \(section)\n\nLorem ipsum *dolor* sit amet, **consectetur** adipiscing elit, sed do eiusmod tempor [incididunt](https://owncloud.com/) ut labore et dolore magna aliqua.\n\n"
+			markdown += "- Item one\n- Item two\n  continued\n\n- Item three\n\n"
+			markdown += "```\nlet section = \(section)\n\nprint(section)\n```\n\n"
+		}
+
+		return markdown
+	}
+
+	func testBlockSegmentation() {
+		let blocks = MarkdownRenderer.blockSources(of: "# Title\n\nParagraph\n\n- A\n\n- B\n\n```\ncode\n\nmore code\n```\nAfter")
+
+		XCTAssertEqual(blocks, [
+			"# Title\n",
+			"Paragraph\n",
+			"- A\n\n- B\n",
+			"```\ncode\n\nmore code\n```\nAfter\n"
+		])
+	}
+
+	func testRenderedOutput() {
+		let update = MarkdownRenderer().renderSynchronously("# Title\n\nSome *emphasized* and **strong** text with a [link](https://owncloud.com/).")
+		let output = update.output
+		let string = output.string as NSString
+
+		XCTAssertEqual(output.string, "Title\nSome emphasized and strong text with a link.\n")
+		XCTAssertEqual(update.renderedBlockCount, 2)
+		XCTAssertEqual(update.replacedRange, NSRange(location: 0, length: 0))
+		XCTAssertEqual(update.replacement.string, output.string)
+
+		func font(of substring: String) -> UIFont? {
+			return output.attribute(.font, at: string.range(of: substring).location, effectiveRange: nil) as? UIFont
+		}
+
+		// Heading is rendered larger than body text
+		XCTAssertGreaterThan(font(of: "Title")?.pointSize ?? 0, font(of: "Some")?.pointSize ?? 0)
+
+		// Inline styles
+		XCTAssertTrue(font(of: "emphasized")?.fontDescriptor.symbolicTraits.contains(.traitItalic) == true)
+		XCTAssertFalse(font(of: "emphasized")?.fontDescriptor.symbolicTraits.contains(.traitBold) == true)
+		XCTAssertTrue(font(of: "strong")?.fontDescriptor.symbolicTraits.contains(.traitBold) == true)
+		XCTAssertFalse(font(of: "Some")?.fontDescriptor.symbolicTraits.contains(.traitBold) == true)
+
+		// Link
+		let link = output.attribute(.link, at: string.range(of: "link").location, effectiveRange: nil)
+		XCTAssertEqual((link as? URL)?.absoluteString ?? (link as? String), "https://owncloud.com/")
+		XCTAssertNil(output.attribute(.link, at: string.range(of: "text").location, effectiveRange: nil))
+	}
+
+	func testIncrementalUpdateRange() {
+		let renderer = MarkdownRenderer()
+
+		_ = renderer.renderSynchronously("# Title\n\nFirst paragraph\n\nLast paragraph")
+		let update = renderer.renderSynchronously("# Title\n\nFirst *edited* paragraph\n\nLast paragraph")
+
+		XCTAssertEqual(update.renderedBlockCount, 1)
+		XCTAssertEqual(update.replacedRange, NSRange(location: ("Title\n" as NSString).length, length: ("First paragraph\n" as NSString).length))
+		XCTAssertEqual(update.replacement.string, "First edited paragraph\n")
+		XCTAssertEqual(update.output.string, "Title\nFirst edited paragraph\nLast paragraph\n")
+
+		let editedFont = update.output.attribute(.font, at: (update.output.string as NSString).range(of: "edited").location, effectiveRange: nil) as? UIFont
+		XCTAssertTrue(editedFont?.fontDescriptor.symbolicTraits.contains(.traitItalic) == true)
+	}
+
+	func testIncrementalRenderingMatchesFullRendering() {
+		let original = largeMarkdownDocument(sections: 20)
+		let edited = original.replacingOccurrences(of: "## Section 10\n", with: "## Section 10x\n")
+
+		let incrementalRenderer = MarkdownRenderer()
+		_ = incrementalRenderer.renderSynchronously(original)
+		let update = incrementalRenderer.renderSynchronously(edited)
+
+		let fullOutput = MarkdownRenderer().renderSynchronously(edited).output
+
+		XCTAssertEqual(update.renderedBlockCount, 1)
+		XCTAssertEqual(update.output.string, fullOutput.string)
+		XCTAssertTrue(update.output.string.contains("Section 10x\n"))
+	}
+
+	func testSingleCharacterEditLatency() {
+		// ~500 KB document
+		let original = largeMarkdownDocument(sections: 1500)
+		let renderer = MarkdownRenderer()
+		var edited = original
+
+		_ = renderer.renderSynchronously(original)
+
+		measure {
+			edited = edited.replacingOccurrences(of: "## Section 750", with: "## Section 750x")
+			let update = renderer.renderSynchronously(edited)
+			XCTAssertEqual(update.renderedBlockCount, 1)
+		}
+	}
+}
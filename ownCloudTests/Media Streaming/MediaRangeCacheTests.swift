@@ -0,0 +1,265 @@
+//
+//  MediaRangeCacheTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+/// Serves range requests for `content` from memory and counts the bytes served
+class RangeServingURLProtocol : URLProtocol {
+	static var content = Data()
+	static var servedByteCount: Int64 = 0
+	static var requestCount: Int = 0
+	static var ignoresRange: Bool = false // Respond with the entire file, like a server without range request support
+
+	override class func canInit(with request: URLRequest) -> Bool {
+		return true
+	}
+
+	override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+		return request
+	}
+
+	override func startLoading() {
+		let content = RangeServingURLProtocol.content
+		var range = 0 ..< content.count
+
+		if let rangeHeader = request.value(forHTTPHeaderField: "Range"), !RangeServingURLProtocol.ignoresRange {
+			let bounds = rangeHeader.replacingOccurrences(of: "bytes=", with: "").split(separator: "-")
+			if bounds.count == 2, let start = Int(bounds[0]), let end = Int(bounds[1]) {
+				range = start ..< min(end + 1, content.count)
+			}
+		}
+
+		let data = content.subdata(in: range)
+
+		RangeServingURLProtocol.servedByteCount += Int64(data.count)
+		RangeServingURLProtocol.requestCount += 1
+
+		let response = RangeServingURLProtocol.ignoresRange ?
+			HTTPURLResponse(url: request.url!, statusCode: 200, httpVersion: "HTTP/1.1", headerFields: [
+				"Content-Type" : "video/mp4",
+				"Content-Length" : "\(content.count)"
+			])! :
+			HTTPURLResponse(url: request.url!, statusCode: 206, httpVersion: "HTTP/1.1", headerFields: [
+				"Content-Type" : "video/mp4",
+				"Content-Range" : "bytes \(range.lowerBound)-\(range.upperBound - 1)/\(content.count)"
+			])!
+
+		client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+		client?.urlProtocol(self, didLoad: data)
+		client?.urlProtocolDidFinishLoading(self)
+	}
+
+	override func stopLoading() {
+	}
+}
+
+class MediaRangeCacheTests: XCTestCase {
+	var cacheURL: URL!
+
+	override func setUp() {
+		cacheURL = FileManager.default.temporaryDirectory.appendingPathComponent("MediaRangeCacheTests-\(UUID().uuidString)", isDirectory: true)
+
+		var content = Data(count: 4 * 1024 * 1024)
+		for idx in 0 ..< content.count {
+			content[idx] = UInt8(truncatingIfNeeded: idx * 31)
+		}
+
+		RangeServingURLProtocol.content = content
+		RangeServingURLProtocol.servedByteCount = 0
+		RangeServingURLProtocol.requestCount = 0
+		RangeServingURLProtocol.ignoresRange = false
+	}
+
+	override func tearDown() {
+		try? FileManager.default.removeItem(at: cacheURL)
+	}
+
+	func makeLoader(cache: MediaRangeCache, key: String = "video") -> MediaRangeLoader {
+		let configuration = URLSessionConfiguration.ephemeral
+		configuration.protocolClasses = [ RangeServingURLProtocol.self ]
+
+		return MediaRangeLoader(remoteURL: URL(string: "https://demo.owncloud.org/remote.php/dav/files/demo/\(key).mp4")!, headers: nil, entry: cache.entry(for: key), sessionConfiguration: configuration)
+	}
+
+	func load(_ range: Range<Int64>, with loader: MediaRangeLoader) -> Data {
+		let expectation = self.expectation(description: "Range loaded")
+		var loadedData = Data()
+
+		loader.load(range: range, dataHandler: { (data) in
+			loadedData.append(data)
+		}, completionHandler: { (error) in
+			XCTAssertNil(error)
+			expectation.fulfill()
+		})
+
+		wait(for: [expectation], timeout: 10)
+
+		return loadedData
+	}
+
+	// MARK: - Tests
+	func testByteRangeSet() {
+		var set = ByteRangeSet([ 10 ..< 20, 40 ..< 50 ])
+
+		set.insert(20 ..< 25) // adjacent
+		XCTAssertEqual(set.ranges, [ 10 ..< 25, 40 ..< 50 ])
+
+		set.insert(0 ..< 5)
+		set.insert(22 ..< 45) // bridges two ranges
+		XCTAssertEqual(set.ranges, [ 0 ..< 5, 10 ..< 50 ])
+		XCTAssertEqual(set.byteCount, 45)
+
+		XCTAssertEqual(set.missingRanges(in: 0 ..< 60), [ 5 ..< 10, 50 ..< 60 ])
+		XCTAssertTrue(set.contains(12 ..< 48))
+		XCTAssertFalse(set.contains(3 ..< 12))
+	}
+
+	func testOverlappingRangesAreServedFromCache() {
+		let cache = MediaRangeCache(rootURL: cacheURL)
+		let loader = makeLoader(cache: cache)
+		let content = RangeServingURLProtocol.content
+
+		// Initial playback of the first MB
+		XCTAssertEqual(load(0 ..< 1_000_000, with: loader), content.subdata(in: 0 ..< 1_000_000))
+		XCTAssertEqual(RangeServingURLProtocol.servedByteCount, 1_000_000)
+
+		// Seek back: served entirely from disk
+		XCTAssertEqual(load(200_000 ..< 800_000, with: loader), content.subdata(in: 200_000 ..< 800_000))
+		XCTAssertEqual(RangeServingURLProtocol.servedByteCount, 1_000_000)
+
+		// Overlapping range: only the missing part is fetched
+		XCTAssertEqual(load(900_000 ..< 1_500_000, with: loader), content.subdata(in: 900_000 ..< 1_500_000))
+		XCTAssertEqual(RangeServingURLProtocol.servedByteCount, 1_500_000)
+
+		XCTAssertEqual(loader.fetchedByteCount, 1_500_000)
+		XCTAssertEqual(loader.cachedByteCount, 700_000)
+	}
+
+	func testReopeningUsesPersistedRanges() {
+		var cache: MediaRangeCache? = MediaRangeCache(rootURL: cacheURL)
+		var loader: MediaRangeLoader? = makeLoader(cache: cache!)
+
+		_ = load(0 ..< 500_000, with: loader!)
+
+		loader = nil
+		cache = nil
+
+		// New cache instance, as after a relaunch
+		let reopenedCache = MediaRangeCache(rootURL: cacheURL)
+		let reopenedLoader = makeLoader(cache: reopenedCache)
+
+		XCTAssertEqual(load(0 ..< 500_000, with: reopenedLoader), RangeServingURLProtocol.content.subdata(in: 0 ..< 500_000))
+		XCTAssertEqual(RangeServingURLProtocol.servedByteCount, 500_000)
+		XCTAssertEqual(reopenedLoader.entry.contentLength, Int64(RangeServingURLProtocol.content.count))
+		XCTAssertEqual(reopenedLoader.entry.mimeType, "video/mp4")
+	}
+
+	func testLeastRecentlyUsedEviction() {
+		let cache = MediaRangeCache(rootURL: cacheURL, maximumSize: 1_500_000)
+
+		var firstLoader: MediaRangeLoader? = makeLoader(cache: cache, key: "first")
+		_ = load(0 ..< 1_000_000, with: firstLoader!)
+		firstLoader = nil
+
+		var secondLoader: MediaRangeLoader? = makeLoader(cache: cache, key: "second")
+		_ = load(0 ..< 1_000_000, with: secondLoader!)
+
+		// The first file is no longer in use and least recently used
+		XCTAssertEqual(cache.entry(for: "first").cachedByteCount, 0)
+		XCTAssertEqual(cache.entry(for: "second").cachedByteCount, 1_000_000)
+
+		// Files in use are not evicted, even if exceeding the limit
+		_ = load(1_000_000 ..< 2_000_000, with: secondLoader!)
+		XCTAssertEqual(cache.entry(for: "second").cachedByteCount, 2_000_000)
+
+		secondLoader = nil
+		XCTAssertLessThanOrEqual(cache.totalSize, cache.maximumSize)
+	}
+
+	func testLeastRecentlyUsedEvictionAfterReopening() {
+		var cache: MediaRangeCache? = MediaRangeCache(rootURL: cacheURL)
+
+		var firstLoader: MediaRangeLoader? = makeLoader(cache: cache!, key: "first")
+		_ = load(0 ..< 500_000, with: firstLoader!)
+		firstLoader = nil
+
+		var secondLoader: MediaRangeLoader? = makeLoader(cache: cache!, key: "second")
+		_ = load(0 ..< 500_000, with: secondLoader!)
+		secondLoader = nil
+
+		// Play the first file again, served from the cache
+		firstLoader = makeLoader(cache: cache!, key: "first")
+		_ = load(0 ..< 500_000, with: firstLoader!)
+		firstLoader = nil
+
+		cache = nil
+
+		// After a relaunch, the second file is the least recently used one - even though the first one was written before it
+		let reopenedCache = MediaRangeCache(rootURL: cacheURL, maximumSize: 1_000_000)
+		let thirdLoader = makeLoader(cache: reopenedCache, key: "third")
+		_ = load(0 ..< 100_000, with: thirdLoader)
+
+		XCTAssertEqual(RangeServingURLProtocol.servedByteCount, 1_100_000)
+		XCTAssertEqual(reopenedCache.entry(for: "first").cachedByteCount, 500_000)
+		XCTAssertEqual(reopenedCache.entry(for: "second").cachedByteCount, 0)
+	}
+
+	func testCompletionAndPromotion() throws {
+		let cache = MediaRangeCache(rootURL: cacheURL)
+		let loader = makeLoader(cache: cache)
+		let content = RangeServingURLProtocol.content
+		let length = Int64(content.count)
+
+		// Load back half first, then front half
+		_ = load(length / 2 ..< length, with: loader)
+		XCTAssertFalse(loader.entry.isComplete)
+
+		_ = load(0 ..< length / 2, with: loader)
+		XCTAssertTrue(loader.entry.isComplete)
+
+		let promotedURL = cacheURL.appendingPathComponent("promoted.mp4")
+		try loader.entry.promote(to: promotedURL)
+
+		XCTAssertEqual(try Data(contentsOf: promotedURL), content)
+		XCTAssertEqual(cache.totalSize, 0)
+	}
+
+	func testIgnoredRangeIsNotBuffered() {
+		let cache = MediaRangeCache(rootURL: cacheURL)
+		let loader = makeLoader(cache: cache)
+		let expectation = self.expectation(description: "Load failed")
+
+		RangeServingURLProtocol.ignoresRange = true
+
+		loader.load(range: 1_000_000 ..< 1_500_000, dataHandler: { (data) in
+			XCTFail("No data expected")
+		}, completionHandler: { (error) in
+			XCTAssertEqual(error as? MediaRangeLoaderError, .rangeRequestsUnsupported)
+			expectation.fulfill()
+		})
+
+		wait(for: [expectation], timeout: 10)
+
+		// The request is cancelled as soon as the response arrives, so the caller can fall back to a download
+		XCTAssertTrue(loader.rangeRequestsUnsupported)
+		XCTAssertEqual(loader.fetchedByteCount, 0)
+		XCTAssertEqual(loader.entry.cachedByteCount, 0)
+	}
+}
@@ -0,0 +1,263 @@
+//
+//  PhotoLibraryChangeTrackerTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import Photos
+import ownCloudSDK
+import ownCloudAppShared
+
+/// Synthetic photo library with a change log addressed by sequence number
+class MockPhotoLibrary : PhotoLibraryChangeSource {
+	struct Change {
+		var inserted: Set<String> = []
+		var updated: Set<String> = []
+		var deleted: Set<String> = []
+	}
+
+	var assets: [String : PhotoLibraryAssetInfo] = [:]
+	var nonUserLibraryIdentifiers: Set<String> = [] // f.ex. assets in shared albums
+	var changes: [Change] = []
+	var oldestAvailableChange = 0
+
+	var fullScanCount = 0
+	var fetchedAssetCount = 0
+
+	init(assetCount: Int, startDate: Date) {
+		for idx in 0..<assetCount {
+			insert(mediaType: (idx % 10 == 0) ? .video : .image, creationDate: startDate.addingTimeInterval(TimeInterval(idx)), logChange: false)
+		}
+	}
+
+	@discardableResult func insert(mediaType: PHAssetMediaType, creationDate: Date, inUserLibrary: Bool = true, logChange: Bool = true) -> String {
+		let identifier = "asset-\(assets.count)"
+
+		assets[identifier] = PhotoLibraryAssetInfo(localIdentifier: identifier, mediaType: mediaType, creationDate: creationDate, modificationDate: creationDate)
+
+		if !inUserLibrary {
+			nonUserLibraryIdentifiers.insert(identifier)
+		}
+
+		if logChange {
+			changes.append(Change(inserted: [identifier]))
+		}
+
+		return identifier
+	}
+
+	func edit(_ identifier: String) {
+		assets[identifier]?.hasAdjustments = true
+		assets[identifier]?.modificationDate = Date()
+		changes.append(Change(updated: [identifier]))
+	}
+
+	func favorite(_ identifier: String) {
+		assets[identifier]?.modificationDate = Date()
+		changes.append(Change(updated: [identifier]))
+	}
+
+	func delete(_ identifier: String) {
+		assets[identifier] = nil
+		changes.append(Change(deleted: [identifier]))
+	}
+
+	func token(_ sequence: Int) -> Data {
+		return Data("\(sequence)".utf8)
+	}
+
+	var currentChangeToken: Data? {
+		return token(changes.count)
+	}
+
+	func changes(since changeToken: Data) throws -> PhotoLibraryChangeSet {
+		guard let sequence = Int(String(decoding: changeToken, as: UTF8.self)), sequence >= oldestAvailableChange, sequence <= changes.count else {
+			throw PhotoLibraryChangeTrackerError.changeTokenExpired
+		}
+
+		var changeSet = PhotoLibraryChangeSet(changeToken: token(changes.count))
+
+		for change in changes[sequence...] {
+			changeSet.insertedIdentifiers.formUnion(change.inserted)
+			changeSet.updatedIdentifiers.formUnion(change.updated)
+			changeSet.deletedIdentifiers.formUnion(change.deleted)
+		}
+
+		return changeSet
+	}
+
+	func assetInfos(for localIdentifiers: [String]) -> [PhotoLibraryAssetInfo] {
+		fetchedAssetCount += localIdentifiers.count
+		return localIdentifiers.compactMap { nonUserLibraryIdentifiers.contains($0) ? nil : assets[$0] }
+	}
+
+	func assetInfos(with mediaTypes: [PHAssetMediaType], createdAfter date: Date?) -> [PhotoLibraryAssetInfo] {
+		fullScanCount += 1
+		fetchedAssetCount += assets.count
+
+		return assets.values.filter { (asset) in
+			return mediaTypes.contains(asset.mediaType) && !nonUserLibraryIdentifiers.contains(asset.localIdentifier) && ((date == nil) || ((asset.creationDate ?? .distantPast) > date!))
+		}
+	}
+}
+
+class MockCursorStore : PhotoLibraryChangeCursorStore {
+	var cursors: [String : PhotoLibraryChangeCursor] = [:]
+
+	func changeCursor(for identifier: String) -> PhotoLibraryChangeCursor? {
+		return cursors[identifier]
+	}
+
+	func store(changeCursor: PhotoLibraryChangeCursor?, for identifier: String) {
+		cursors[identifier] = changeCursor
+	}
+}
+
+class PhotoLibraryChangeTrackerTests: XCTestCase {
+	let libraryStartDate = Date(timeIntervalSinceNow: -1_000_000)
+
+	func testInitialRunFallsBackToCreationDate() {
+		let library = MockPhotoLibrary(assetCount: 1000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+
+		let delta = tracker.delta(for: [.image], createdAfter: libraryStartDate.addingTimeInterval(899.5))
+
+		XCTAssertTrue(delta.isFullScan)
+		XCTAssertEqual(delta.assets.count, 90) // 100 assets, 10 of them videos
+		XCTAssertEqual(delta.assets.first?.localIdentifier, "asset-901")
+	}
+
+	func testDeltaContainsOnlyInsertedAndEditedAssets() {
+		let library = MockPhotoLibrary(assetCount: 1000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+		let createdAfter = libraryStartDate.addingTimeInterval(500.5)
+
+		tracker.commit(tracker.delta(for: [.image], createdAfter: Date()))
+
+		let newPhoto = library.insert(mediaType: .image, creationDate: Date())
+		let deletedPhoto = library.insert(mediaType: .image, creationDate: Date())
+		library.insert(mediaType: .video, creationDate: Date())
+		library.edit("asset-601")
+		library.favorite("asset-701")
+		library.delete(deletedPhoto)
+
+		let delta = tracker.delta(for: [.image], createdAfter: createdAfter)
+
+		XCTAssertFalse(delta.isFullScan)
+		XCTAssertEqual(delta.assets.map({ $0.localIdentifier }), ["asset-601", newPhoto])
+
+		tracker.commit(delta)
+
+		// Nothing changed since last commit
+		XCTAssertEqual(tracker.delta(for: [.image], createdAfter: createdAfter).assets.count, 0)
+	}
+
+	func testDeltaAppliesFullScanCriteria() {
+		let library = MockPhotoLibrary(assetCount: 1000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+		let createdAfter = libraryStartDate.addingTimeInterval(500.5)
+
+		tracker.commit(tracker.delta(for: [.image], createdAfter: Date()))
+
+		let newPhoto = library.insert(mediaType: .image, creationDate: Date())
+		library.insert(mediaType: .image, creationDate: libraryStartDate.addingTimeInterval(-1000)) // iCloud asset created before activation
+		library.insert(mediaType: .image, creationDate: Date(), inUserLibrary: false) // shared album asset
+		library.edit("asset-1") // edited asset created before activation
+
+		let delta = tracker.delta(for: [.image], createdAfter: createdAfter)
+
+		XCTAssertFalse(delta.isFullScan)
+		XCTAssertEqual(delta.assets.map({ $0.localIdentifier }), [newPhoto])
+
+		// A full scan with the same cut-off returns the same new assets
+		let fullScanDelta = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore()).delta(for: [.image], createdAfter: libraryStartDate.addingTimeInterval(999.5))
+
+		XCTAssertTrue(fullScanDelta.isFullScan)
+		XCTAssertEqual(fullScanDelta.assets.map({ $0.localIdentifier }), [newPhoto])
+	}
+
+	func testLateSyncedOlderAssetIsIncluded() {
+		let library = MockPhotoLibrary(assetCount: 1000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+		let activationDate = libraryStartDate.addingTimeInterval(500.5)
+
+		// First run uploads everything created after activation, up to asset-999
+		tracker.commit(tracker.delta(for: [.image], createdAfter: activationDate))
+
+		let lateSyncedPhoto = library.insert(mediaType: .image, creationDate: libraryStartDate.addingTimeInterval(700.25)) // iCloud asset older than the last uploaded one
+		library.edit("asset-901") // edit of an already uploaded asset
+
+		let delta = tracker.delta(for: [.image], createdAfter: activationDate)
+
+		XCTAssertFalse(delta.isFullScan)
+		XCTAssertEqual(delta.assets.map({ $0.localIdentifier }), [lateSyncedPhoto, "asset-901"])
+	}
+
+	func testExpiredTokenSkipsProcessedAssets() {
+		let library = MockPhotoLibrary(assetCount: 1000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+		let activationDate = libraryStartDate.addingTimeInterval(500.5)
+
+		tracker.commit(tracker.delta(for: [.image], createdAfter: activationDate))
+
+		let newPhoto = library.insert(mediaType: .image, creationDate: Date())
+		library.oldestAvailableChange = 1
+
+		// The full scan starts after the newest processed asset, not at activation
+		let delta = tracker.delta(for: [.image], createdAfter: activationDate)
+
+		XCTAssertTrue(delta.isFullScan)
+		XCTAssertEqual(delta.assets.map({ $0.localIdentifier }), [newPhoto])
+	}
+
+	func testExpiredTokenFallsBackToCreationDate() {
+		let library = MockPhotoLibrary(assetCount: 100, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+
+		tracker.commit(tracker.delta(for: [.image], createdAfter: Date()))
+
+		library.insert(mediaType: .image, creationDate: Date())
+		library.oldestAvailableChange = 1
+
+		let delta = tracker.delta(for: [.image], createdAfter: libraryStartDate.addingTimeInterval(100))
+
+		XCTAssertTrue(delta.isFullScan)
+		XCTAssertEqual(delta.assets.count, 1)
+	}
+
+	func testLargeLibraryDeltaPerformance() {
+		let library = MockPhotoLibrary(assetCount: 200_000, startDate: libraryStartDate)
+		let tracker = PhotoLibraryChangeTracker(identifier: "photos", source: library, cursorStore: MockCursorStore())
+
+		let createdAfter = libraryStartDate.addingTimeInterval(200_000)
+
+		tracker.commit(tracker.delta(for: [.image], createdAfter: createdAfter))
+
+		for _ in 0..<50 {
+			library.insert(mediaType: .image, creationDate: Date())
+		}
+
+		library.fetchedAssetCount = 0
+
+		measure {
+			XCTAssertEqual(tracker.delta(for: [.image], createdAfter: createdAfter).assets.count, 50)
+		}
+
+		// Only the changed assets were fetched - not the whole library
+		XCTAssertEqual(library.fullScanCount, 1)
+		XCTAssertLessThanOrEqual(library.fetchedAssetCount, 50 * 10)
+	}
+}
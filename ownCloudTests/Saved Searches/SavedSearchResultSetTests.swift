@@ -0,0 +1,313 @@
+//
+//  SavedSearchResultSetTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudApp
+import ownCloudAppShared
+
+class SavedSearchResultSetTests: XCTestCase {
+	let condition = OCQueryCondition.where(.mimeType, isEqualTo: "application/pdf")
+
+	func makeItem(index: Int, pdf: Bool) -> OCItem {
+		let item = OCItem()
+		item.type = .file
+		item.localID = "local-\(index)"
+		item.path = "/Documents/file-\(index)" + (pdf ? ".pdf" : ".txt")
+		item.mimeType = pdf ? "application/pdf" : "text/plain"
+		return item
+	}
+
+	func makeDatabase(count: Int) -> [OCLocalID : OCItem] {
+		var database: [OCLocalID : OCItem] = [:]
+
+		for index in 0..<count {
+			let item = makeItem(index: index, pdf: (index % 7) == 0)
+			database[item.localID!] = item
+		}
+
+		return database
+	}
+
+	func makeResultSet(from database: [OCLocalID : OCItem]) -> SavedSearchResultSet {
+		let savedSearch = OCSavedSearch(scope: .account, location: nil, name: nil, isTemplate: false, searchTerm: ":pdf", userInfo: nil)
+		let resultSet = SavedSearchResultSet(savedSearch: savedSearch, condition: condition, storageURL: nil)
+
+		resultSet.apply(changedItems: Array(database.values), removedLocalIDs: [], publish: false)
+
+		return resultSet
+	}
+
+	func fullRequery(_ database: [OCLocalID : OCItem]) -> Set<OCLocalID> {
+		return Set(database.values.filter({ condition.fulfilled(by: $0) }).compactMap({ $0.localID }))
+	}
+
+	func randomChangeSet(for database: inout [OCLocalID : OCItem], size: Int, nextIndex: inout Int) -> (changed: [OCItem], removed: [OCLocalID]) {
+		var changed: [OCItem] = []
+		var removed: [OCLocalID] = []
+		let localIDs = Array(database.keys)
+
+		for _ in 0..<size {
+			switch Int.random(in: 0..<3) {
+				case 0: // add
+					let item = makeItem(index: nextIndex, pdf: Bool.random())
+					nextIndex += 1
+					database[item.localID!] = item
+					changed.append(item)
+
+				case 1: // update (may start or stop matching)
+					if let localID = localIDs.randomElement(), database[localID] != nil {
+						let index = Int(localID.dropFirst("local-".count)) ?? 0
+						let item = makeItem(index: index, pdf: Bool.random())
+						database[localID] = item
+						changed.append(item)
+					}
+
+				default: // remove
+					if let localID = localIDs.randomElement(), database.removeValue(forKey: localID) != nil {
+						removed.append(localID)
+					}
+			}
+		}
+
+		return (changed, removed)
+	}
+
+	func testIncrementalMaintenanceMatchesFullRequery() {
+		var database = makeDatabase(count: 20000)
+		var nextIndex = database.count
+		let resultSet = makeResultSet(from: database)
+
+		XCTAssertEqual(Set(resultSet.itemsByLocalID.keys), fullRequery(database))
+
+		for _ in 0..<50 {
+			let (changed, removed) = randomChangeSet(for: &database, size: 200, nextIndex: &nextIndex)
+			resultSet.apply(changedItems: changed, removedLocalIDs: removed, publish: false)
+
+			XCTAssertEqual(Set(resultSet.itemsByLocalID.keys), fullRequery(database))
+		}
+	}
+
+	func testManagerLifecycle() {
+		let core = OCCore(bookmark: OCBookmark(for: URL(string: "https://demo.owncloud.org/")!))
+		let storageRootURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+		let manager = SavedSearchResultSetManager(core: core, storageRootURL: storageRootURL)
+		let savedSearch = OCSavedSearch(scope: .account, location: nil, name: nil, isTemplate: false, searchTerm: ":pdf", userInfo: nil)
+
+		defer {
+			try? FileManager.default.removeItem(at: storageRootURL)
+		}
+
+		// Opening starts a long-lived query, re-opening re-uses the running result set
+		guard let resultSet = manager.resultSet(for: savedSearch, condition: condition) else {
+			XCTFail("No result set")
+			return
+		}
+
+		XCTAssertTrue(resultSet.isRunning)
+		XCTAssertTrue(manager.resultSet(for: savedSearch, condition: condition) === resultSet)
+		XCTAssertEqual(manager.activeResultSetCount, 1)
+
+		resultSet.apply(changedItems: Array(makeDatabase(count: 100).values), removedLocalIDs: [], publish: false)
+		XCTAssertEqual(resultSet.itemsByLocalID.count, 15)
+
+		// Disconnecting persists and stops all result sets
+		let shutdownDone = expectation(description: "Shutdown done")
+
+		manager.shutdown(completionHandler: {
+			shutdownDone.fulfill()
+		})
+
+		wait(for: [shutdownDone], timeout: 10)
+
+		XCTAssertFalse(resultSet.isRunning)
+		XCTAssertEqual(manager.activeResultSetCount, 0)
+
+		// Only the local IDs are persisted, and only restored for the same saved search
+		let reopenedResultSet = SavedSearchResultSet(savedSearch: savedSearch, condition: condition, storageURL: resultSet.storageURL)
+		XCTAssertEqual(Set(reopenedResultSet.persistedLocalIDs() ?? []), Set(resultSet.itemsByLocalID.keys))
+
+		let editedSearch = OCSavedSearch(scope: .account, location: nil, name: nil, isTemplate: false, searchTerm: ":jpg", userInfo: nil)
+		XCTAssertNil(SavedSearchResultSet(savedSearch: editedSearch, condition: condition, storageURL: resultSet.storageURL).persistedLocalIDs())
+	}
+
+	// MARK: - Database
+	func makeDatabase(items: [OCItem]) -> OCDatabase {
+		let databaseURL = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).sqlite")
+		let database = OCDatabase(url: databaseURL)
+		let populatedExpectation = expectation(description: "Database populated")
+		let batchSize = 10000
+
+		addTeardownBlock {
+			database.close(completionHandler: { (_, _) in
+				try? FileManager.default.removeItem(at: databaseURL)
+			})
+		}
+
+		database.open(completionHandler: { (db, error) in
+			XCTAssertNil(error)
+
+			for offset in stride(from: 0, to: items.count, by: batchSize) {
+				let isLastBatch = (offset + batchSize) >= items.count
+
+				db?.addCacheItems(Array(items[offset ..< min(offset + batchSize, items.count)]), syncAnchor: NSNumber(value: 1), completionHandler: { (_, error) in
+					XCTAssertNil(error)
+
+					if isLastBatch {
+						populatedExpectation.fulfill()
+					}
+				})
+			}
+		})
+
+		wait(for: [populatedExpectation], timeout: 600)
+
+		return database
+	}
+
+	func makeDatabaseItems(count: Int) -> [OCItem] {
+		return (0..<count).map({ (index) in
+			let item = makeItem(index: index, pdf: (index % 7) == 0)
+			item.fileID = "file-\(index)"
+			return item
+		})
+	}
+
+	/// Persists a result set holding the matching items, current as of sync anchor 1
+	func persistResultSet(for items: [OCItem], storageURL: URL) {
+		let savedSearch = OCSavedSearch(scope: .account, location: nil, name: nil, isTemplate: false, searchTerm: ":pdf", userInfo: nil)
+		let resultSet = SavedSearchResultSet(savedSearch: savedSearch, condition: condition, storageURL: storageURL)
+		let persistedExpectation = expectation(description: "Persisted")
+
+		resultSet.apply(changedItems: items, removedLocalIDs: [], syncAnchor: NSNumber(value: 1), publish: false)
+
+		resultSet.persist(completionHandler: {
+			persistedExpectation.fulfill()
+		})
+
+		wait(for: [persistedExpectation], timeout: 10)
+	}
+
+	func restoreResultSet(from database: OCDatabase, storageURL: URL) -> (resultSet: SavedSearchResultSet, isCurrent: Bool) {
+		let savedSearch = OCSavedSearch(scope: .account, location: nil, name: nil, isTemplate: false, searchTerm: ":pdf", userInfo: nil)
+		let resultSet = SavedSearchResultSet(savedSearch: savedSearch, condition: condition, storageURL: storageURL)
+		let restoredExpectation = expectation(description: "Restored")
+		var isCurrent = false
+
+		resultSet.restore(from: database, completionHandler: { (restored, current) in
+			XCTAssertTrue(restored)
+			isCurrent = current
+			restoredExpectation.fulfill()
+		})
+
+		wait(for: [restoredExpectation], timeout: 60)
+
+		return (resultSet, isCurrent)
+	}
+	func testChangeSetApplicationPerformance() {
+		var database = makeDatabase(count: 100000)
+		var nextIndex = database.count
+		let resultSet = makeResultSet(from: database)
+
+		measure {
+			let (changed, removed) = randomChangeSet(for: &database, size: 100, nextIndex: &nextIndex)
+			resultSet.apply(changedItems: changed, removedLocalIDs: removed, publish: false)
+		}
+	}
+
+	func testRestoreAppliesChangesSincePersistedSyncAnchor() {
+		let items = makeDatabaseItems(count: 1000)
+		let database = makeDatabase(items: items)
+		let storageURL = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).archive")
+
+		defer {
+			try? FileManager.default.removeItem(at: storageURL)
+		}
+
+		persistResultSet(for: items, storageURL: storageURL)
+
+		// Changed after persisting: one item stops matching, one starts matching
+		let stoppedMatching = makeItem(index: 0, pdf: false)
+		let startedMatching = makeItem(index: 1, pdf: true)
+		let updatedExpectation = expectation(description: "Updated")
+
+		for (item, original) in [(stoppedMatching, items[0]), (startedMatching, items[1])] {
+			item.fileID = original.fileID
+			item.databaseID = original.databaseID
+		}
+
+		database.updateCacheItems([stoppedMatching, startedMatching], syncAnchor: NSNumber(value: 2), completionHandler: { (_, error) in
+			XCTAssertNil(error)
+			updatedExpectation.fulfill()
+		})
+
+		wait(for: [updatedExpectation], timeout: 10)
+
+		let (resultSet, isCurrent) = restoreResultSet(from: database, storageURL: storageURL)
+		var expectedLocalIDs = Set(items.filter({ condition.fulfilled(by: $0) }).compactMap({ $0.localID }))
+
+		expectedLocalIDs.remove(stoppedMatching.localID!)
+		expectedLocalIDs.insert(startedMatching.localID!)
+
+		XCTAssertTrue(isCurrent)
+		XCTAssertEqual(resultSet.syncAnchor, NSNumber(value: 2))
+		XCTAssertEqual(Set(resultSet.itemsByLocalID.keys), expectedLocalIDs)
+	}
+
+	// MARK: - Database benchmarks
+	let benchmarkItemCount = 100000
+
+	func testFullRequeryPerformance() {
+		// Previous behaviour: the full query for the condition on every open
+		let database = makeDatabase(items: makeDatabaseItems(count: benchmarkItemCount))
+		var matchCount = 0
+
+		measure {
+			let queriedExpectation = expectation(description: "Queried")
+
+			database.retrieveCacheItems(for: condition, cancelAction: nil, completionHandler: { (_, error, _, items) in
+				XCTAssertNil(error)
+				matchCount = items?.count ?? 0
+				queriedExpectation.fulfill()
+			})
+
+			wait(for: [queriedExpectation], timeout: 60)
+		}
+
+		XCTAssertEqual(matchCount, (benchmarkItemCount + 6) / 7)
+	}
+
+	func testRestorePerformance() {
+		let items = makeDatabaseItems(count: benchmarkItemCount)
+		let database = makeDatabase(items: items)
+		let storageURL = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).archive")
+
+		defer {
+			try? FileManager.default.removeItem(at: storageURL)
+		}
+
+		persistResultSet(for: items, storageURL: storageURL)
+
+		measure {
+			let (resultSet, isCurrent) = restoreResultSet(from: database, storageURL: storageURL)
+
+			XCTAssertTrue(isCurrent)
+			XCTAssertEqual(resultSet.itemsByLocalID.count, (benchmarkItemCount + 6) / 7)
+		}
+	}
+}
@@ -0,0 +1,203 @@
+//
+//  QueryResultsPagerTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudApp
+import ownCloudAppShared
+
+/// Item database evaluating page queries like the item database: only sorted by the condition's sort property, with ties in no particular order
+class MockPageQueryEndpoint : QueryResultsPagerEndpoint {
+	class Query : QueryResultsPagerQuery {
+		var condition: OCQueryCondition
+		var dataSource = OCDataSourceArray()
+		var stopped = false
+
+		init(condition: OCQueryCondition) {
+			self.condition = condition
+		}
+
+		var resultsDataSource: OCDataSource? {
+			return dataSource
+		}
+
+		func stop() {
+			stopped = true
+		}
+	}
+
+	var items: [OCItem] = []
+	var queries: [Query] = []
+
+	var runningQueries: [Query] {
+		return queries.filter { !$0.stopped }
+	}
+
+	func startPageQuery(for condition: OCQueryCondition) -> QueryResultsPagerQuery? {
+		let query = Query(condition: condition)
+
+		queries.append(query)
+
+		OnMainThread {
+			self.evaluate(query)
+		}
+
+		return query
+	}
+
+	/// Updates the results of all running queries, f.ex. after items were changed
+	func update() {
+		for query in runningQueries {
+			evaluate(query)
+		}
+	}
+
+	private func evaluate(_ query: Query) {
+		guard !query.stopped, let sortBy = query.condition.sortBy else { return }
+
+		// Ties are returned in reverse local ID order, unless sorted by local ID
+		let sortDescriptors = [
+			NSSortDescriptor(key: sortBy.rawValue, ascending: query.condition.sortAscending),
+			NSSortDescriptor(key: "localID", ascending: false)
+		]
+		let matchingItems = (items.filter({ query.condition.fulfilled(by: $0) }) as NSArray).sortedArray(using: sortDescriptors) as? [OCItem] ?? []
+		let maxResultCount = query.condition.maxResultCount?.intValue ?? matchingItems.count
+
+		query.dataSource.setVersionedItems(Array(matchingItems.prefix(maxResultCount)))
+	}
+}
+
+class QueryResultsPagerTests: XCTestCase {
+	func makeItems(names: [String]) -> [OCItem] {
+		return names.enumerated().map { (idx, name) in
+			let item = OCItem()
+			item.type = .file
+			item.name = name
+			item.path = "/" + name
+			item.localID = String(format: "id-%04d", idx)
+			return item
+		}
+	}
+
+	func makePager(for endpoint: MockPageQueryEndpoint, pageSize: Int) -> QueryResultsPager {
+		let condition = OCQueryCondition.where(.name, startsWith: "file-")
+
+		condition.sortBy = .name
+		condition.sortAscending = true
+
+		return QueryResultsPager(endpoint: endpoint, condition: condition, pageSize: pageSize)
+	}
+
+	func waitUntilLoaded(_ pager: QueryResultsPager) {
+		let timeoutDate = Date(timeIntervalSinceNow: 5)
+
+		repeat {
+			RunLoop.main.run(until: Date(timeIntervalSinceNow: 0.01))
+		} while pager.isLoading && (timeoutDate.timeIntervalSinceNow > 0)
+
+		XCTAssertFalse(pager.isLoading)
+	}
+
+	func loadAllPages(_ pager: QueryResultsPager) {
+		if pager.pageCount == 0 {
+			pager.start()
+			waitUntilLoaded(pager)
+		}
+
+		while pager.hasMoreResults {
+			pager.loadNextPage()
+			waitUntilLoaded(pager)
+		}
+	}
+
+	func resultNames(_ pager: QueryResultsPager) -> [String] {
+		return pager.resultsDataSource.items.compactMap { ($0 as? OCItem)?.name }
+	}
+
+	func testPagesSplittingTieRuns() {
+		let endpoint = MockPageQueryEndpoint()
+
+		// Short tie runs spanning page boundaries and one run longer than two pages
+		var names = (0..<12).map { "file-a\($0 / 3)" }
+		names += Array(repeating: "file-b", count: 25)
+		names += (0..<8).map { "file-c\($0)" }
+
+		endpoint.items = makeItems(names: names)
+
+		let pager = makePager(for: endpoint, pageSize: 10)
+
+		loadAllPages(pager)
+
+		XCTAssertEqual(resultNames(pager), names)
+		XCTAssertEqual(Set(pager.resultsDataSource.items.compactMap({ ($0 as? OCItem)?.localID })).count, names.count)
+	}
+
+	func testUpdatedBoundaryItem() {
+		let endpoint = MockPageQueryEndpoint()
+		let names = (0..<30).map { String(format: "file-%02d", $0) }
+
+		endpoint.items = makeItems(names: names)
+
+		let pager = makePager(for: endpoint, pageSize: 10)
+
+		pager.start()
+		waitUntilLoaded(pager)
+		pager.loadNextPage()
+		waitUntilLoaded(pager)
+
+		// Rename the last item of the first page, so it sorts after all others
+		endpoint.items[9].name = "file-99"
+		endpoint.update()
+		waitUntilLoaded(pager)
+
+		// The second page was replaced with the continuation of the updated first page
+		XCTAssertEqual(resultNames(pager), Array(names[0..<9] + names[10..<20]))
+
+		loadAllPages(pager)
+
+		XCTAssertEqual(resultNames(pager), Array(names[0..<9] + names[10..<30]) + [ "file-99" ])
+	}
+
+	func testRemovedBoundaryItem() {
+		let endpoint = MockPageQueryEndpoint()
+		let names = (0..<30).map { String(format: "file-%02d", $0) }
+
+		endpoint.items = makeItems(names: names)
+
+		let pager = makePager(for: endpoint, pageSize: 10)
+
+		pager.start()
+		waitUntilLoaded(pager)
+		pager.loadNextPage()
+		waitUntilLoaded(pager)
+
+		let runningQueryCount = endpoint.runningQueries.count
+
+		// Remove the last item of the first page
+		endpoint.items.remove(at: 9)
+		endpoint.update()
+		waitUntilLoaded(pager)
+
+		XCTAssertEqual(endpoint.runningQueries.count, runningQueryCount)
+		XCTAssertEqual(resultNames(pager), Array(names[0..<9] + names[10..<20]))
+
+		loadAllPages(pager)
+
+		XCTAssertEqual(resultNames(pager), Array(names[0..<9] + names[10..<30]))
+	}
+}
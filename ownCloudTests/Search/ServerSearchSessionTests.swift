@@ -0,0 +1,231 @@
+//
+//  ServerSearchSessionTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudAppShared
+
+/// Local search endpoint answering with synthetic results after a fixed latency
+class MockSearchEndpoint : ServerSearchEndpoint {
+	class Request : ServerSearchRequest {
+		var cancelled = false
+
+		func cancel() {
+			cancelled = true
+		}
+	}
+
+	var latency: TimeInterval
+	var totalMatches: Int
+	var answersRequests = true
+	var error: Error?
+
+	var requests: [(kqlQuery: String, limit: Int)] = []
+	var startedRequests: [Request] = []
+	var cancelledRequestCount = 0
+
+	init(latency: TimeInterval, totalMatches: Int) {
+		self.latency = latency
+		self.totalMatches = totalMatches
+	}
+
+	func startSearch(for kqlQuery: String, limit: Int, completionHandler: @escaping (OCDataSource?, Int, Error?) -> Void) -> ServerSearchRequest? {
+		let request = Request()
+
+		requests.append((kqlQuery: kqlQuery, limit: limit))
+		startedRequests.append(request)
+
+		guard answersRequests else { return request }
+
+		DispatchQueue.main.asyncAfter(deadline: .now() + latency) {
+			if request.cancelled {
+				self.cancelledRequestCount += 1
+				return
+			}
+
+			if let error = self.error {
+				completionHandler(nil, 0, error)
+				return
+			}
+
+			let resultCount = min(limit, self.totalMatches)
+			let items = (0..<resultCount).map { idx in
+				let item = OCItem()
+				item.path = "/\(kqlQuery)-\(idx).txt"
+				item.localID = "\(kqlQuery)-\(idx)"
+				return item
+			}
+
+			completionHandler(OCDataSourceArray(items: items), resultCount, nil)
+		}
+
+		return request
+	}
+}
+
+class ServerSearchSessionTests: XCTestCase {
+	func type(_ text: String, into session: ServerSearchSession, keystrokeInterval: TimeInterval) {
+		for length in 1...text.count {
+			session.kqlQuery = String(text.prefix(length))
+			RunLoop.main.run(until: Date(timeIntervalSinceNow: keystrokeInterval))
+		}
+	}
+
+	func waitForResults(of session: ServerSearchSession, timeout: TimeInterval = 5) -> ServerSearchSession.Results? {
+		let resultsReceived = expectation(description: "Results received")
+		var receivedResults: ServerSearchSession.Results?
+
+		session.resultsHandler = { (results) in
+			if receivedResults == nil {
+				receivedResults = results
+				resultsReceived.fulfill()
+			}
+		}
+
+		wait(for: [resultsReceived], timeout: timeout)
+
+		session.resultsHandler = nil
+
+		return receivedResults
+	}
+
+	func testKeystrokesAreCoalesced() {
+		let endpoint = MockSearchEndpoint(latency: 0.05, totalMatches: 20)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.2
+
+		type("quarterly report", into: session, keystrokeInterval: 0.05)
+
+		let results = waitForResults(of: session)
+
+		XCTAssertEqual(results?.kqlQuery, "quarterly report")
+		XCTAssertEqual(endpoint.requests.count, 1) // without session: 16 requests
+		XCTAssertEqual(session.coalescedQueryCount, 15)
+		XCTAssertFalse(results?.hasMoreResults ?? true)
+	}
+
+	func testCachedResultsAreReturnedWithoutRequest() {
+		let endpoint = MockSearchEndpoint(latency: 0.05, totalMatches: 20)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.01
+
+		session.kqlQuery = "invoice"
+		_ = waitForResults(of: session)
+
+		session.kqlQuery = "invoices"
+		_ = waitForResults(of: session)
+
+		// Going back (f.ex. deleting a character) is served from the cache, without waiting for the debounce interval
+		var cachedResults: ServerSearchSession.Results?
+		session.resultsHandler = { cachedResults = $0 }
+		session.kqlQuery = "invoice"
+
+		XCTAssertNotNil(cachedResults) // delivered synchronously
+		XCTAssertEqual(endpoint.requests.count, 2)
+		XCTAssertEqual(session.cacheHitCount, 1)
+
+		// Expired entries are fetched again
+		session.cacheTimeToLive = 0
+		session.kqlQuery = "invoices"
+		_ = waitForResults(of: session)
+
+		XCTAssertEqual(endpoint.requests.count, 3)
+	}
+
+	func testPagination() {
+		let endpoint = MockSearchEndpoint(latency: 0.01, totalMatches: 250)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.01
+		session.pageSize = 100
+
+		session.kqlQuery = "photo"
+		XCTAssertEqual(waitForResults(of: session)?.hasMoreResults, true)
+
+		session.loadNextPage()
+		XCTAssertEqual(waitForResults(of: session)?.hasMoreResults, true)
+
+		session.loadNextPage()
+		XCTAssertEqual(waitForResults(of: session)?.hasMoreResults, false)
+
+		// No further pages
+		session.loadNextPage()
+
+		XCTAssertEqual(endpoint.requests.map({ $0.limit }), [100, 200, 300])
+	}
+
+	func testQueryChangeCancelsRunningRequest() {
+		let endpoint = MockSearchEndpoint(latency: 0.2, totalMatches: 10)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.01
+
+		session.kqlQuery = "draft"
+		RunLoop.main.run(until: Date(timeIntervalSinceNow: 0.05))
+
+		session.kqlQuery = "drafts"
+
+		let results = waitForResults(of: session)
+
+		XCTAssertEqual(results?.kqlQuery, "drafts")
+		XCTAssertEqual(endpoint.requests.count, 2)
+		XCTAssertEqual(endpoint.cancelledRequestCount, 1)
+	}
+
+	func testUnansweredRequestTimesOut() {
+		let endpoint = MockSearchEndpoint(latency: 0.01, totalMatches: 10)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.01
+		session.requestTimeout = 0.2
+
+		endpoint.answersRequests = false
+		session.kqlQuery = "budget"
+
+		let results = waitForResults(of: session)
+
+		XCTAssertEqual(results?.error as? ServerSearchSessionError, .timeout)
+		XCTAssertFalse(session.isSearching)
+		XCTAssertEqual(endpoint.startedRequests.first?.cancelled, true)
+
+		// The session accepts new requests after the timeout
+		endpoint.answersRequests = true
+		session.reload()
+
+		XCTAssertNil(waitForResults(of: session)?.error)
+		XCTAssertEqual(endpoint.requests.count, 2)
+	}
+
+	func testLateFailureIsDelivered() {
+		let endpoint = MockSearchEndpoint(latency: 0.3, totalMatches: 10)
+		let session = ServerSearchSession(endpoint: endpoint)
+
+		session.debounceInterval = 0.01
+		session.requestTimeout = 5
+
+		endpoint.error = NSError(domain: NSURLErrorDomain, code: NSURLErrorNetworkConnectionLost)
+		session.kqlQuery = "budget"
+
+		let results = waitForResults(of: session)
+
+		XCTAssertNotNil(results?.error)
+		XCTAssertFalse(session.isSearching)
+	}
+}
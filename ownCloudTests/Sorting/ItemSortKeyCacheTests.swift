@@ -0,0 +1,152 @@
+//
+//  ItemSortKeyCacheTests.swift
+//  ownCloudTests
+//
+//  Created by Felix Schwarz on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+import XCTest
+import ownCloudSDK
+import ownCloudApp
+import ownCloudAppShared
+
+class ItemSortKeyCacheTests: XCTestCase {
+	let names = [ "Report", "report draft", "Äpfel", "apple", "Photo", "photo album", "Zebra", "notes" ]
+	let extensions = [ "pdf", "jpg", "txt", "docx" ]
+
+	func makeItems(count: Int) -> [OCItem] {
+		var items: [OCItem] = []
+
+		for idx in 0 ..< count {
+			let item = OCItem()
+			let isFolder = (idx % 9) == 0
+
+			item.type = isFolder ? .collection : .file
+			item.name = "\(names[idx % names.count]) \(idx)" + (isFolder ? "" : ".\(extensions[idx % extensions.count])")
+			item.path = "/" + item.name! + (isFolder ? "/" : "")
+			item.localID = "local-\(idx)"
+			item.size = (idx * 7919) % 100_000
+			item.lastModified = Date(timeIntervalSinceReferenceDate: TimeInterval((idx * 104729) % 1_000_000))
+			item.mimeType = isFolder ? nil : "application/\(extensions[idx % extensions.count])"
+
+			items.append(item)
+		}
+
+		return items
+	}
+
+	/// Previous behaviour: look up both records for every comparison and compare the items
+	func recordComparator(for sortDescriptor: SortDescriptor) -> (OCDataSource, OCDataItemReference, OCDataSource, OCDataItemReference) -> ComparisonResult {
+		let comparator = sortDescriptor.comparator
+
+		return { (source1, ref1, source2, ref2) in
+			if let record1 = try? source1.record(forItemRef: ref1),
+			   let record2 = try? source2.record(forItemRef: ref2),
+			   let item1 = record1.item as? OCItem,
+			   let item2 = record2.item as? OCItem {
+				return comparator(item1, item2)
+			}
+
+			return .orderedDescending
+		}
+	}
+
+	func sort(_ itemRefs: [OCDataItemReference], in source: OCDataSource, with comparator: (OCDataSource, OCDataItemReference, OCDataSource, OCDataItemReference) -> ComparisonResult) -> [OCDataItemReference] {
+		return itemRefs.sorted(by: { comparator(source, $0, source, $1) == .orderedAscending })
+	}
+
+	// MARK: - Tests
+	func testOrderMatchesItemComparator() {
+		let items = makeItems(count: 500)
+		let source = OCDataSourceArray(items: items)
+		let itemRefs = items.map { $0.dataItemReference }
+
+		for foldersFirst in [ true, false ] {
+			let previousFoldersFirst = DisplaySettings.shared.sortFoldersFirst
+			DisplaySettings.shared.sortFoldersFirst = foldersFirst
+
+			for method in SortMethod.all {
+				for direction in [ SortDirection.ascending, .descending ] {
+					let sortDescriptor = SortDescriptor(method: method, direction: direction)
+					let keyCache = ItemSortKeyCache(sortDescriptor: sortDescriptor, foldersFirst: foldersFirst)
+
+					XCTAssertEqual(sort(itemRefs, in: source, with: keyCache.comparator), sort(itemRefs, in: source, with: recordComparator(for: sortDescriptor)), "Order differs for \(method) \(direction) foldersFirst=\(foldersFirst)")
+				}
+			}
+
+			DisplaySettings.shared.sortFoldersFirst = previousFoldersFirst
+		}
+	}
+
+	func testKeysAreOnlyRebuiltForChangedItems() {
+		var items = makeItems(count: 1000)
+		let source = OCDataSourceArray(items: items)
+		let itemRefs = items.map { $0.dataItemReference }
+		let keyCache = ItemSortKeyCache(sortDescriptor: SortDescriptor(method: .size, direction: .descending), foldersFirst: false)
+
+		_ = sort(itemRefs, in: source, with: keyCache.comparator)
+		XCTAssertEqual(keyCache.keyBuildCount, 1000)
+
+		// Re-sort without changes
+		_ = sort(itemRefs, in: source, with: keyCache.comparator)
+		XCTAssertEqual(keyCache.keyBuildCount, 1000)
+
+		// Change the size of one item
+		let changedItem = OCItem()
+		changedItem.type = .file
+		changedItem.name = items[500].name
+		changedItem.path = items[500].path
+		changedItem.localID = items[500].localID
+		changedItem.size = 1_000_000_000
+		items[500] = changedItem
+
+		source.setItems(items, updated: [ changedItem ])
+		keyCache.invalidateKeys(for: Set([ changedItem.dataItemReference ]))
+
+		let sortedRefs = sort(itemRefs, in: source, with: keyCache.comparator)
+
+		XCTAssertEqual(keyCache.keyBuildCount, 1001)
+		XCTAssertEqual(sortedRefs.last, changedItem.dataItemReference)
+	}
+
+	// MARK: - Benchmark
+	let benchmarkItemCount = 50_000
+
+	func testResortPerformanceWithRecordLookups() {
+		let items = makeItems(count: benchmarkItemCount)
+		let source = OCDataSourceArray(items: items)
+		let itemRefs = items.map { $0.dataItemReference }
+		let comparator = recordComparator(for: SortDescriptor(method: .alphabetically, direction: .ascending))
+
+		measure {
+			_ = sort(itemRefs, in: source, with: comparator)
+		}
+	}
+
+	func testResortPerformanceWithSortKeys() {
+		let items = makeItems(count: benchmarkItemCount)
+		let source = OCDataSourceArray(items: items)
+		let itemRefs = items.map { $0.dataItemReference }
+		let keyCache = ItemSortKeyCache(sortDescriptor: SortDescriptor(method: .alphabetically, direction: .ascending))
+
+		// Initial sort builds the keys
+		_ = sort(itemRefs, in: source, with: keyCache.comparator)
+
+		measure {
+			_ = sort(itemRefs, in: source, with: keyCache.comparator)
+		}
+
+		XCTAssertEqual(keyCache.keyBuildCount, benchmarkItemCount)
+	}
+}